@@ -40,6 +40,20 @@ typedef struct fb_path_eval_s
 	gedict_t *player;
 } fb_path_eval_t;
 
+// A single route lookup, independent of the path-finding globals below
+typedef struct fb_route_query_s
+{
+	gedict_t *from_marker;
+	gedict_t *to_marker;
+	qbool path_normal;
+	qbool rj_routes;
+
+	// results
+	gedict_t *middle_marker;	// marker where the route enters to_marker's zone
+	float zone_time;			// time to reach middle_marker
+	float traveltime;			// time to reach to_marker
+} fb_route_query_t;
+
 // Globals used for general path-finding
 extern qbool path_normal;
 extern gedict_t *look_marker;
@@ -231,6 +245,10 @@ void AvoidHazards(gedict_t *self);
 void NewVelocityForArrow(gedict_t *self, vec3_t dir_move, const char *explanation);
 
 // route_lookup.qc
+float RouteQuery(fb_route_query_t *query);
+float RouteTravelTime(gedict_t *from_marker, gedict_t *to_marker, qbool path_normal,
+						qbool rj_routes);
+gedict_t* SightMarkerQuery(fb_route_query_t *query, float max_distance, float min_height_diff);
 gedict_t* SightMarker(gedict_t *from_marker, gedict_t *to_marker, float max_distance,
 						float min_height_diff);
 gedict_t* HigherSightFromFunction(gedict_t *from_marker, gedict_t *to_marker);
@@ -274,6 +292,10 @@ void UpdateGoal(gedict_t *self);
 // botpath.qc
 void ProcessNewLinkedMarker(gedict_t *self);
 
+// marker_pvs.c
+void MarkerPVSReset(void);
+qbool MarkersMaySee(gedict_t *from, gedict_t *to);
+
 // marker_load.qc
 gedict_t* CreateMarker(float x, float y, float z);
 void AllMarkersLoaded(void);
@@ -327,7 +349,29 @@ int NumberOfClients(void);
 qbool TimeTrigger(float *next_time, float time_increment);
 
 qbool IsMarkerFrame(void);
-qbool IsHazardFrame(void);
+
+// think scheduler tasks, granted per bot each frame
+#define BOT_TASK_HAZARD 1
+#define BOT_TASK_GOAL   2
+#define BOT_TASK_ENEMY  4
+
+qbool BotThinkTaskGranted(gedict_t *self, int task);
+qbool BotSearchesEnemy(gedict_t *self);
+
+// bot_roster.c
+typedef struct fb_roster_s
+{
+	int count;
+	gedict_t *ent[MAX_CLIENTS];
+	float x[MAX_CLIENTS];
+	float y[MAX_CLIENTS];
+	float z[MAX_CLIENTS];
+} fb_roster_t;
+
+fb_roster_t* RosterSnapshot(void);
+void RosterDistances(fb_roster_t *r, vec3_t org, float *out);
+void RosterViewCone(fb_roster_t *r, vec3_t org, vec3_t dir, float *out);
+void RosterYawDeltas(fb_roster_t *r, vec3_t org, float yaw, float *out);
 
 // fb_globals.c
 gedict_t* FirstZoneMarker(int zone);
@@ -406,6 +450,7 @@ qbool HasSavedMarker(void);
 #define FB_CVAR_WEAPON          "k_fb_weapon"
 #define FB_CVAR_BREAK_ON_DEATH  "k_fb_break_on_death"
 #define FB_CVAR_QUAD_MULTIPLIER "k_fb_quad_multiplier"
+#define FB_CVAR_THINK_BUDGET    "k_fb_think_budget"
 
 void BotsFireLogic(void);
 
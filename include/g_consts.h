@@ -278,6 +278,12 @@
 #define FLAG_DROPPED					2
 #define FLAG_RETURNED					3			// here only 200ms before going back to FLAG_AT_BASE
 
+// k_ctf_hookstyle
+#define HOOK_STYLE_SMOOTH				1
+#define HOOK_STYLE_FAST					2
+#define HOOK_STYLE_CLASSIC				3
+#define HOOK_STYLE_CR					4
+
 // spec moreinfo
 #define MI_ON							(   1<<0)	// on/off
 #define MI_ADM_ONLY						(   1<<1)	// send info to admined specs only or to normal specs too
@@ -250,6 +250,7 @@ int i_rnd(int from, int to);
 float dist_random(float minValue, float maxValue, float spreadFactor);
 float next_frame(void);
 gedict_t* spawn(void);
+void initialise_spawned_ent(gedict_t *ent);
 void ent_remove(gedict_t *t);
 void soft_ent_remove(gedict_t *ent);
 
@@ -259,7 +260,6 @@ gedict_t* ez_find(gedict_t *start, char *str);
 int find_cnt(int fieldoff, char *str);
 gedict_t* find_idx(int idx, int fieldoff, char *str);
 //gedict_t       *findradius( gedict_t * start, vec3_t org, float rad );
-gedict_t* findradius_ignore_solid(gedict_t *start, vec3_t org, float rad);
 void normalize(vec3_t value, vec3_t newvalue);
 float vlen(vec3_t value1);
 float vectoyaw(vec3_t value1);
@@ -404,6 +404,7 @@ gedict_t* get_ed_scores2(void);
 gedict_t* get_ed_best1(void);
 gedict_t* get_ed_best2(void);
 gedict_t* get_ed_bestPow(void);
+void InvalidateBestPlayers(void);
 
 char* str_noweapon(int k_disallow_weapons);
 
@@ -477,8 +478,43 @@ extern gedict_t *activator;
 void* G_Alloc(int size);
 void G_InitMemory(void);
 
+//
+// g_fxpool.c
+void FxReset(void);
+gedict_t* FxSpawn(void);
+qbool FxRelease(gedict_t *e);
+void FxStats(void);
+
+//
+// g_spatial.c
+#define SPATIAL_NONSOLID	1	// SOLID_NOT entities too
+#define SPATIAL_TAKEDAMAGE	2	// only entities which take damage
+#define SPATIAL_PLAYERS		4	// only players
+
+void G_SpatialReset(void);
+void G_SpatialSpawn(gedict_t *e);
+void G_SpatialRemove(gedict_t *e);
+void G_SpatialLink(gedict_t *e);
+void G_SpatialSweep(void);
+float G_SpatialExtent(void);
+int G_FindRadius(vec3_t org, float rad, int flags, char *classname, gedict_t ***list);
+int G_FindBox(vec3_t mins, vec3_t maxs, int flags, char *classname, gedict_t ***list);
+void G_SpatialRelease(int count);
+
+//
+// g_timers.c
+typedef void (*timer_func_t)(void);
+
+void G_TimersReset(void);
+int G_TimerAdd(float time, timer_func_t func, gedict_t *ent);
+qbool G_TimerPending(int handle);
+void G_TimerCancel(int handle);
+void G_TimersRemoveEntity(gedict_t *e);
+void G_TimersRun(void);
+
 //
 // g_spawn.c
+void G_InitSpawnRegistry(void);
 void G_SpawnEntitiesFromString(void);
 qbool G_SpawnString(const char *key, const char *defaultString, char **out);
 qbool G_SpawnFloat(const char *key, const char *defaultString, float *out);
@@ -525,6 +561,9 @@ void SuperDamageSound(void);
 
 char *Spawn_GetModel(void);
 gedict_t* SelectSpawnPoint(char *spawnname);
+void SpawnIndexInvalidate(void);
+void SpawnIndexChanged(gedict_t *e);
+int SpawnIndexCount(char *spawnname);
 
 #define         WP_STATS_UPDATE (0.3f)
 void Print_Wp_Stats(void);
@@ -631,6 +670,32 @@ void log_open(const char *fmt, ...) PRINTF_FUNC(1);
 void log_printf(const char *fmt, ...) PRINTF_FUNC(1);
 void log_close(void);
 
+typedef enum
+{
+	leDamage,
+	leDeath,
+	lePickMapItem,
+	lePickPowerup,
+	leDropPowerup,
+	lePickBackpack,
+	leDropBackpack,
+	leSpawn,
+	leRoundEnd
+} logEventType_t;
+
+const char* LogEventName(logEventType_t type);
+void LogEventDamage(gedict_t *attacker, const char *attackername, const char *targetname,
+					int deathtype, int splash, int value, qbool armor);
+void LogEventDeath(gedict_t *attacker, const char *attackername, gedict_t *targ,
+					const char *targetname, int killheight);
+void LogEventItem(logEventType_t type, const char *playername, const char *item, int value,
+					float timeleft);
+void LogEventBackpack(logEventType_t type, const char *playername, const char *weapon,
+						gedict_t *backpack);
+void LogEventSpawn(gedict_t *p);
+void LogEventRoundEnd(int round, const char *winner);
+void LogsFrame(void);
+
 extern fileHandle_t log_handle;
 
 // commands.c
@@ -878,6 +943,7 @@ qbool isCA(void);
 qbool CA_CheckAlive(gedict_t *p);
 int CA_wins_required(void);
 int CA_count_ready_players(void);
+void CA_TeamsChanged(void);
 int CA_get_score_1(void);
 int CA_get_score_2(void);
 void SM_PrepareCA(void);
@@ -906,6 +972,8 @@ void ExitCoach(void);
 void StuffMaps(gedict_t *p);
 
 void GetMapList(void);
+void MapPoolReset(void);
+void MapPoolReload(void);
 
 char* GetMapName(int imp);
 int GetMapNum(char *mapname);
@@ -919,6 +987,28 @@ qbool VoteMapSpecific(char *map);
 void EndMatch(float skip_log);
 void StatsToFile(void);
 
+// stats_timeline.c
+#define TIMELINE_BUCKET_TIME	10			// seconds
+#define TIMELINE_BUCKETS		128
+
+typedef struct timeline_bucket_s
+{
+	int bucket;						// number of the bucket since match start
+	int dmg_g;						// damage given
+	int dmg_t;						// damage taken
+	unsigned short hits[wpMAX];
+	unsigned short wtooks[wpMAX];	// weapons taken which the player did not have
+	unsigned short tooks[itMAX];
+} timeline_bucket_t;
+
+void TimelineReset(void);
+void TimelineDamage(gedict_t *attacker, gedict_t *targ, float damage);
+void TimelineHit(gedict_t *p, weaponName_t wp);
+void TimelineItem(gedict_t *p, itemName_t it);
+void TimelineWeapon(gedict_t *p, weaponName_t wp);
+qbool TimelineRange(gedict_t *p, int *first, int *last);
+timeline_bucket_t* TimelineBucket(gedict_t *p, int bucket);
+
 // grapple.c
 void GrappleThrow(void);
 void GrappleService(void);
@@ -1012,6 +1102,30 @@ char* race_scoring_system_name(void);
 void race_match_stats(void);
 race_stats_score_t* race_get_player_stats(int *players);
 
+// map_bundle.c
+typedef enum
+{
+	mbsBotRoutes = 1,
+	mbsLocations
+} mapBundleSection_t;
+
+char* MapBundleOpenSource(const char *fmt, ...) PRINTF_FUNC(1);
+char* MapBundleNextLine(char **cursor, char *line, int size);
+void* MapBundleSection(mapBundleSection_t id, int *size);
+void MapBundleBegin(mapBundleSection_t id);
+void MapBundleAppend(const void *data, int size);
+void MapBundleCommit(void);
+
+// race_records.c
+void race_records_reset(void);
+void race_records_open(const char *filename);
+int race_records_add(int route, int weapon, int falsestart, raceRecord_t *record);
+int race_records_ranked(int route, int weapon, int falsestart);
+qbool race_records_get(int route, int weapon, int falsestart, int rank, raceRecord_t *record);
+int race_records_rank(int route, int weapon, int falsestart, const char *name,
+						raceRecord_t *record);
+int race_records_runs(int route, int weapon, int falsestart, const char *name);
+
 // globals.c
 
 extern int k_bloodfest;      // blood fest mode
@@ -1058,6 +1172,7 @@ extern gameType_t k_mode;   // game type: DUEL, TP, FFA
 extern int k_lastvotedmap;	// last voted map, used for agree command?
 // { CTF
 extern int k_ctf_custom_models;	// use or not custom models
+extern int k_ctf_hookstyle;		// HOOK_STYLE_*
 extern int k_allowed_free_modes; // reflect appropriate cvar - but changed only at map load
 #ifdef CTF_RELOADMAP
 extern qbool k_ctf;			// is ctf was active at map load
@@ -1142,6 +1257,7 @@ extern float enemy_vis, enemy_infront, enemy_range;
 extern float enemy_yaw;
 
 void FoundTarget(void);
+void MonsterLodWake(gedict_t *m);
 
 void GetMadAtAttacker(gedict_t *attacker);
 
@@ -1178,11 +1294,28 @@ void bloodfest_reset(void);
 void monster_death_use(void);
 
 void check_monsters_respawn(void);
+void monster_schedule_respawn(gedict_t *e);
 
 void walkmonster_start(char *model);
 void flymonster_start(char *model);
 void swimmonster_start(char *model);
 
+// sp_spawnslots.c
+typedef struct spawn_slot_s
+{
+	vec3_t origin;
+	vec3_t angles;
+	qbool water;					// only fish go here
+	qbool clear;					// checked against the world when built, no trace needed
+	int occupant;					// edict number of the monster spawned here last
+	float occupant_time;			// its spawn_time, in case the edict got reused
+} spawn_slot_t;
+
+void SpawnSlotsReset(void);
+void SpawnSlotsBuild(void);
+spawn_slot_t* SpawnSlotPick(qbool allow_water);
+void SpawnSlotTake(spawn_slot_t *s, gedict_t *monster);
+
 // }
 
 // misc.c
@@ -211,6 +211,8 @@ typedef struct player_stats_s
 	int lgc_undershaft;		// cells fired before hitting target
 	int lgc_overshaft;		// cells fired after killing target
 
+	int timeline;			// stats_timeline.c ring + 1, 0 = none yet
+
 } player_stats_t;
 
 typedef enum
@@ -278,20 +280,42 @@ typedef struct wreg_s
 
 // {
 
-#define MAX_PLRFRMS (77*15) /* 77 frames for each of 15 seconds */
+#define MV_DATA_SIZE		(16 * 1024)	/* delta encoded frames, usually 5-10 bytes each */
+#define MV_FRAME_MAX_SIZE	(28)		/* frame with every field stored in full */
+#define MV_KEYFRAME_EVERY	(64)		/* every Nth frame is stored in full, for seeking */
+#define MV_MAX_KEYFRAMES	(MV_DATA_SIZE / (3 * MV_KEYFRAME_EVERY) + 1)
 
+// frame quantised for storage: time in ms, origin in 1/8 units, angles in 1/65536 of a turn
 typedef struct
 {
-	float time;
-//	float	modelindex;
-	vec3_t origin;
-	vec3_t angles;
-	float frame;
-	float effects;
-//	vec3_t	v_angle;
-	float colormap;
+	int time;
+	int origin[3];
+	int angles[3];
+	int frame;
+	int effects;
+	int colormap;
 } plrfrm_t;
 
+typedef struct
+{
+	int frame;
+	int time;
+	int offset;
+} mv_keyframe_t;
+
+typedef struct mv_movie_s
+{
+	int frames;
+	int size;								// bytes of data used
+	int keyframes_cnt;
+	mv_keyframe_t keyframes[MV_MAX_KEYFRAMES];
+	byte data[MV_DATA_SIZE];
+
+	plrfrm_t last;							// last recorded frame, base for deltas
+	plrfrm_t pb;							// last decoded frame
+	int pb_offset;							// data offset of the frame after pb
+} mv_movie_t;
+
 // }
 
 // player position
@@ -571,6 +595,9 @@ typedef struct fb_entvars_s {
 	float enemy_dist;							// Distance to primary enemy
 
 	int oldsolid;								// need to keep track of this for hazard calculations
+	float next_hazard_time;						// when this bot next runs hazard avoidance (staggered per bot)
+	int think_tasks;							// BOT_TASK_* flags granted by the think scheduler this frame
+	int think_deferred;							// frames this bot has had due tasks deferred by the scheduler
 
 	// these determine the desire for items for each player 
 	//   (not just for bots ... bot's desire can take enemy's desire into consideration)
@@ -884,7 +911,14 @@ typedef struct gedict_s
 	float search_time;
 	float attack_state;
 
+	int lod_tier;							// AI level of detail, see MonsterLodThink()
+	int lod_thinks;
+	float lod_time;							// when the tier is chosen again
+	float lod_seen_time;					// last time the enemy was visible
+	float lod_enemy_vis;					// enemy_vis of the last full think
+
 	float monster_desired_spawn_time;		// in nightmare mode monster desire respawn at this time after last death
+	int monster_respawn_timer;				// timer handle of the pending nightmare respawn
 	vec3_t oldangles;						// for nightmare skill, need remember monster angles before respawn again
 
 // }
@@ -1014,11 +1048,13 @@ typedef struct gedict_s
 	float rune_notify_time;					// already have a rune spam prevention
 	float carrier_hurt_time;				// time we last hurt enemy carrier
 	float rune_pickup_time;					// time we picked up current rune
+	int regen_rot_timer;					// timer handle, health rots down after losing regen rune
 	float hook_damage_time;					// manage dps dealt to hooked enemies
 	float hook_cancel_time;					// delay cancel on throw with smooth hook
 	float hook_reset_time;					// marker for grapple reset (decoupled from `attack_finished`)
 	float hook_pullspeed;					// accelerate grapple velocity
 	float hook_pullspeed_accel;				// number by which to increment velocity
+	qbool hook_chain;						// set on the hook while its chain is drawn
 	char *last_rune;					// name of last rune we send to client
 	float items2;						// using  ZQ_ITEMS2 extension in mvdsv we can use per client sigils for runes
 
@@ -1094,12 +1130,11 @@ typedef struct gedict_s
 	qbool is_playback;
 
 	float rec_start_time;					// time when record starts
-	int rec_count;							// count of recorded frames
 	qbool is_recording;
 
 	struct gedict_s *pb_ent;				// enitity which used to show our model during playback
 
-	plrfrm_t *plrfrms;						// [MAX_PLRFRMS] for record trix
+	mv_movie_t *movie;						// for record trix
 // }
 
 // { for /cmd callalias <alias time>
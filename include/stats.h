@@ -77,6 +77,7 @@ void x##_race_detail(fileHandle_t handle);
 const char* GetMode(void);
 char* ItName(itemName_t it);
 void S2di(fileHandle_t file_handle, const char *fmt, ...) PRINTF_FUNC(2);
+char* json_string(const char *input);
 void MatchEndStatsTables(void);
 
 
@@ -407,36 +407,40 @@ static void BotsAimAtFloor(gedict_t *self, vec3_t rel_pos, float rel_dist)
 static void FireAtSpawnPoint(gedict_t *self)
 {
 	gedict_t *resp;
-	for (resp = world; (resp = trap_findradius(resp, self->s.v.origin, 1000));)
+	gedict_t **list;
+	int i, count;
+
+	count = G_FindRadius(self->s.v.origin, 1000, 0, "info_player_deathmatch", &list);
+	for (i = 0; i < count; i++)
 	{
-		if (streq(resp->classname, "info_player_deathmatch"))
+		vec3_t test;
+
+		resp = list[i];
+		VectorCopy(self->s.v.origin, test);
+		test[2] += 16;
+		if (VectorDistance(resp->s.v.origin, test) > 160)
 		{
-			vec3_t test;
-			VectorCopy(self->s.v.origin, test);
-			test[2] += 16;
-			if (VectorDistance(resp->s.v.origin, test) > 160)
+			if (VisibleEntity(resp))
 			{
-				if (VisibleEntity(resp))
-				{
-					float ang1, ang2;
-					vec3_t diff;
-
-					self->fb.desired_weapon_impulse = 7;
-					self->fb.look_object = resp;
-					VectorCopy(resp->s.v.origin, self->fb.predict_origin);
-					self->fb.predict_origin[2] += 16;
-					self->fb.old_linked_marker = NULL;
-
-					VectorSubtract(resp->s.v.origin, self->s.v.origin, diff);
-					ang2 = vectoyaw(diff);
-					ang1 = anglemod(self->s.v.angles[1] - ang2);
-					self->fb.firing |= (ang1 < 20 || ang1 > 340);
-
-					return;
-				}
+				float ang1, ang2;
+				vec3_t diff;
+
+				self->fb.desired_weapon_impulse = 7;
+				self->fb.look_object = resp;
+				VectorCopy(resp->s.v.origin, self->fb.predict_origin);
+				self->fb.predict_origin[2] += 16;
+				self->fb.old_linked_marker = NULL;
+
+				VectorSubtract(resp->s.v.origin, self->s.v.origin, diff);
+				ang2 = vectoyaw(diff);
+				ang1 = anglemod(self->s.v.angles[1] - ang2);
+				self->fb.firing |= (ang1 < 20 || ang1 > 340);
+				break;
 			}
 		}
 	}
+
+	G_SpatialRelease(count);
 }
 
 // When duelling, try and spawn frag.
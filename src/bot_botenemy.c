@@ -71,19 +71,23 @@ void BotsSoundMadeEvent(gedict_t *entity)
 	if (entity && entity->ct == ctPlayer)
 	{
 		gedict_t *plr;
+		fb_roster_t *roster = RosterSnapshot();
+		float dist[MAX_CLIENTS];
+		int i;
+
+		RosterDistances(roster, entity->s.v.origin, dist);
 
 		// Find all bots which has this entity as enemy
-		for (plr = world; (plr = find_plr(plr));)
+		for (i = 0; i < roster->count; i++)
 		{
+			plr = roster->ent[i];
+
 			if (plr->isBot && !(plr->fb.state & NOTARGET_ENEMY))
 			{
 				if ((NUM_FOR_EDICT(entity) == plr->s.v.enemy) && (entity != plr->fb.look_object))
 				{
-					vec3_t temp;
-					VectorSubtract(entity->s.v.origin, plr->s.v.origin, temp);
-
 					// Did the bot hear it?
-					if (VectorLength(temp) < 1000)
+					if (dist[i] < 1000)
 					{
 						if (Visible_360(plr, entity))
 						{
@@ -123,15 +127,17 @@ static void BestEnemy_apply(gedict_t *test_enemy, float *best_score, gedict_t **
 	look_marker = SightFromMarkerFunction(from_marker, to_marker);
 	if (look_marker != NULL)
 	{
-		ZoneMarker(from_marker, look_marker, path_normal, test_enemy->fb.canRocketJump);
-		traveltime = SubZoneArrivalTime(zone_time, middle_marker, look_marker,
-										test_enemy->fb.canRocketJump);
-		enemy_score = traveltime + g_random();
+		enemy_score = RouteTravelTime(from_marker, look_marker, path_normal,
+										test_enemy->fb.canRocketJump) + g_random();
 	}
 	else
 	{
-		look_marker = SightMarker(from_marker, to_marker, 0, 0);
-		enemy_score = look_traveltime + g_random();
+		fb_route_query_t query;
+
+		query.from_marker = from_marker;
+		query.to_marker = to_marker;
+		look_marker = SightMarkerQuery(&query, 0, 0);
+		enemy_score = query.traveltime + g_random();
 	}
 
 	if (enemy_score < *best_score)
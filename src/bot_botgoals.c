@@ -37,13 +37,23 @@ void UpdateGoalEntity(gedict_t *item, gedict_t *taker)
 {
 	gedict_t *plr;
 	int item_entity = NUM_FOR_EDICT(item);
+	fb_roster_t *roster = RosterSnapshot();
+	float dist[MAX_CLIENTS];
+	int i;
 
-	for (plr = world; (plr = find_plr(plr));)
+	RosterDistances(roster, item->s.v.origin, dist);
+
+	for (i = 0; i < roster->count; i++)
 	{
 		// if the same team, pretend bot read a 'took' notification
-		qbool same_team = SameTeam(plr, taker);
-		qbool heard_it = VectorDistance(plr->s.v.origin, item->s.v.origin) < 1000;
-		float delay = (same_team || heard_it ? 0 : g_random());
+		qbool same_team;
+		qbool heard_it;
+		float delay;
+
+		plr = roster->ent[i];
+		same_team = SameTeam(plr, taker);
+		heard_it = dist[i] < 1000;
+		delay = (same_team || heard_it ? 0 : g_random());
 
 		if (plr->s.v.goalentity == item_entity)
 		{
@@ -77,6 +87,8 @@ void EvalGoal(gedict_t *self, gedict_t *goal_entity)
 	float goal_desire =
 			goal_entity && goal_entity->fb.desire ? goal_entity->fb.desire(self, goal_entity) : 0;
 	float goal_time = 0.0f;
+	float traveltime;
+	gedict_t *goal_marker;
 
 	if (!goal_entity)
 	{
@@ -111,21 +123,15 @@ void EvalGoal(gedict_t *self, gedict_t *goal_entity)
 		}
 
 		// Calculate travel time to the goal
-		from_marker = self->fb.touch_marker;
-		to_marker = goal_entity->fb.touch_marker;
-		ZoneMarker(from_marker, to_marker, path_normal, self->fb.canRocketJump);
-		traveltime = SubZoneArrivalTime(zone_time, middle_marker, to_marker,
-										self->fb.canRocketJump);
-		goal_time = traveltime;
+		goal_marker = goal_entity->fb.touch_marker;
+		goal_time = RouteTravelTime(self->fb.touch_marker, goal_marker, path_normal,
+									self->fb.canRocketJump);
 
 		if (self->fb.goal_enemy_repel)
 		{
 			// Time for our enemy to get there
-			from_marker = g_edicts[self->s.v.enemy].fb.touch_marker;
-			ZoneMarker(from_marker, to_marker, path_normal,
-						g_edicts[self->s.v.enemy].fb.canRocketJump);
-			traveltime = SubZoneArrivalTime(zone_time, middle_marker, to_marker,
-											g_edicts[self->s.v.enemy].fb.canRocketJump);
+			traveltime = RouteTravelTime(g_edicts[self->s.v.enemy].fb.touch_marker, goal_marker,
+											path_normal, g_edicts[self->s.v.enemy].fb.canRocketJump);
 
 			// If enemy will get there much faster than we will...
 			if (traveltime <= (goal_time - 1.25))
@@ -161,11 +167,8 @@ void EvalGoal(gedict_t *self, gedict_t *goal_entity)
 		{
 			if (self->fb.goal_enemy_repel)
 			{
-				qbool rl_routes = g_edicts[self->s.v.enemy].fb.canRocketJump;
-
-				from_marker = g_edicts[self->s.v.enemy].fb.touch_marker;
-				ZoneMarker(from_marker, to_marker, path_normal, rl_routes);
-				traveltime = SubZoneArrivalTime(zone_time, middle_marker, to_marker, rl_routes);
+				traveltime = RouteTravelTime(g_edicts[self->s.v.enemy].fb.touch_marker, goal_marker,
+												path_normal, g_edicts[self->s.v.enemy].fb.canRocketJump);
 				goal_entity->fb.saved_enemy_time_squared = traveltime * traveltime;
 			}
 
@@ -195,6 +198,7 @@ void EvalGoal(gedict_t *self, gedict_t *goal_entity)
 static void EvalGoal2(gedict_t *goal_entity, gedict_t *best_goal_marker, qbool canRocketJump)
 {
 	float goal_desire = 0.0f;
+	float traveltime = 0.0f;
 	float traveltime2 = 0.0f;
 
 	if (goal_entity == NULL)
@@ -209,10 +213,7 @@ static void EvalGoal2(gedict_t *goal_entity, gedict_t *best_goal_marker, qbool c
 		if (goal_time2 <= 5)
 		{
 			gedict_t *goal_marker2 = goal_entity->fb.touch_marker;
-			from_marker = goal_marker2;
-			ZoneMarker(from_marker, best_goal_marker, path_normal, canRocketJump);
-			traveltime = SubZoneArrivalTime(zone_time, middle_marker, best_goal_marker,
-											canRocketJump);
+			traveltime = RouteTravelTime(goal_marker2, best_goal_marker, path_normal, canRocketJump);
 			traveltime2 = max(best_respawn_time, goal_time2 + traveltime);
 
 			if (self->fb.bot_evade && self->fb.goal_enemy_repel)
@@ -238,9 +239,7 @@ static void EvalGoal2(gedict_t *goal_entity, gedict_t *best_goal_marker, qbool c
 				}
 			}
 
-			from_marker = best_goal_marker;
-			ZoneMarker(from_marker, goal_marker2, path_normal, canRocketJump);
-			traveltime = SubZoneArrivalTime(zone_time, middle_marker, goal_marker2, canRocketJump);
+			traveltime = RouteTravelTime(best_goal_marker, goal_marker2, path_normal, canRocketJump);
 			traveltime2 = max(self->fb.best_goal_time + traveltime,
 								goal_entity->fb.saved_respawn_time);
 			if (self->fb.bot_evade && self->fb.goal_enemy_repel)
@@ -283,11 +282,10 @@ static void EnemyGoalLogic(gedict_t *self)
 		{
 			// Work out time to enemy marker
 			gedict_t *goal_marker2 = g_edicts[self->s.v.enemy].fb.touch_marker;
+			float traveltime = 0.0f;
 			float traveltime2 = 0.0f;
 
-			from_marker = goal_marker2;
-			ZoneMarker(from_marker, best_goal_marker, path_normal, self->fb.canRocketJump);
-			traveltime = SubZoneArrivalTime(zone_time, middle_marker, best_goal_marker,
+			traveltime = RouteTravelTime(goal_marker2, best_goal_marker, path_normal,
 											self->fb.canRocketJump);
 			traveltime2 = max(goal_time2 + traveltime, best_respawn_time);
 
@@ -306,9 +304,7 @@ static void EnemyGoalLogic(gedict_t *self)
 			}
 
 			// Work out time to best goal marker
-			from_marker = best_goal_marker;
-			ZoneMarker(from_marker, goal_marker2, path_normal, self->fb.canRocketJump);
-			traveltime = SubZoneArrivalTime(zone_time, middle_marker, goal_marker2,
+			traveltime = RouteTravelTime(best_goal_marker, goal_marker2, path_normal,
 											self->fb.canRocketJump);
 			traveltime2 = max(best_goal_time + traveltime,
 								g_edicts[self->s.v.enemy].fb.saved_respawn_time);
@@ -365,10 +361,9 @@ void UpdateGoal(gedict_t *self)
 		{
 			gedict_t *enemy = &g_edicts[self->s.v.enemy];
 			// Time from here to the enemy's last marker
-			from_marker = self->fb.touch_marker;
-			ZoneMarker(from_marker, enemy->fb.touch_marker, path_normal, self->fb.canRocketJump);
-			traveltime = SubZoneArrivalTime(zone_time, middle_marker, enemy->fb.touch_marker,
-											self->fb.canRocketJump);
+			float traveltime = RouteTravelTime(self->fb.touch_marker, enemy->fb.touch_marker,
+												path_normal, self->fb.canRocketJump);
+
 			enemy_->fb.saved_respawn_time = 0;
 			enemy_->fb.saved_goal_time = traveltime;
 
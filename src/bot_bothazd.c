@@ -151,10 +151,15 @@ static void ExplodeAlert(vec3_t org, float next_time)
 {
 	gedict_t *marker;
 	gedict_t *tele;
+	gedict_t **list;
+	int i, count;
 
 	// Find all map markers close to this point
-	for (marker = world; (marker = trap_findradius(marker, org, 256));)
+	count = G_FindRadius(org, 256, 0, NULL, &list);
+	for (i = 0; i < count; i++)
 	{
+		marker = list[i];
+
 		if (marker->fb.fl_marker)
 		{
 			// Would the grenade hurt the marker?
@@ -182,6 +187,8 @@ static void ExplodeAlert(vec3_t org, float next_time)
 			}
 		}
 	}
+
+	G_SpatialRelease(count);
 }
 
 // This is essentially just to call ExplodeAlert(origin) every 0.05s, until the grenade explodes
@@ -411,15 +418,23 @@ static qbool CanJumpOver(gedict_t *self, vec3_t jump_origin, vec3_t jump_velocit
 		{
 			if ((int)self->s.v.flags & FL_ONGROUND)
 			{
-				gedict_t *ent;
+				gedict_t **list;
+				int i, count;
+				qbool reachable = true;
 
-				for (ent = world; (ent = findradius_ignore_solid(ent, testplace, 84));)
+				count = G_FindRadius(testplace, 84, SPATIAL_NONSOLID, NULL, &list);
+				for (i = 0; i < count; i++)
 				{
-					if (ent->fb.T & UNREACHABLE)
+					if (list[i]->fb.T & UNREACHABLE)
 					{
-						return false;
+						reachable = false;
+						break;
 					}
 				}
+
+				G_SpatialRelease(count);
+
+				return reachable;
 			}
 			return true;
 		}
@@ -29,22 +29,27 @@ gedict_t* IdentifyMostVisibleTeammate(gedict_t *me)
 {
 	gedict_t *p, *g = NULL;
 	float closeness = -1;
-	vec3_t diff, point;
+	vec3_t point;
 	float currclose;
 	byte visible[MAX_CLIENTS];
+	float cone[MAX_CLIENTS];
+	fb_roster_t *roster = RosterSnapshot();
+	int i;
 
 	visible_to(me, g_edicts + 1, MAX_CLIENTS, visible);
 
-	for (p = g_edicts + 1; p <= g_edicts + MAX_CLIENTS; p++)
+	// Find difference in angles between aim & aiming at teammate
+	normalize(me->s.v.angles, point);
+	RosterViewCone(roster, me->s.v.origin, point, cone);
+
+	for (i = 0; i < roster->count; i++)
 	{
-		if ((me != p) && p->ct == ctPlayer && visible[p - (g_edicts + 1)] && SameTeam(me, p))
+		p = roster->ent[i];
+
+		if ((me != p) && visible[p - (g_edicts + 1)] && SameTeam(me, p)
+				&& ((closeness == -1) || (cone[i] < closeness)))
 		{
-			// Find difference in angles between aim & aiming at teammate
-			VectorSubtract(p->s.v.origin, me->s.v.origin, diff);
-			VectorNormalize(diff);
-			normalize(me->s.v.angles, point);
-			VectorSubtract(diff, point, diff);
-			currclose = vlen(diff);
+			currclose = cone[i];
 
 			// If we have direct visibility
 			traceline(PASSVEC3(me->s.v.origin), PASSVEC3(p->s.v.origin), false, me);
@@ -92,6 +97,8 @@ gedict_t* HelpTeammate(void)
 {
 	gedict_t *goalent;
 	gedict_t *head, *selected1, *selected2;
+	gedict_t **list;
+	int i, count;
 	float d, bdist, best_dist1, best_dist2;
 
 	if (!teamplay)
@@ -155,8 +162,11 @@ gedict_t* HelpTeammate(void)
 	selected2 = NULL;
 	best_dist1 = 10e+32;
 	best_dist2 = 10e+32;
-	for (head = world; (head = trap_findradius(head, self->s.v.origin, bdist));)
+	count = G_FindRadius(self->s.v.origin, bdist, SPATIAL_PLAYERS, NULL, &list);
+	for (i = 0; i < count; i++)
 	{
+		head = list[i];
+
 		if (head->ct == ctPlayer)
 		{
 			if (SameTeam(head, self))
@@ -215,6 +225,8 @@ gedict_t* HelpTeammate(void)
 		}
 	}
 
+	G_SpatialRelease(count);
+
 	if (selected1)
 	{
 		return selected1;
@@ -75,15 +75,9 @@ static void EvalCloseRunAway(float runaway_time, gedict_t *enemy_touch_marker,
 								gedict_t **best_away_marker, gedict_t *touch_marker)
 {
 	float test_away_score = 0;
-	float traveltime2;
-
-	from_marker = enemy_touch_marker;
-	ZoneMarker(from_marker, to_marker, path_normal, false);
-	traveltime = SubZoneArrivalTime(zone_time, middle_marker, to_marker, false);
-	traveltime2 = traveltime;
-	from_marker = touch_marker;
-	ZoneMarker(from_marker, to_marker, path_normal, false);
-	traveltime = SubZoneArrivalTime(zone_time, middle_marker, to_marker, false);
+	float traveltime2 = RouteTravelTime(enemy_touch_marker, to_marker, path_normal, false);
+	float traveltime = RouteTravelTime(touch_marker, to_marker, path_normal, false);
+
 	if (look_traveltime)
 	{
 		test_away_score = g_random() * runaway_time
@@ -217,31 +211,32 @@ static qbool PredictionShotLogic(gedict_t *self, gedict_t *goalentity_marker)
 		from_marker = (from_marker ? from_marker : goalentity_marker);
 		if (from_marker)
 		{
-			gedict_t *to_marker = self->fb.linked_marker;
+			fb_route_query_t query;
+
+			query.from_marker = from_marker;
+			query.to_marker = self->fb.linked_marker;
+			query.path_normal = true;
+			query.rj_routes = self->fb.canRocketJump;
 
-			look_marker = SightFromMarkerFunction(from_marker, to_marker);
+			look_marker = SightFromMarkerFunction(from_marker, query.to_marker);
 			if (look_marker)
 			{
 				path_normal = true;
-				ZoneMarker(from_marker, look_marker, path_normal, self->fb.canRocketJump);
-				traveltime = SubZoneArrivalTime(zone_time, middle_marker, look_marker,
-												self->fb.canRocketJump);
-				look_traveltime = traveltime;
+				query.to_marker = look_marker;
+				RouteQuery(&query);
 			}
 			else
 			{
-				look_marker = SightMarker(from_marker, to_marker, 0, 0);
+				look_marker = SightMarkerQuery(&query, 0, 0);
 			}
 
 			if (look_marker)
 			{
-				to_marker = from_marker;
-				from_marker = self->fb.linked_marker;
+				float look_time = query.traveltime;
+
 				path_normal = true;
-				ZoneMarker(from_marker, to_marker, path_normal, self->fb.canRocketJump);
-				traveltime = SubZoneArrivalTime(zone_time, middle_marker, to_marker,
-												self->fb.canRocketJump);
-				if (look_traveltime < traveltime)
+				if (look_time < RouteTravelTime(self->fb.linked_marker, from_marker, true,
+												self->fb.canRocketJump))
 				{
 					self->fb.look_object = look_marker;
 					self->fb.predict_shoot = true;
@@ -103,13 +103,24 @@ static void NewlyPickedEnemyLogic(void)
 	}
 }
 
+static qbool LookingAtPlayer(gedict_t *self)
+{
+	return (self->fb.look_object && (self->fb.look_object->ct == ctPlayer));
+}
+
+// TargetEnemyLogic() will look for a new enemy, the think scheduler's BOT_TASK_ENEMY
+qbool BotSearchesEnemy(gedict_t *self)
+{
+	return !(self->fb.state & NOTARGET_ENEMY) && !LookingAtPlayer(self) && !self->s.v.enemy;
+}
+
 static void TargetEnemyLogic(gedict_t *self)
 {
 	self->fb.missile_dodge = NULL;
 
 	if (!(self->fb.state & NOTARGET_ENEMY))
 	{
-		if (self->fb.look_object && (self->fb.look_object->ct == ctPlayer))
+		if (LookingAtPlayer(self))
 		{
 			// Interesting - they only avoid missiles from players they are looking at?
 			AvoidLookObjectsMissile(self);
@@ -120,7 +131,7 @@ static void TargetEnemyLogic(gedict_t *self)
 		{
 			NewlyPickedEnemyLogic();
 		}
-		else
+		else if (BotThinkTaskGranted(self, BOT_TASK_ENEMY))
 		{
 			BotsPickBestEnemy(self);
 		}
@@ -276,7 +287,7 @@ static void BotTouchMarkerLogic(void)
 {
 	TargetEnemyLogic(self);
 
-	if (PAST(goal_refresh_time))
+	if (PAST(goal_refresh_time) && BotThinkTaskGranted(self, BOT_TASK_GOAL))
 	{
 		UpdateGoal(self);
 	}
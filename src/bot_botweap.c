@@ -202,33 +202,27 @@ static void AvoidQuadBore(gedict_t *self)
 // FIXME: This doesn't do what it says, as it has teamplay-value checks
 static qbool CouldHurtTeammate(gedict_t *me)
 {
-	float ang, curang;
+	float ang[MAX_CLIENTS];
 	gedict_t *p;
+	fb_roster_t *roster;
+	int i;
 
 	if (teamplay == 0 || teamplay == 1 || teamplay == 5)
 	{
 		return false;
 	}
 
-	for (p = world; (p = find_plr(p));)
+	roster = RosterSnapshot();
+	RosterYawDeltas(roster, me->s.v.origin, me->s.v.angles[1], ang);
+
+	for (i = 0; i < roster->count; i++)
 	{
-		if (p != me)
+		p = roster->ent[i];
+
+		// FIXME: fb.skill
+		if ((p != me) && (ang[i] < 20 || ang[i] > 340) && SameTeam(me, p) && VisibleEntity(p))
 		{
-			if (SameTeam(me, p))
-			{
-				if (VisibleEntity(p))
-				{
-					vec3_t diff;
-					VectorSubtract(p->s.v.origin, me->s.v.origin, diff);
-					curang = vectoyaw(diff);
-					ang = anglemod(me->s.v.angles[1] - curang);
-					// FIXME: fb.skill
-					if (ang < 20 || ang > 340)
-					{
-						return true;
-					}
-				}
-			}
+			return true;
 		}
 	}
 
@@ -345,13 +339,11 @@ static void RocketLauncherShot(gedict_t *self)
 				{
 					VectorAdd(self->fb.look_object->s.v.absmin, self->fb.look_object->s.v.view_ofs,
 								testplace);
-					from_marker = g_edicts[self->s.v.enemy].fb.touch_marker;
 					path_normal = true;
-					ZoneMarker(from_marker, self->fb.look_object, path_normal,
-								g_edicts[self->s.v.enemy].fb.canRocketJump);
-					traveltime = SubZoneArrivalTime(zone_time, middle_marker, self->fb.look_object,
-													g_edicts[self->s.v.enemy].fb.canRocketJump);
-					predict_dist = (traveltime * sv_maxspeed)
+					predict_dist = (RouteTravelTime(g_edicts[self->s.v.enemy].fb.touch_marker,
+													self->fb.look_object, path_normal,
+													g_edicts[self->s.v.enemy].fb.canRocketJump)
+									* sv_maxspeed)
 							+ VectorDistance(testplace, self->fb.rocket_endpos);
 				}
 			}
@@ -51,8 +51,7 @@ static qbool customised_skill = false;
 
 static qbool marker_time;
 static float next_marker_time;
-static qbool hazard_time;
-static float next_hazard_time;
+static int think_budget;
 
 static vec3_t saved_marker_pos =
 	{ -999999, -999999, -999999 };
@@ -83,9 +82,9 @@ qbool IsMarkerFrame(void)
 	return marker_time;
 }
 
-qbool IsHazardFrame(void)
+qbool BotThinkTaskGranted(gedict_t *self, int task)
 {
-	return hazard_time;
+	return ((think_budget <= 0) || (self->fb.think_tasks & task));
 }
 
 typedef struct botcmd_s
@@ -651,20 +650,24 @@ static void FrogbotsDebug(void)
 
 				if (from && to)
 				{
+					fb_route_query_t query;
+
 					G_sprint(self, 2, "%s \20%s\21 -> %s \20%s\21\n", from->classname,
 								LocationName(PASSVEC3(from->s.v.origin)), to->classname,
 								LocationName(PASSVEC3(to->s.v.origin)));
 					G_sprint(self, 2, "From zone %d, subzone %d to zone %d subzone %d\n",
 								from->fb.Z_, from->fb.S_, to->fb.Z_, to->fb.S_);
-					from_marker = from;
-					ZoneMarker(from_marker, to, path_normal, allow_rj);
-					traveltime = SubZoneArrivalTime(zone_time, middle_marker, to, allow_rj);
-					G_sprint(self, 2, "Travel time %f, zone_time %f\n", traveltime, zone_time);
+					query.from_marker = from;
+					query.to_marker = to;
+					query.path_normal = path_normal;
+					query.rj_routes = allow_rj;
+					RouteQuery(&query);
+					G_sprint(self, 2, "Travel time %f, zone_time %f\n", query.traveltime, query.zone_time);
 					G_sprint(self, 2, "Middle marker %d \20%s\21 (zone %d subzone %d), time %f\n",
-								middle_marker->fb.index + 1,
-								LocationName(PASSVEC3(middle_marker->s.v.origin)),
-								middle_marker->fb.Z_, middle_marker->fb.S_,
-								middle_marker->fb.subzones[to->fb.S_].time);
+								query.middle_marker->fb.index + 1,
+								LocationName(PASSVEC3(query.middle_marker->s.v.origin)),
+								query.middle_marker->fb.Z_, query.middle_marker->fb.S_,
+								query.middle_marker->fb.subzones[to->fb.S_].time);
 
 					{
 						float best_score = -1000000;
@@ -2600,6 +2603,128 @@ qbool TimeTrigger(float *next_time, float time_increment)
 	return triggered;
 }
 
+// Think scheduler: the heavier per-bot tasks are granted in priority order until
+//   k_fb_think_budget work units have been spent this frame (0 = no limit)
+#define BOT_HAZARD_INTERVAL   0.025
+#define BOT_HAZARD_PHASES     8
+#define BOT_COMBAT_PRIORITY   3		// frames of waiting, a bot deferred longer goes before fighting ones
+
+static int BotThinkTasksDue(gedict_t *bot)
+{
+	int tasks = 0;
+
+	if (bot->fb.next_hazard_time == 0)
+	{
+		// stagger the first run so bots don't all avoid hazards on the same frame
+		bot->fb.next_hazard_time = g_globalvars.time
+				+ BOT_HAZARD_INTERVAL * (NUM_FOR_EDICT(bot) % BOT_HAZARD_PHASES) / BOT_HAZARD_PHASES;
+	}
+
+	if (g_globalvars.time >= bot->fb.next_hazard_time)
+	{
+		tasks |= BOT_TASK_HAZARD;
+	}
+
+	if ((bot->fb.state & AWARE_SURROUNDINGS) && (g_globalvars.time >= bot->fb.goal_refresh_time))
+	{
+		tasks |= BOT_TASK_GOAL;
+	}
+
+	if (BotSearchesEnemy(bot))
+	{
+		tasks |= BOT_TASK_ENEMY;
+	}
+
+	return tasks;
+}
+
+static int BotThinkTaskCost(int task)
+{
+	switch (task)
+	{
+		case BOT_TASK_GOAL:
+			return 4; // goal evaluation + path scoring
+		case BOT_TASK_HAZARD:
+		case BOT_TASK_ENEMY:
+		default:
+			return 1;
+	}
+}
+
+static int BotThinkPriority(gedict_t *bot)
+{
+	// bots in a fight first, then whoever has waited longest
+	return (bot->s.v.enemy ? BOT_COMBAT_PRIORITY : 0) + bot->fb.think_deferred;
+}
+
+static void BotScheduleThinking(void)
+{
+	static const int task_order[] =
+		{ BOT_TASK_HAZARD, BOT_TASK_ENEMY, BOT_TASK_GOAL };
+	gedict_t *queue[MAX_CLIENTS];
+	int priority[MAX_CLIENTS];
+	int count = 0;
+	int remaining;
+	int i, j;
+	gedict_t *p;
+
+	think_budget = cvar(FB_CVAR_THINK_BUDGET);
+	remaining = think_budget;
+
+	for (p = world; (p = find_plr(p)) && (count < MAX_CLIENTS);)
+	{
+		if (!p->isBot)
+		{
+			continue;
+		}
+
+		p->fb.think_tasks = 0;
+
+		// insertion sort, highest priority first
+		for (i = count; (i > 0) && (priority[i - 1] < BotThinkPriority(p)); --i)
+		{
+			queue[i] = queue[i - 1];
+			priority[i] = priority[i - 1];
+		}
+
+		queue[i] = p;
+		priority[i] = BotThinkPriority(p);
+		++count;
+	}
+
+	for (i = 0; i < count; ++i)
+	{
+		int due = BotThinkTasksDue(queue[i]);
+		qbool deferred = false;
+
+		for (j = 0; j < sizeof(task_order) / sizeof(task_order[0]); ++j)
+		{
+			int task = task_order[j];
+
+			if (!(due & task))
+			{
+				continue;
+			}
+
+			if (think_budget <= 0)
+			{
+				queue[i]->fb.think_tasks |= task;
+			}
+			else if (BotThinkTaskCost(task) <= remaining)
+			{
+				queue[i]->fb.think_tasks |= task;
+				remaining -= BotThinkTaskCost(task);
+			}
+			else
+			{
+				deferred = true;
+			}
+		}
+
+		queue[i]->fb.think_deferred = (deferred ? queue[i]->fb.think_deferred + 1 : 0);
+	}
+}
+
 static void BotInitialiseServer(void)
 {
 	dropper = spawn();
@@ -2652,11 +2777,12 @@ void BotStartFrame(void)
 		gedict_t *lowest_scoring_bot = NULL;
 
 		marker_time = TimeTrigger(&next_marker_time, 0.03);
-		hazard_time = TimeTrigger(&next_hazard_time, 0.025);
 
 		FrogbotPrePhysics1();
 		FrogbotPrePhysics2();
 
+		BotScheduleThinking();
+
 		for (self = world; (self = find_plr(self));)
 		{
 			++client_count;
@@ -2675,10 +2801,12 @@ void BotStartFrame(void)
 					Bot_Print_Thinking();
 				}
 
-				if (IsHazardFrame())
+				if (self->fb.think_tasks & BOT_TASK_HAZARD)
 				{
 					gedict_t *p;
 
+					TimeTrigger(&self->fb.next_hazard_time, BOT_HAZARD_INTERVAL);
+
 					// Set all players to non-solid so we can avoid hazards
 					for (p = world; (p = find_plr(p));)
 					{
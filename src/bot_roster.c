@@ -0,0 +1,86 @@
+// bot_roster.c - positions of all players as flat arrays, for the per pair bot
+// math that otherwise repeats the same vector work for every bot. The loops only touch plain
+// float arrays so native compilers can vectorise them, QVM just runs them as they are.
+
+#ifdef BOT_SUPPORT
+
+#include "g_local.h"
+
+static fb_roster_t roster;
+
+// copy the current state of every player
+fb_roster_t* RosterSnapshot(void)
+{
+	gedict_t *p;
+	int n = 0;
+
+	for (p = world; (p = find_plr(p));)
+	{
+		roster.ent[n] = p;
+		roster.x[n] = p->s.v.origin[0];
+		roster.y[n] = p->s.v.origin[1];
+		roster.z[n] = p->s.v.origin[2];
+		n++;
+	}
+
+	roster.count = n;
+
+	return &roster;
+}
+
+// distance from org to each player
+void RosterDistances(fb_roster_t *r, vec3_t org, float *out)
+{
+	float dx, dy, dz;
+	int i;
+
+	for (i = 0; i < r->count; i++)
+	{
+		dx = r->x[i] - org[0];
+		dy = r->y[i] - org[1];
+		dz = r->z[i] - org[2];
+		out[i] = dx * dx + dy * dy + dz * dz;
+	}
+
+	for (i = 0; i < r->count; i++)
+	{
+		out[i] = sqrt(out[i]);
+	}
+}
+
+// |normalized (player - org) - dir|, 0 when dir points straight at the player
+void RosterViewCone(fb_roster_t *r, vec3_t org, vec3_t dir, float *out)
+{
+	float dx, dy, dz, len;
+	int i;
+
+	for (i = 0; i < r->count; i++)
+	{
+		dx = r->x[i] - org[0];
+		dy = r->y[i] - org[1];
+		dz = r->z[i] - org[2];
+		len = sqrt(dx * dx + dy * dy + dz * dz);
+		len = len ? 1 / len : 0;
+		dx = dx * len - dir[0];
+		dy = dy * len - dir[1];
+		dz = dz * len - dir[2];
+		out[i] = sqrt(dx * dx + dy * dy + dz * dz);
+	}
+}
+
+// anglemod(yaw - yaw towards each player), same as vectoyaw() based checks
+void RosterYawDeltas(fb_roster_t *r, vec3_t org, float yaw, float *out)
+{
+	vec3_t diff;
+	int i;
+
+	for (i = 0; i < r->count; i++)
+	{
+		diff[0] = r->x[i] - org[0];
+		diff[1] = r->y[i] - org[1];
+		diff[2] = r->z[i] - org[2];
+		out[i] = anglemod(yaw - vectoyaw(diff));
+	}
+}
+
+#endif
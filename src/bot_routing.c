@@ -119,12 +119,11 @@ static float EvalPath(fb_path_eval_t *eval, qbool allowRocketJumps, qbool trace_
 	else if (eval->goalentity_marker)
 	{
 		float total_goal_time;
+		float traveltime;
 
 		// Calculate time from marker > goal entity
-		from_marker = eval->test_marker;
 		path_normal = eval->path_normal;
-		ZoneMarker(from_marker, eval->goalentity_marker, path_normal, allowRocketJumps);
-		traveltime = SubZoneArrivalTime(zone_time, middle_marker, eval->goalentity_marker,
+		traveltime = RouteTravelTime(eval->test_marker, eval->goalentity_marker, eval->path_normal,
 										allowRocketJumps);
 		total_goal_time = eval->path_time + traveltime;
 
@@ -212,12 +211,9 @@ void PathScoringLogic(float goal_respawn_time, qbool be_quiet, float lookahead_t
 
 	if (goalentity_marker)
 	{
-		from_marker = touch_marker_;
-		ZoneMarker(from_marker, goalentity_marker, path_normal, rocket_jump_routes_allowed);
-		traveltime = SubZoneArrivalTime(zone_time, middle_marker, goalentity_marker,
-										rocket_jump_routes_allowed);
-		current_goal_time = traveltime;
-		current_goal_time_125 = traveltime + 1.25;
+		current_goal_time = RouteTravelTime(touch_marker_, goalentity_marker, path_normal,
+											rocket_jump_routes_allowed);
+		current_goal_time_125 = current_goal_time + 1.25;
 
 		// FIXME: Estimating respawn times should be skill-based
 		if (current_goal_time < 2.5)
@@ -15,6 +15,24 @@ static qbool do_endround_stuff = false;
 static qbool print_stats = false;
 static float loser_respawn_time = 999; 	// number of seconds before a teammate would've respawned
 
+// per team counts, so round logic and HUD don't rescan every player for every player
+typedef struct ca_team_s
+{
+	char name[128];
+	int players;
+	int live;					// ISLIVE() players, ready or not
+	int ready;					// ca_ready players
+	int alive;					// ca_ready and in play
+	int dead;					// ca_ready and not in play
+	float respawn;				// lowest seconds_to_respawn of the dead ones, 999 if none
+} ca_team_t;
+
+static ca_team_t ca_teams[MAX_CLIENTS];
+static int ca_teams_cnt;
+static int ca_team_idx[MAX_CLIENTS + 1];	// by edict number, -1 = not a player
+static int ca_teams_frame = -1;
+static qbool ca_teams_dirty = true;
+
 void track_player(gedict_t *observer);
 void enable_player_tracking(gedict_t *e, int follow);
 void r_changetrackingstatus(float t);
@@ -60,19 +78,133 @@ gedict_t* ca_get_player(gedict_t *observer)
 
 qbool is_rules_change_allowed(void);
 
-int CA_count_ready_players(void)
+// someone died, respawned, got ready or changed team, team counts are built again on next use
+void CA_TeamsChanged(void)
 {
-	int cnt;
+	ca_teams_dirty = true;
+}
+
+static void CA_TeamsBuild(void)
+{
+	ca_team_t *t;
 	gedict_t *p;
+	char *team;
+	int i;
 
-	for (cnt = 0, p = world; (p = find_plr(p));)
+	ca_teams_cnt = 0;
+	for (i = 0; i <= MAX_CLIENTS; i++)
 	{
-		if (p->ca_ready)
+		ca_team_idx[i] = -1;
+	}
+
+	for (p = world; (p = find_plr(p));)
+	{
+		team = getteam(p);
+
+		for (i = 0; i < ca_teams_cnt; i++)
+		{
+			if (streq(ca_teams[i].name, team))
+			{
+				break;
+			}
+		}
+
+		t = &ca_teams[i];
+		if (i == ca_teams_cnt)
+		{
+			memset(t, 0, sizeof(*t));
+			strlcpy(t->name, team, sizeof(t->name));
+			t->respawn = 999;
+			ca_teams_cnt++;
+		}
+
+		ca_team_idx[NUM_FOR_EDICT(p)] = i;
+		t->players++;
+
+		if (ISLIVE(p))
 		{
-			cnt++;
+			t->live++;
+		}
+
+		if (!p->ca_ready)
+		{
+			continue;
+		}
+
+		t->ready++;
+
+		if (p->in_play)
+		{
+			t->alive++;
+		}
+		else
+		{
+			t->dead++;
+			t->respawn = min(t->respawn, p->seconds_to_respawn);
 		}
 	}
 
+	ca_teams_frame = framecount;
+	ca_teams_dirty = false;
+}
+
+// up to date for this frame, players also move between frames without telling us
+static void CA_TeamsCheck(void)
+{
+	if (ca_teams_dirty || (ca_teams_frame != framecount))
+	{
+		CA_TeamsBuild();
+	}
+}
+
+static ca_team_t* CA_TeamOf(gedict_t *p)
+{
+	int n = NUM_FOR_EDICT(p);
+
+	CA_TeamsCheck();
+
+	return (((n <= MAX_CLIENTS) && (ca_team_idx[n] >= 0)) ? &ca_teams[ca_team_idx[n]] : NULL);
+}
+
+static ca_team_t* CA_TeamByName(char *name)
+{
+	int i;
+
+	CA_TeamsCheck();
+
+	for (i = 0; i < ca_teams_cnt; i++)
+	{
+		if (streq(ca_teams[i].name, name))
+		{
+			return &ca_teams[i];
+		}
+	}
+
+	return NULL;
+}
+
+// seconds_to_respawn of a dead player counted down
+static void CA_TeamsRespawnTime(gedict_t *p)
+{
+	ca_team_t *t = CA_TeamOf(p);
+
+	if (t && p->ca_ready && !p->in_play)
+	{
+		t->respawn = min(t->respawn, p->seconds_to_respawn);
+	}
+}
+
+int CA_count_ready_players(void)
+{
+	int cnt, i;
+
+	CA_TeamsCheck();
+
+	for (cnt = 0, i = 0; i < ca_teams_cnt; i++)
+	{
+		cnt += ca_teams[i].ready;
+	}
+
 	return cnt;
 }
 
@@ -93,12 +225,12 @@ int calc_respawn_time(gedict_t *p, int offset)
 	int time = 999;
 	int teamsize = 0;
 	int multiple;
-	gedict_t *p2;
+	ca_team_t *t = CA_TeamOf(p);
 
 	// count players on team
-	for (p2 = world; (p2 = find_plr_same_team(p2, getteam(p)));)
+	if (t)
 	{
-		teamsize++;
+		teamsize = t->players;
 	}
 
 	multiple = bound(3, teamsize+1, 6);	// first respawn won't take more than 6 seconds regardless of team size
@@ -118,26 +250,13 @@ int calc_respawn_time(gedict_t *p, int offset)
 // otherwise returns number of seconds until next teammate respawns
 float last_alive_time(gedict_t *player)
 {
-	gedict_t *p;
+	ca_team_t *t = CA_TeamOf(player);
 	float time = 0;
 
-	for (p = world; (p = find_plr_same_team(p, getteam(player)));)
+	// no teammate in play, but some waiting for respawn
+	if (t && t->dead && (t->alive == ((player->ca_ready && player->in_play) ? 1 : 0)))
 	{
-		if (p->ca_ready)
-		{
-			if (p->in_play && p != player)
-			{
-				time = 0;
-				break;
-			}
-			else if (!p->in_play)
-			{
-				if (!time || p->seconds_to_respawn < time)
-				{
-					time = p->seconds_to_respawn;
-				}
-			}
-		}
+		time = t->respawn;
 	}
 
 	// this checks to see if there's already a last_alive_countdown in progress
@@ -165,25 +284,23 @@ float last_alive_time(gedict_t *player)
 
 float enemy_last_alive_time(gedict_t *player)
 {
-	gedict_t *p;
+	ca_team_t *own = CA_TeamOf(player);
 	float time = 0;
 	int alive_enemies = 0;
+	int i;
 
-	for (p = world; (p = find_plr(p));)
+	for (i = 0; i < ca_teams_cnt; i++)
 	{
-		if (p->ca_ready && strneq(getteam(p), getteam(player)))
+		if (&ca_teams[i] == own)
 		{
-			if (p->in_play)
-			{
-				alive_enemies++;
-			}
-			else if (!p->in_play)
-			{
-				if (!time || p->seconds_to_respawn < time)
-				{
-					time = p->seconds_to_respawn;
-				}
-			}
+			continue;
+		}
+
+		alive_enemies += ca_teams[i].alive;
+
+		if (ca_teams[i].dead && (!time || (ca_teams[i].respawn < time)))
+		{
+			time = ca_teams[i].respawn;
 		}
 	}
 
@@ -192,22 +309,10 @@ float enemy_last_alive_time(gedict_t *player)
 
 float team_last_alive_time(int team)
 {
-	gedict_t *p;
-	float time = 999;
 	char* team_name = team ? (team == 1 ? cvar_string("_k_team1") : cvar_string("_k_team2")) : "";
+	ca_team_t *t = CA_TeamByName(team_name);
 
-	for (p = world; (p = find_plr_same_team(p, team_name));)
-	{
-		if (p->ca_ready && !p->in_play)
-		{
-			if (p->seconds_to_respawn < time)
-			{
-				time = p->seconds_to_respawn;
-			}
-		}
-	}
-
-	return time;
+	return (t ? t->respawn : 999);
 }
 
 void SM_PrepareCA(void)
@@ -231,6 +336,8 @@ void SM_PrepareCA(void)
 			p->teamcolor = NULL;
 		}
 	}
+
+	CA_TeamsChanged();
 }
 
 int CA_wins_required(void)
@@ -296,6 +403,8 @@ void CA_MatchBreak(void)
 
 		p->ca_ready = 0;	// this needs to be reset
 	}
+
+	CA_TeamsChanged();
 }
 
 void track_player(gedict_t *observer)
@@ -482,6 +591,8 @@ void CA_PutClientInServer(void)
 		return;
 	}
 
+	CA_TeamsChanged(); // in_play and in_limbo change below
+
 	// set CA self params
 	if (match_in_progress == 2)
 	{
@@ -803,6 +914,8 @@ void CA_check_escape(gedict_t *targ, gedict_t *attacker)
 
 void CA_ClientObituary(gedict_t *targ, gedict_t *attacker)
 {
+	CA_TeamsChanged();
+
 	attacker->round_kills++;
 	
 	if (cvar("k_clan_arena") == 2)	// Wipeout only
@@ -851,35 +964,31 @@ void CA_ClientObituary(gedict_t *targ, gedict_t *attacker)
 // return 2 if there at least two alive teams
 static int CA_check_alive_teams(int *alive_team)
 {
-	gedict_t *p;
 	qbool few_alive_teams = false;
 	char *first_team = NULL;
+	int i;
 
 	if (alive_team)
 	{
 		*alive_team = 0;
 	}
 
-	for (p = world; (p = find_plr(p));)
+	CA_TeamsCheck();
+
+	for (i = 0; i < ca_teams_cnt; i++)
 	{
-		if (!first_team)
+		if (!ca_teams[i].live)
 		{
-			if (ISLIVE(p))
-			{
-				first_team = getteam(p); // ok, we found first team with alive players
-			}
-
 			continue;
 		}
 
-		if (strneq(first_team, getteam(p)))
+		if (first_team)
 		{
-			if (ISLIVE(p))
-			{
-				few_alive_teams = true; // we found at least two teams with alive players
-				break;
-			}
+			few_alive_teams = true; // we found at least two teams with alive players
+			break;
 		}
+
+		first_team = ca_teams[i].name; // ok, we found first team with alive players
 	}
 
 	if (few_alive_teams)
@@ -1062,6 +1171,8 @@ void EndRound(int alive_team)
 		pause_time = g_globalvars.time + 8;
 		loser_team = alive_team ? (alive_team == 1 ? 2 : 1) : 0;
 		loser_respawn_time = loser_team ? team_last_alive_time(loser_team) : 999;
+
+		LogEventRoundEnd(round_num, alive_team ? cvar_string(va("_k_team%d", alive_team)) : "");
 	}
 
 	pause_count = Q_rint(pause_time - g_globalvars.time);
@@ -1395,6 +1506,7 @@ void CA_Frame(void)
 				}
 
 				p->seconds_to_respawn = p->spawn_delay - g_globalvars.time;
+				CA_TeamsRespawnTime(p);
 
 				if (p->seconds_to_respawn <= 0)
 				{
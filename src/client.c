@@ -1012,6 +1012,192 @@ float CheckSpawnPoint(vec3_t v)
 	return false;
 }
 
+// spawn point index: the spots of each spawn classname, with a bit set for every client near a spot.
+// A client's bits are only recalculated after it moved, so selecting a spot needs no radius queries.
+
+#define SPAWN_INDEX_CLASSES		8
+#define SPAWN_INDEX_SPOTS		512		// shared by all classes
+#define SPAWN_OCCUPIED_RADIUS	84
+
+typedef struct spawn_index_s
+{
+	char classname[64];
+	int first;								// first spot in spawn_spots[]
+	int count;
+	vec3_t client_at[MAX_CLIENTS];			// client's center when its bits were last set
+	qbool client_indexed[MAX_CLIENTS];
+} spawn_index_t;
+
+static spawn_index_t spawn_index[SPAWN_INDEX_CLASSES];
+static int spawn_index_cnt;
+static gedict_t *spawn_spots[SPAWN_INDEX_SPOTS];
+static unsigned int spawn_occupied[SPAWN_INDEX_SPOTS];	// bit per client near the spot
+static int spawn_spots_cnt;
+
+void SpawnIndexInvalidate(void)
+{
+	spawn_index_cnt = 0;
+	spawn_spots_cnt = 0;
+}
+
+// drop the index if a spot of an indexed classname is spawned or removed
+void SpawnIndexChanged(gedict_t *e)
+{
+	int i;
+
+	if (strnull(e->classname))
+	{
+		return;
+	}
+
+	for (i = 0; i < spawn_index_cnt; i++)
+	{
+		if (streq(spawn_index[i].classname, e->classname))
+		{
+			SpawnIndexInvalidate();
+
+			return;
+		}
+	}
+}
+
+static spawn_index_t* SpawnIndexBuild(char *spawnname)
+{
+	spawn_index_t *index;
+	gedict_t *spot;
+	int count = find_cnt(FOFCLSN, spawnname);
+
+	if ((spawn_index_cnt >= SPAWN_INDEX_CLASSES) || (spawn_spots_cnt + count > SPAWN_INDEX_SPOTS))
+	{
+		SpawnIndexInvalidate();
+	}
+
+	index = &spawn_index[spawn_index_cnt++];
+	memset(index, 0, sizeof(*index));
+	strlcpy(index->classname, spawnname, sizeof(index->classname));
+	index->first = spawn_spots_cnt;
+
+	for (spot = world; (spot = find(spot, FOFCLSN, spawnname));)
+	{
+		if (spawn_spots_cnt >= SPAWN_INDEX_SPOTS)
+		{
+			G_cprint("SpawnIndexBuild: too many %s\n", spawnname);
+			break;
+		}
+
+		spawn_spots[spawn_spots_cnt] = spot;
+		spawn_occupied[spawn_spots_cnt] = 0;
+		spawn_spots_cnt++;
+		index->count++;
+	}
+
+	return index;
+}
+
+static spawn_index_t* SpawnIndexFor(char *spawnname)
+{
+	int i, j;
+
+	for (i = 0; i < spawn_index_cnt; i++)
+	{
+		spawn_index_t *index = &spawn_index[i];
+
+		if (strneq(index->classname, spawnname))
+		{
+			continue;
+		}
+
+		// spots may be renamed, by bots for example
+		for (j = 0; j < index->count; j++)
+		{
+			if (strneq(spawn_spots[index->first + j]->classname, spawnname))
+			{
+				break;
+			}
+		}
+
+		if (j == index->count)
+		{
+			return index;
+		}
+
+		SpawnIndexInvalidate();
+		break;
+	}
+
+	return SpawnIndexBuild(spawnname);
+}
+
+// set client's bits in the spots it is near, same test as trap_findradius()
+static void SpawnIndexUpdate(spawn_index_t *index, gedict_t *p)
+{
+	int n = NUM_FOR_EDICT(p) - 1;
+	unsigned int bit = 1u << n;
+	vec3_t center, delta;
+	int i;
+
+	VectorAdd(p->s.v.mins, p->s.v.maxs, center);
+	VectorMA(p->s.v.origin, 0.5, center, center);
+
+	if (index->client_indexed[n] && VectorCompare(center, index->client_at[n]))
+	{
+		return;
+	}
+
+	VectorCopy(center, index->client_at[n]);
+	index->client_indexed[n] = true;
+
+	for (i = index->first; i < index->first + index->count; i++)
+	{
+		VectorSubtract(spawn_spots[i]->s.v.origin, center, delta);
+
+		if (DotProduct(delta, delta) <= (SPAWN_OCCUPIED_RADIUS * SPAWN_OCCUPIED_RADIUS))
+		{
+			spawn_occupied[i] |= bit;
+		}
+		else
+		{
+			spawn_occupied[i] &= ~bit;
+		}
+	}
+}
+
+// bits of the clients which make a spot unusable for self
+static unsigned int SpawnIndexBlockers(spawn_index_t *index, int k_spw)
+{
+	unsigned int blockers = 0;
+	gedict_t *p;
+
+	for (p = world; (p = find_plr(p));)
+	{
+		if (ISDEAD(p) || (p == self) || (p->s.v.solid == SOLID_NOT))
+		{
+			continue; // ignore dead player, or self
+		}
+
+		// k_spw 2 and 3 and 4 feature, if player is spawned not far away and run
+		// around spot - treat this spot as not valid.
+		// k_1spawn store this "not far away" time.
+		// k_1spawn is _also_ set after player passed teleport
+		if (((k_spw == 2) || (k_spw == 3) || (k_spw == 4)) && (match_in_progress == 2)
+				&& (p->k_1spawn < g_globalvars.time))
+		{
+			continue;
+		}
+
+		SpawnIndexUpdate(index, p);
+		blockers |= 1u << (NUM_FOR_EDICT(p) - 1);
+	}
+
+	return blockers;
+}
+
+// number of spots with that classname
+int SpawnIndexCount(char *spawnname)
+{
+	return SpawnIndexFor(spawnname)->count;
+}
+
 /*
  ============
  SelectSpawnPoint
@@ -1024,9 +1210,12 @@ gedict_t* Sub_SelectSpawnPoint(char *spawnname)
 	gedict_t *spot;
 	gedict_t *spots;			// chain of "valid" spots
 	gedict_t *thing;
+	spawn_index_t *index;
+	unsigned int blockers;	// clients which make a spot unusable
 	int numspots;		// count of "valid" spots
 	int totalspots;
 	int pcount;
+	int i;
 	int k_spw = cvar("k_spw");
 	int weight_sum = 0;	// used by "fair spawns"
 
@@ -1058,30 +1247,16 @@ gedict_t* Sub_SelectSpawnPoint(char *spawnname)
 	spots = world;
 	totalspots = numspots = 0;
 
-	for (spot = world; (spot = find(spot, FOFCLSN, spawnname));)
+	index = SpawnIndexFor(spawnname);
+	blockers = SpawnIndexBlockers(index, k_spw);
+
+	for (i = index->first; i < index->first + index->count; i++)
 	{
+		spot = spawn_spots[i];
 		totalspots++;
-		pcount = 0;
 
-		// find count of nearby players for 'spot'
-		for (thing = world; (thing = trap_findradius(thing, spot->s.v.origin, 84));)
-		{
-			if ((thing->ct != ctPlayer) || ISDEAD(thing) || (thing == self))
-			{
-				continue; // ignore non player, or dead played, or self
-			}
-
-			// k_spw 2 and 3 and 4 feature, if player is spawned not far away and run
-			// around spot - treat this spot as not valid.
-			// k_1spawn store this "not far away" time.
-			// k_1spawn is _also_ set after player passed teleport
-			if (!(((k_spw == 2) || (k_spw == 3) || (k_spw == 4)) && (match_in_progress == 2)
-					&& (thing->k_1spawn < g_globalvars.time)))
-			{
-//				G_bprint(2, "ignore player: %s\n", thing->netname);
-				pcount++; // ignore spot
-			}
-		}
+		// is there any nearby player for 'spot'
+		pcount = (spawn_occupied[i] & blockers) ? 1 : 0;
 
 		// NOTE: k_spw != 4
 		if (!k_yawnmode && k_spw && (k_spw != 4) && (match_in_progress == 2)
@@ -1456,6 +1631,7 @@ qbool CanConnect(void)
 			{
 				// if player's team isn't what it was before, then he will be a "dead" player until the match is over
 				self->ca_ready = 0;
+				CA_TeamsChanged();
 
 				G_bprint(2, "%s entered the game\n", self->netname);
 			}
@@ -1469,6 +1645,7 @@ qbool CanConnect(void)
 				self->friendly = p->friendly;
 
 				self->ca_ready = isCa ? p->ca_ready : 0; // return to the game if playing clan arena
+				CA_TeamsChanged();
 
 				if (isCa && !self->ca_ready)
 				{
@@ -1738,6 +1915,8 @@ void PutClientInServer(void)
 
 	self->trackent = 0;
 
+	InvalidateBestPlayers();
+
 	self->ca_alive = (isCA() ? CA_CheckAlive(self) : true);
 	self->deathtype = dtNONE;
 	self->classname = "player";
@@ -2310,6 +2489,8 @@ void PutClientInServer(void)
 			self->super_time = 1;
 			self->super_damage_finished = g_globalvars.time + 3600;
 		}
+
+		LogEventSpawn(self);
 	}
 
 #ifdef BOT_SUPPORT
@@ -2822,6 +3003,7 @@ void ClientDisconnect(void)
 	extern void mv_stop_playback(void);
 
 	k_nochange = 0; // force recalculate frags scores
+	InvalidateBestPlayers();
 
 	if (!self->k_accepted)
 	{
@@ -4594,6 +4776,7 @@ void TookWeaponHandler(gedict_t *p, int new_wp, qbool from_backpack)
 		}
 
 		p->ps.wpn[wp].tooks++;
+		TimelineWeapon(p, wp);
 		adjust_pickup_time(&p->wp_pickup_time[wp], &p->ps.wpn[wp].time);
 		p->wp_pickup_time[wp] = g_globalvars.time;
 	}
@@ -4919,23 +5102,7 @@ void ClientObituary(gedict_t *targ, gedict_t *attacker)
 
 	victimname = targ->netname;
 
-	log_printf("\t\t<event>\n"
-				"\t\t\t<death>\n"
-				"\t\t\t\t<time>%f</time>\n"
-				"\t\t\t\t<attacker>%s</attacker>\n"
-				"\t\t\t\t<target>%s</target>\n"
-				"\t\t\t\t<type>%s</type>\n"
-				"\t\t\t\t<quad>%d</quad>\n"
-				"\t\t\t\t<armorleft>%d</armorleft>\n"
-				"\t\t\t\t<killheight>%d</killheight>\n"
-				"\t\t\t\t<lifetime>%f</lifetime>\n"
-				"\t\t\t</death>\n"
-				"\t\t</event>\n",
-				g_globalvars.time - match_start_time, cleantext(attackername),
-				cleantext(victimname), death_type(targ->deathtype),
-				(int)(attacker->super_damage_finished > g_globalvars.time ? 1 : 0),
-				(int)targ->s.v.armorvalue, (int)playerheight,
-				g_globalvars.time - targ->spawn_time);
+	LogEventDeath(attacker, attackername, targ, victimname, (int)playerheight);
 
 	if (isRA())
 	{
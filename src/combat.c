@@ -287,6 +287,7 @@ void Killed(gedict_t *targ, gedict_t *attacker, gedict_t *inflictor)
 		// for nightmare mode
 		self->monster_desired_spawn_time = (
 				resp_time ? g_globalvars.time + resp_time + resp_time * g_random() * 0.5 : 0);
+		monster_schedule_respawn(self);
 
 		g_globalvars.killed_monsters++;
 		WriteByte( MSG_ALL, SVC_KILLEDMONSTER);
@@ -840,22 +841,8 @@ void T_Damage(gedict_t *targ, gedict_t *inflictor, gedict_t *attacker, float dam
 		}
 		victimname = targ->netname;
 
-		log_printf("\t\t<event>\n"
-					"\t\t\t<damage>\n"
-					"\t\t\t\t<time>%f</time>\n"
-					"\t\t\t\t<attacker>%s</attacker>\n"
-					"\t\t\t\t<target>%s</target>\n"
-					"\t\t\t\t<type>%s</type>\n"
-					"\t\t\t\t<quad>%d</quad>\n"
-					"\t\t\t\t<splash>%d</splash>\n"
-					"\t\t\t\t<value>%d</value>\n"
-					"\t\t\t\t<armor>1</armor>\n"
-					"\t\t\t</damage>\n"
-					"\t\t</event>\n",
-					g_globalvars.time - match_start_time, cleantext(attackername),
-					cleantext(victimname), death_type(targ->deathtype),
-					(int)(attacker->super_damage_finished > g_globalvars.time ? 1 : 0),
-					dmg_is_splash, (int)save);
+		LogEventDamage(attacker, attackername, victimname, targ->deathtype, dmg_is_splash,
+						(int)save, true);
 	}
 
 	// figure momentum add
@@ -962,22 +949,8 @@ void T_Damage(gedict_t *targ, gedict_t *inflictor, gedict_t *attacker, float dam
 			}
 			victimname = targ->netname;
 
-			log_printf("\t\t<event>\n"
-						"\t\t\t<damage>\n"
-						"\t\t\t\t<time>%f</time>\n"
-						"\t\t\t\t<attacker>%s</attacker>\n"
-						"\t\t\t\t<target>%s</target>\n"
-						"\t\t\t\t<type>%s</type>\n"
-						"\t\t\t\t<quad>%d</quad>\n"
-						"\t\t\t\t<splash>%d</splash>\n"
-						"\t\t\t\t<value>%d</value>\n"
-						"\t\t\t\t<armor>0</armor>\n"
-						"\t\t\t</damage>\n"
-						"\t\t</event>\n",
-						g_globalvars.time - match_start_time, cleantext(attackername),
-						cleantext(victimname), death_type(targ->deathtype),
-						(int)(attacker->super_damage_finished > g_globalvars.time ? 1 : 0),
-						dmg_is_splash, (int)take);
+			LogEventDamage(attacker, attackername, victimname, targ->deathtype, dmg_is_splash,
+							(int)take, false);
 		}
 
 		if (!targ->s.v.health || (dtSUICIDE == targ->deathtype))
@@ -1067,6 +1040,7 @@ void T_Damage(gedict_t *targ, gedict_t *inflictor, gedict_t *attacker, float dam
 			{
 				attacker->ps.dmg_g += dmg_dealt;
 				targ->ps.dmg_t += dmg_dealt;
+				TimelineDamage(attacker, targ, dmg_dealt);
 				attacker->ps.wpn[weapon].edamage += dmg_dealt;
 
 				// damage to enemy weapon
@@ -1224,7 +1198,8 @@ void T_RadiusDamageApply(gedict_t *inflictor, gedict_t *attacker, gedict_t *head
 void T_RadiusDamage(gedict_t *inflictor, gedict_t *attacker, float damage, gedict_t *ignore,
 					deathType_t dtype)
 {
-	gedict_t *head;
+	gedict_t **list;
+	int i, count;
 
 	if (isRACE())
 	{
@@ -1235,17 +1210,17 @@ void T_RadiusDamage(gedict_t *inflictor, gedict_t *attacker, float damage, gedic
 		return;
 	}
 
-	head = trap_findradius(world, inflictor->s.v.origin, damage + 40);
+	count = G_FindRadius(inflictor->s.v.origin, damage + 40, SPATIAL_TAKEDAMAGE, NULL, &list);
 
-	while (head)
+	for (i = 0; i < count; i++)
 	{
-		if (head != ignore)
+		if (list[i] != ignore)
 		{
-			T_RadiusDamageApply(inflictor, attacker, head, damage, dtype);
+			T_RadiusDamageApply(inflictor, attacker, list[i], damage, dtype);
 		}
-
-		head = trap_findradius(head, inflictor->s.v.origin, damage + 40);
 	}
+
+	G_SpatialRelease(count);
 }
 
 /*
@@ -1258,11 +1233,15 @@ void T_BeamDamage(gedict_t *attacker, float damage)
 	vec3_t tmpv;
 	float points;
 	gedict_t *head;
+	gedict_t **list;
+	int i, count;
 
-	head = trap_findradius(world, attacker->s.v.origin, damage + 40);
+	count = G_FindRadius(attacker->s.v.origin, damage + 40, SPATIAL_TAKEDAMAGE, NULL, &list);
 
-	while (head)
+	for (i = 0; i < count; i++)
 	{
+		head = list[i];
+
 		if (head->s.v.takedamage)
 		{
 			VectorSubtract(attacker->s.v.origin, head->s.v.origin, tmpv)
@@ -1286,7 +1265,7 @@ void T_BeamDamage(gedict_t *attacker, float damage)
 				}
 			}
 		}
-
-		head = trap_findradius(head, attacker->s.v.origin, damage + 40);
 	}
+
+	G_SpatialRelease(count);
 }
@@ -88,6 +88,7 @@ void SendVictimMsg(void);
 void ShowNick(void);
 void ShowCmds(void);
 void ShowMaps(void);
+void MapPoolReloadCmd(void);
 //void ShowMessages(void);
 void ShowOpts(void);
 void ShowQizmo(void);
@@ -211,6 +212,8 @@ void no_gl(void);
 void mv_cmd_playback(void);
 void mv_cmd_record(void);
 void mv_cmd_stop(void);
+void mv_cmd_save(void);
+void mv_cmd_load(void);
 void callalias(void);
 void fcheck(void);
 void mapcycle(void);
@@ -253,6 +256,8 @@ void r_print(void);
 
 void race_display_line(void);
 void display_scores(void);
+void display_ranking(void);
+void display_personal_best(void);
 void display_record_details(void);
 void race_chasecam_change(void);
 void race_chasecam_freelook_change(void);
@@ -376,6 +381,7 @@ const char CD_NODESC[] = "no desc";
 #define CD_RULES			"show game rules"
 #define CD_LOCKMODE			"change locking mode"
 #define CD_MAPS				"list custom maps"
+#define CD_MAPPOOL_RELOAD	"reload map cycle from k_ml_* settings"
 #define CD_ADMIN			"toggle admin-mode"
 #define CD_FORCESTART		"force match to start"
 #define CD_FORCEBREAK		"force match to end"
@@ -597,11 +603,14 @@ const char CD_NODESC[] = "no desc";
 #define CD_TRX_REC			"trick tmp record"
 #define CD_TRX_PLAY			"trick tmp playback"
 #define CD_TRX_STOP			"stop playback/recording"
+#define CD_TRX_SAVE			"save trick record to file"
+#define CD_TRX_LOAD			"load trick record from file"
 // }
 #define CD_CALLALIAS		"call alias after few secs"
 #define CD_CHECK			"better f_checks handle"
 #define CD_NEXT_MAP			"vote for next map"
 #define CD_MAPCYCLE			"list map cycle"
+#define CD_FXSTATS			"effect entity pool usage"
 #define CD_YAWNMODE			"toggle yawnmode"
 #define CD_FALLBUNNYCAP		"set fallbunny cap (yawn)"
 #define CD_TELEPORTCAP		"set teleport cap (yawn)"
@@ -636,6 +645,8 @@ const char CD_NODESC[] = "no desc";
 #define CD_RLINEUP			"show current race line-up"
 #define CD_RSCORES			"show top race times for current map"
 #define CD_RSCOREDETAIL		"show details about a record"
+#define CD_RRANKING			"show full race ranking"
+#define CD_RPERSONALBEST	"show personal best and rank"
 #define CD_RDLDEMO			"download demo for a record"
 #define CD_RPACEMAKER		"set pacemaker"
 #define CD_RSIMULMODE		"toggle simultaneous racing"
@@ -738,6 +749,7 @@ cmd_t cmds[] =
 	{ "rules", 						ShowRules, 						0, 			CF_PLAYER | CF_MATCHLESS, 												CD_RULES },
 	{ "lockmode", 					ChangeLock, 					0, 			CF_PLAYER | CF_SPC_ADMIN, 												CD_LOCKMODE },
 	{ "maps", 						ShowMaps, 						0, 			CF_BOTH | CF_MATCHLESS | CF_PARAMS, 									CD_MAPS },
+	{ "mappool_reload", 			MapPoolReloadCmd, 				0, 			CF_BOTH_ADMIN | CF_MATCHLESS, 											CD_MAPPOOL_RELOAD },
 	{ "admin", 						ReqAdmin, 						0, 			CF_BOTH | CF_MATCHLESS | CF_PARAMS, 									CD_ADMIN },
 	{ "forcestart", 				AdminForceStart, 				0, 			CF_BOTH_ADMIN, 															CD_FORCESTART },
 	{ "forcebreak", 				AdminForceBreak, 				0, 			CF_BOTH_ADMIN, 															CD_FORCEBREAK },
@@ -976,13 +988,16 @@ cmd_t cmds[] =
 	{ "no_gl", 						no_gl, 							0, 			CF_PLAYER | CF_SPC_ADMIN, 												CD_NO_GL },
 	// {
 	{ "trx_rec", 					mv_cmd_record, 					0, 			CF_PLAYER, 																CD_TRX_REC },
-	{ "trx_play", 					mv_cmd_playback, 				0, 			CF_PLAYER, 																CD_TRX_PLAY },
+	{ "trx_play", 					mv_cmd_playback, 				0, 			CF_PLAYER | CF_PARAMS, 													CD_TRX_PLAY },
 	{ "trx_stop", 					mv_cmd_stop, 					0, 			CF_PLAYER, 																CD_TRX_STOP },
+	{ "trx_save", 					mv_cmd_save, 					0, 			CF_PLAYER | CF_PARAMS, 													CD_TRX_SAVE },
+	{ "trx_load", 					mv_cmd_load, 					0, 			CF_PLAYER | CF_PARAMS, 													CD_TRX_LOAD },
 	// }
 	{ "callalias", 					callalias, 						0, 			CF_BOTH | CF_MATCHLESS | CF_PARAMS, 									CD_CALLALIAS },
 	{ "check", 						fcheck, 						0, 			CF_BOTH | CF_PARAMS, 													CD_CHECK },
 	{ "next_map", 					PlayerBreak, 					0, 			CF_PLAYER | CF_MATCHLESS_ONLY, 											CD_NEXT_MAP },
 	{ "mapcycle", 					mapcycle, 						0, 			CF_BOTH | CF_MATCHLESS, 												CD_MAPCYCLE },
+	{ "fxstats", 					FxStats, 						0, 			CF_BOTH | CF_MATCHLESS, 												CD_FXSTATS },
 	{ "yawnmode", 					ToggleYawnMode, 				0, 			CF_PLAYER | CF_SPC_ADMIN, 												CD_YAWNMODE },
 	{ "teleportcap", 				setTeleportCap, 				0, 			CF_PLAYER | CF_SPC_ADMIN | CF_PARAMS, 									CD_TELEPORTCAP },
 	{ "airstep", 					airstep, 						0, 			CF_PLAYER | CF_SPC_ADMIN, 												CD_AIRSTEP },
@@ -998,6 +1013,8 @@ cmd_t cmds[] =
 	{ "race_show_lineup", 			race_display_line, 				0, 			CF_BOTH, 																CD_RLINEUP },
 	{ "race_show_toptimes", 		display_scores, 				0, 			CF_BOTH, 																CD_RSCORES },
 	{ "race_show_record_details", 	display_record_details, 		0, 			CF_BOTH | CF_PARAMS, 													CD_RSCOREDETAIL },
+	{ "race_show_ranking", 			display_ranking, 				0, 			CF_BOTH | CF_PARAMS, 													CD_RRANKING },
+	{ "race_show_personal_best", 	display_personal_best, 			0, 			CF_BOTH | CF_PARAMS, 													CD_RPERSONALBEST },
 	{ "race_show_route", 			r_print, 						0, 			CF_BOTH, 																CD_R_PRINT },
 	{ "race_set_start", 			DEF(r_Xset), 					1, 			CF_PLAYER | CF_SPC_ADMIN, 												CD_R_SSET },
 	{ "race_set_finish", 			DEF(r_Xset), 					3, 			CF_PLAYER | CF_SPC_ADMIN, 												CD_R_ESET },
@@ -6007,6 +6024,8 @@ void ktpro_autotrack_on_death(gedict_t *dude)
 	gedict_t *p;
 	int goal = EDICT_TO_PROG(dude); // so we can compare with ->s.v.goal
 
+	InvalidateBestPlayers();
+
 	if (dude == autotrack_last)
 	{
 		autotrack_update = true; // this is for mvd autotrack
@@ -6051,6 +6070,8 @@ void ktpro_autotrack_on_powerup_take(gedict_t *dude)
 // some powerup out, and he has neither the rocket launcher nor the lightning gun, mark specs to switch pov to best player
 void ktpro_autotrack_on_powerup_out(gedict_t *dude)
 {
+	InvalidateBestPlayers();
+
 	/* qqshka: I turned this out, because sassa think its correct, lets test it...
 
 	 gedict_t *p;
@@ -7952,10 +7973,234 @@ void dmgfrags(void)
 
 // { movie, for trix record in memory
 // code is partially wroten by Tonik
+// frames are stored as changes to the previous frame, every MV_KEYFRAME_EVERY frame in full
+
+#define MVF_TIME_ABS		(1<<0)
+#define MVF_ORIGIN_DELTA	(1<<1)
+#define MVF_ORIGIN_ABS		(1<<2)
+#define MVF_PITCH			(1<<3)
+#define MVF_YAW				(1<<4)
+#define MVF_ROLL			(1<<5)
+#define MVF_FRAME			(1<<6)
+#define MVF_EFFECTS			(1<<7)
+#define MVF_COLORMAP		(1<<8)
+#define MVF_KEYFRAME		(MVF_TIME_ABS | MVF_ORIGIN_ABS | MVF_PITCH | MVF_YAW | MVF_ROLL | MVF_FRAME | MVF_EFFECTS | MVF_COLORMAP)
+
+#define MV_FILE_VERSION		1
+
+typedef struct
+{
+	char magic[4];
+	int version;
+	int frames;
+	int size;
+	int keyframes_cnt;
+} mv_file_header_t;
 
 void mv_stop_record(void);
 qbool mv_is_recording(void);
 
+static void mv_put(mv_movie_t *mv, int value, int bytes)
+{
+	while (bytes--)
+	{
+		mv->data[mv->size++] = value & 0xFF;
+		value >>= 8;
+	}
+}
+
+static int mv_get(mv_movie_t *mv, int *offset, int bytes)
+{
+	unsigned int value = 0;
+	int i;
+
+	for (i = 0; (i < bytes) && (*offset < MV_DATA_SIZE); i++)
+	{
+		value |= (unsigned int)mv->data[(*offset)++] << (8 * i);
+	}
+
+	// sign extend
+	if (bytes < 4)
+	{
+		return (int)(value ^ (1u << (8 * bytes - 1))) - (1 << (8 * bytes - 1));
+	}
+
+	return (int)value;
+}
+
+static void mv_encode(mv_movie_t *mv, plrfrm_t *f, qbool key)
+{
+	plrfrm_t *last = &mv->last;
+	int mask = 0, d[3], i;
+
+	if (key)
+	{
+		mask = MVF_KEYFRAME;
+	}
+	else
+	{
+		for (i = 0; i < 3; i++)
+		{
+			d[i] = f->origin[i] - last->origin[i];
+		}
+
+		if ((f->time - last->time) > 127)
+		{
+			mask |= MVF_TIME_ABS;
+		}
+
+		if (d[0] || d[1] || d[2])
+		{
+			mask |= (d[0] == (signed char)d[0]) && (d[1] == (signed char)d[1])
+					&& (d[2] == (signed char)d[2]) ? MVF_ORIGIN_DELTA : MVF_ORIGIN_ABS;
+		}
+
+		mask |= (f->angles[0] != last->angles[0]) ? MVF_PITCH : 0;
+		mask |= (f->angles[1] != last->angles[1]) ? MVF_YAW : 0;
+		mask |= (f->angles[2] != last->angles[2]) ? MVF_ROLL : 0;
+		mask |= (f->frame != last->frame) ? MVF_FRAME : 0;
+		mask |= (f->effects != last->effects) ? MVF_EFFECTS : 0;
+		mask |= (f->colormap != last->colormap) ? MVF_COLORMAP : 0;
+	}
+
+	mv_put(mv, mask, 2);
+	mv_put(mv, (mask & MVF_TIME_ABS) ? f->time : f->time - last->time, (mask & MVF_TIME_ABS) ? 4 : 1);
+
+	for (i = 0; i < 3; i++)
+	{
+		if (mask & MVF_ORIGIN_ABS)
+		{
+			mv_put(mv, f->origin[i], 4);
+		}
+		else if (mask & MVF_ORIGIN_DELTA)
+		{
+			mv_put(mv, d[i], 1);
+		}
+	}
+
+	for (i = 0; i < 3; i++)
+	{
+		if (mask & (MVF_PITCH << i))
+		{
+			mv_put(mv, f->angles[i], 2);
+		}
+	}
+
+	if (mask & MVF_FRAME)
+	{
+		mv_put(mv, f->frame, 1);
+	}
+
+	if (mask & MVF_EFFECTS)
+	{
+		mv_put(mv, f->effects, 2);
+	}
+
+	if (mask & MVF_COLORMAP)
+	{
+		mv_put(mv, f->colormap, 1);
+	}
+
+	*last = *f;
+}
+
+// decode frame at offset on top of f
+static void mv_decode(mv_movie_t *mv, int *offset, plrfrm_t *f)
+{
+	int mask = mv_get(mv, offset, 2) & 0xFFFF;
+	int i;
+
+	if (mask & MVF_TIME_ABS)
+	{
+		f->time = mv_get(mv, offset, 4);
+	}
+	else
+	{
+		f->time += mv_get(mv, offset, 1);
+	}
+
+	for (i = 0; i < 3; i++)
+	{
+		if (mask & MVF_ORIGIN_ABS)
+		{
+			f->origin[i] = mv_get(mv, offset, 4);
+		}
+		else if (mask & MVF_ORIGIN_DELTA)
+		{
+			f->origin[i] += mv_get(mv, offset, 1);
+		}
+	}
+
+	for (i = 0; i < 3; i++)
+	{
+		if (mask & (MVF_PITCH << i))
+		{
+			f->angles[i] = mv_get(mv, offset, 2) & 0xFFFF;
+		}
+	}
+
+	if (mask & MVF_FRAME)
+	{
+		f->frame = mv_get(mv, offset, 1) & 0xFF;
+	}
+
+	if (mask & MVF_EFFECTS)
+	{
+		f->effects = mv_get(mv, offset, 2) & 0xFFFF;
+	}
+
+	if (mask & MVF_COLORMAP)
+	{
+		f->colormap = mv_get(mv, offset, 1) & 0xFF;
+	}
+}
+
+// position playback on the last frame at or before time (ms)
+static void mv_seek(mv_movie_t *mv, int time)
+{
+	plrfrm_t f;
+	int i, offset;
+
+	for (i = mv->keyframes_cnt - 1; (i > 0) && (mv->keyframes[i].time > time); i--)
+	{
+	}
+
+	self->pb_frame = mv->keyframes[i].frame;
+	mv->pb_offset = mv->keyframes[i].offset;
+	memset(&mv->pb, 0, sizeof(mv->pb));
+	mv_decode(mv, &mv->pb_offset, &mv->pb);
+
+	while (self->pb_frame + 1 < mv->frames)
+	{
+		f = mv->pb;
+		offset = mv->pb_offset;
+		mv_decode(mv, &offset, &f);
+		if (f.time > time)
+		{
+			break;
+		}
+
+		mv->pb = f;
+		mv->pb_offset = offset;
+		self->pb_frame++;
+	}
+}
+
+static void mv_apply(gedict_t *pb_ent, plrfrm_t *f)
+{
+	int i;
+
+	setorigin(pb_ent, f->origin[0] / 8.0f, f->origin[1] / 8.0f, f->origin[2] / 8.0f);
+	for (i = 0; i < 3; i++)
+	{
+		pb_ent->s.v.angles[i] = f->angles[i] * (360.0f / 65536);
+	}
+
+	pb_ent->s.v.frame = f->frame;
+	pb_ent->s.v.effects = f->effects;
+	pb_ent->s.v.colormap = f->colormap;
+}
+
 qbool mv_is_playback(void)
 {
 	return self->is_playback;
@@ -7991,7 +8236,7 @@ qbool mv_can_playback(void)
 		return false; // sanity
 	}
 
-	if ((self->pb_frame >= self->rec_count) || (self->pb_frame < 0))
+	if ((self->pb_frame >= self->movie->frames) || (self->pb_frame < 0))
 	{
 		return false;
 	}
@@ -8002,16 +8247,17 @@ qbool mv_can_playback(void)
 void mv_playback(void)
 {
 	gedict_t *pb_ent = self->pb_ent;
+	mv_movie_t *mv = self->movie;
 	float scale;
-	int s, i;
-	plrfrm_t *ftmp, *fp;
+	int s, offset, played = self->pb_frame;
+	plrfrm_t f;
 
 	if (!mv_is_playback())
 	{
 		return;
 	}
 
-	if (!pb_ent || !mv_can_playback() || (self->pb_frame == (self->rec_count - 1)))
+	if (!pb_ent || !mv_can_playback() || (self->pb_frame == (mv->frames - 1)))
 	{
 		mv_stop_playback();
 
@@ -8023,37 +8269,33 @@ void mv_playback(void)
 	self->pb_time += (g_globalvars.time - self->pb_old_time) * scale;
 	self->pb_old_time = g_globalvars.time;
 
-	fp = ftmp = &(self->plrfrms[self->pb_frame]);
-
-	for (i = self->pb_frame + 1; i < self->rec_count; i++)
+	while (self->pb_frame + 1 < mv->frames)
 	{
-		ftmp = &(self->plrfrms[i]);
-		if (ftmp->time > self->pb_time)
+		f = mv->pb;
+		offset = mv->pb_offset;
+		mv_decode(mv, &offset, &f);
+		if (f.time > self->pb_time * 1000)
 		{
 			break;
 		}
 
-		fp = ftmp;
+		mv->pb = f;
+		mv->pb_offset = offset;
+		self->pb_frame++;
 	}
 
-	i = fp - self->plrfrms;
-
-	if ((i == self->pb_frame) || (fp->time > self->pb_time))
+	if (self->pb_frame != played)
 	{
-		return;
+		mv_apply(pb_ent, &mv->pb);
 	}
-
-	self->pb_frame = i;
-
-	setorigin(pb_ent, PASSVEC3(fp->origin));
-	VectorCopy(fp->angles, pb_ent->s.v.angles);
-	pb_ent->s.v.frame = fp->frame;
-	pb_ent->s.v.effects = fp->effects;
-	pb_ent->s.v.colormap = fp->colormap;
 }
 
+// /cmd trx_play [seconds]
 void mv_cmd_playback(void)
 {
+	char arg_1[64];
+	float start = 0;
+
 	mv_stop_record();	// stop record first
 	mv_stop_playback();	// stop playback first
 
@@ -8066,13 +8308,22 @@ void mv_cmd_playback(void)
 		return;
 	}
 
+	if (trap_CmdArgc() >= 2)
+	{
+		trap_CmdArgv(1, arg_1, sizeof(arg_1));
+		start = max(0, atof(arg_1));
+	}
+
+	mv_seek(self->movie, start * 1000);
+
 	G_sprint(self, 2, "playback\n");
 
 	self->pb_ent = spawn();
 	self->pb_ent->classname = "pb_ent";
 	setmodel(self->pb_ent, "progs/player.mdl");
+	mv_apply(self->pb_ent, &self->movie->pb);
 
-	self->pb_time = 0;
+	self->pb_time = start;
 	self->pb_old_time = g_globalvars.time;
 	self->is_playback = true;
 }
@@ -8089,7 +8340,8 @@ void mv_stop_record(void)
 		return;
 	}
 
-	G_sprint(self, 2, "recording finished (%d) frames\n", self->rec_count);
+	G_sprint(self, 2, "recording finished (%d) frames, %d bytes\n", self->movie->frames,
+				self->movie->size);
 
 	self->is_recording = false;
 }
@@ -8106,7 +8358,8 @@ qbool mv_can_record(void)
 		return false; // sanity
 	}
 
-	if ((self->rec_count >= MAX_PLRFRMS) || (self->rec_count < 0))
+	if ((self->movie->size + MV_FRAME_MAX_SIZE > MV_DATA_SIZE)
+			|| (self->movie->keyframes_cnt >= MV_MAX_KEYFRAMES))
 	{
 		return false;
 	}
@@ -8116,7 +8369,9 @@ qbool mv_can_record(void)
 
 void mv_record(void)
 {
-	plrfrm_t *f;
+	mv_movie_t *mv = self->movie;
+	plrfrm_t f;
+	int i;
 
 	if (!mv_is_recording())
 	{
@@ -8130,18 +8385,27 @@ void mv_record(void)
 		return;
 	}
 
-	f = &(self->plrfrms[self->rec_count]);
+	f.time = Q_rint((g_globalvars.time - self->rec_start_time) * 1000);
+	for (i = 0; i < 3; i++)
+	{
+		f.origin[i] = Q_rint(self->s.v.origin[i] * 8);
+		f.angles[i] = Q_rint(anglemod(self->s.v.angles[i]) * (65536 / 360.0f)) & 0xFFFF;
+	}
+
+	f.frame = (int)self->s.v.frame & 0xFF;
+	f.effects = (int)self->s.v.effects & 0xFFFF;
+	f.colormap = (int)self->s.v.colormap & 0xFF;
 
-	f->time = g_globalvars.time - self->rec_start_time;
-	VectorCopy(self->s.v.origin, f->origin);
-	VectorCopy(self->s.v.angles, f->angles);
-//	VectorCopy(self->s.v.v_angle, f->v_angle); // FIXME: usefull ?
-	f->frame = self->s.v.frame;
-	f->effects = self->s.v.effects;
-	f->colormap = self->s.v.colormap;
-//	f->s.v.modelindex = self.modelindex;
+	if (!(mv->frames % MV_KEYFRAME_EVERY))
+	{
+		mv->keyframes[mv->keyframes_cnt].frame = mv->frames;
+		mv->keyframes[mv->keyframes_cnt].time = f.time;
+		mv->keyframes[mv->keyframes_cnt].offset = mv->size;
+		mv->keyframes_cnt++;
+	}
 
-	self->rec_count++;
+	mv_encode(mv, &f, !(mv->frames % MV_KEYFRAME_EVERY));
+	mv->frames++;
 }
 
 void mv_cmd_record(void)
@@ -8149,7 +8413,7 @@ void mv_cmd_record(void)
 	mv_stop_record();	// stop record first
 	mv_stop_playback();	// stop playback first
 
-	self->rec_count = 0;
+	self->movie->frames = self->movie->size = self->movie->keyframes_cnt = 0;
 
 	if (!mv_can_record())
 	{
@@ -8170,6 +8434,129 @@ void mv_cmd_stop(void)
 	mv_stop_playback();	// stop playback
 }
 
+static char* mv_file_name(void)
+{
+	static char name[128];
+	char arg_1[64];
+
+	if (trap_CmdArgc() >= 2)
+	{
+		trap_CmdArgv(1, arg_1, sizeof(arg_1));
+	}
+	else
+	{
+		strlcpy(arg_1, self->netname, sizeof(arg_1));
+	}
+
+	snprintf(name, sizeof(name), "trx/%s.trx", clean_string(arg_1));
+
+	return name;
+}
+
+// /cmd trx_save [name]
+void mv_cmd_save(void)
+{
+	mv_movie_t *mv = self->movie;
+	mv_file_header_t header;
+	fileHandle_t handle;
+	char *name;
+
+	if (!cvar("k_trx_save"))
+	{
+		G_sprint(self, 2, "saving tricks is disabled on this server\n");
+
+		return;
+	}
+
+	mv_cmd_stop();
+
+	if (!mv->frames)
+	{
+		G_sprint(self, 2, "nothing recorded\n");
+
+		return;
+	}
+
+	name = mv_file_name();
+	if (trap_FS_OpenFile(name, &handle, FS_WRITE_BIN) < 0)
+	{
+		G_sprint(self, 2, "can't write %s\n", name);
+
+		return;
+	}
+
+	memcpy(header.magic, "KTRX", 4);
+	header.version = MV_FILE_VERSION;
+	header.frames = mv->frames;
+	header.size = mv->size;
+	header.keyframes_cnt = mv->keyframes_cnt;
+
+	trap_FS_WriteFile((char*)&header, sizeof(header), handle);
+	trap_FS_WriteFile((char*)mv->keyframes, sizeof(mv->keyframes[0]) * mv->keyframes_cnt, handle);
+	trap_FS_WriteFile((char*)mv->data, mv->size, handle);
+	trap_FS_CloseFile(handle);
+
+	G_sprint(self, 2, "saved %s (%d frames)\n", name, mv->frames);
+}
+
+// /cmd trx_load [name]
+void mv_cmd_load(void)
+{
+	mv_movie_t *mv = self->movie;
+	mv_file_header_t header;
+	fileHandle_t handle;
+	qbool valid;
+	char *name;
+
+	mv_cmd_stop();
+
+	name = mv_file_name();
+	if (trap_FS_OpenFile(name, &handle, FS_READ_BIN) < 0)
+	{
+		G_sprint(self, 2, "can't read %s\n", name);
+
+		return;
+	}
+
+	valid = (trap_FS_ReadFile((char*)&header, sizeof(header), handle) == sizeof(header))
+			&& !memcmp(header.magic, "KTRX", 4) && (header.version == MV_FILE_VERSION)
+			&& (header.size > 0) && (header.size <= MV_DATA_SIZE) && (header.frames > 0)
+			&& (header.keyframes_cnt > 0) && (header.keyframes_cnt <= MV_MAX_KEYFRAMES)
+			&& (header.keyframes_cnt == (header.frames + MV_KEYFRAME_EVERY - 1) / MV_KEYFRAME_EVERY);
+
+	mv->frames = mv->size = mv->keyframes_cnt = 0;
+
+	if (valid)
+	{
+		int keyframes_size = sizeof(mv->keyframes[0]) * header.keyframes_cnt;
+		int i;
+
+		valid = (trap_FS_ReadFile((char*)mv->keyframes, keyframes_size, handle) == keyframes_size)
+				&& (trap_FS_ReadFile((char*)mv->data, header.size, handle) == header.size);
+
+		for (i = 0; valid && (i < header.keyframes_cnt); i++)
+		{
+			valid = (mv->keyframes[i].frame == i * MV_KEYFRAME_EVERY) && (mv->keyframes[i].offset >= 0)
+					&& (mv->keyframes[i].offset < header.size);
+		}
+	}
+
+	trap_FS_CloseFile(handle);
+
+	if (!valid)
+	{
+		G_sprint(self, 2, "%s is not a valid trick\n", name);
+
+		return;
+	}
+
+	mv->frames = header.frames;
+	mv->size = header.size;
+	mv->keyframes_cnt = header.keyframes_cnt;
+
+	G_sprint(self, 2, "loaded %s (%d frames)\n", name, mv->frames);
+}
+
 // }
 
 // ktpro (c)
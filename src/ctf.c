@@ -875,6 +875,8 @@ void CTF_Obituary(gedict_t *targ, gedict_t *attacker)
 	qbool carrier_bonus = false;
 	qbool flagdefended = false;
 	gedict_t *head;
+	gedict_t **list;
+	int i, count;
 	char *attackerteam;
 
 	if (!isCTF())
@@ -907,9 +909,11 @@ void CTF_Obituary(gedict_t *targ, gedict_t *attacker)
 					streq(getteam(attacker), "red") ? redtext("RED") : redtext("BLUE"));
 	}
 
-	head = trap_findradius(world, targ->s.v.origin, 400);
-	while (head)
+	count = G_FindRadius(targ->s.v.origin, 400, 0, NULL, &list);
+	for (i = 0; i < count; i++)
 	{
+		head = list[i];
+
 		if (head->ct == ctPlayer)
 		{
 			if ((head->ctf_flag & CTF_FLAG) && (head != attacker)
@@ -933,14 +937,16 @@ void CTF_Obituary(gedict_t *targ, gedict_t *attacker)
 			G_bprint(2, "%s defends the %s flag\n", attacker->netname,
 						streq(getteam(attacker), "red") ? redtext("RED") : redtext("BLUE"));
 		}
-
-		head = trap_findradius(head, targ->s.v.origin, 400);
 	}
 
+	G_SpatialRelease(count);
+
 	// Defend bonus if attacker is close to flag even if target is not
-	head = trap_findradius(world, attacker->s.v.origin, 400);
-	while (head)
+	count = G_FindRadius(attacker->s.v.origin, 400, 0, NULL, &list);
+	for (i = 0; i < count; i++)
 	{
+		head = list[i];
+
 		if ((streq(head->classname, "item_flag_team1") && streq(attackerteam, "red"))
 				|| (streq(head->classname, "item_flag_team2") && streq(attackerteam, "blue")))
 		{
@@ -953,6 +959,7 @@ void CTF_Obituary(gedict_t *targ, gedict_t *attacker)
 							streq(attackerteam, "red") ? redtext("RED") : redtext("BLUE"));
 			}
 		}
-		head = trap_findradius(head, attacker->s.v.origin, 400);
 	}
+
+	G_SpatialRelease(count);
 }
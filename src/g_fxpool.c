@@ -0,0 +1,161 @@
+//
+// g_fxpool.c - recycled edicts for short lived cosmetic entities
+//
+// Gibs, meat spray, bubbles and the like are taken from a pool instead of trap_spawn().
+// When one is removed (ent_remove, SUB_Remove) it is hidden and kept for the next effect.
+// k_fx_budget caps the pool size. Once it is reached and no hidden edict is old enough to
+// reuse, FxSpawn() returns NULL and the effect is skipped, so an effect storm can't use up
+// the edicts the game itself needs. A live effect is never taken over, it may be the self of
+// the think asking for a new one. 0 turns pooling off, lowering it takes effect on the next map.
+//
+
+#include "g_local.h"
+
+#define FX_MAX			256
+#define FX_REUSE_DELAY	0.5			// engine waits as long before reusing an edict, clients lerp it otherwise
+
+static int fx_ent[FX_MAX];			// edict numbers
+static qbool fx_live[FX_MAX];
+static float fx_free_time[FX_MAX];
+static int fx_slot[MAX_EDICTS];		// pool index + 1, 0 = not pooled
+static int fx_count;
+static int fx_live_count;
+
+static int fx_high;					// most effects alive at once
+static int fx_spawned;
+static int fx_recycled;
+static int fx_skipped;
+
+void FxReset(void)
+{
+	memset(fx_slot, 0, sizeof(fx_slot));
+	fx_count = fx_live_count = 0;
+	fx_high = fx_spawned = fx_recycled = fx_skipped = 0;
+}
+
+static int FxBudget(void)
+{
+	return (int)bound(0, cvar("k_fx_budget"), FX_MAX);
+}
+
+static void FxSetLive(int i)
+{
+	fx_live[i] = true;
+	fx_live_count++;
+	if (fx_live_count > fx_high)
+	{
+		fx_high = fx_live_count;
+	}
+}
+
+// hidden effect freed longest ago, at least delay seconds ago
+static int FxHidden(float delay)
+{
+	int i, best = -1;
+
+	for (i = 0; i < fx_count; i++)
+	{
+		if (fx_live[i] || (g_globalvars.time - fx_free_time[i] < delay))
+		{
+			continue;
+		}
+
+		if ((best < 0) || (fx_free_time[i] < fx_free_time[best]))
+		{
+			best = i;
+		}
+	}
+
+	return best;
+}
+
+// same state spawn() hands out
+static gedict_t* FxTake(int i)
+{
+	gedict_t *e = &g_edicts[fx_ent[i]];
+
+	memset(e, 0, sizeof(gedict_t));
+	e->spawn_time = g_globalvars.time;
+	initialise_spawned_ent(e);
+	G_SpatialSpawn(e);
+	FxSetLive(i);
+	fx_recycled++;
+
+	return e;
+}
+
+// Entity for a short lived effect, use it like one from spawn(), or NULL when the budget is
+// used up and the effect should be skipped. It must end with ent_remove() or SUB_Remove.
+gedict_t* FxSpawn(void)
+{
+	int budget = FxBudget();
+	gedict_t *e;
+	int i;
+
+	if (!budget)
+	{
+		return spawn();
+	}
+
+	i = FxHidden(FX_REUSE_DELAY);
+	if (i >= 0)
+	{
+		return FxTake(i);
+	}
+
+	if (fx_count < budget)
+	{
+		e = spawn();
+		fx_ent[fx_count] = NUM_FOR_EDICT(e);
+		fx_slot[fx_ent[fx_count]] = fx_count + 1;
+		FxSetLive(fx_count);
+		fx_count++;
+		fx_spawned++;
+
+		return e;
+	}
+
+	fx_skipped++;
+
+	return NULL;
+}
+
+// Called by ent_remove(), hides a pooled effect instead of freeing the edict
+qbool FxRelease(gedict_t *e)
+{
+	int i = fx_slot[NUM_FOR_EDICT(e)] - 1;
+
+	if (i < 0)
+	{
+		return false;
+	}
+
+	if (fx_live[i])
+	{
+		fx_live[i] = false;
+		fx_live_count--;
+		fx_free_time[i] = g_globalvars.time;
+	}
+
+	e->classname = "fx_free";
+	e->model = "";
+	e->s.v.modelindex = 0;
+	e->s.v.effects = 0;
+	e->s.v.solid = SOLID_NOT;
+	e->s.v.movetype = MOVETYPE_NONE;
+	VectorClear(e->s.v.velocity);
+	VectorClear(e->s.v.avelocity);
+	e->s.v.nextthink = 0;
+	e->think = (func_t) SUB_Null;
+	e->touch = (func_t) SUB_Null;
+	e->isMissile = false;
+
+	return true;
+}
+
+void FxStats(void)
+{
+	G_sprint(self, 2, "%s: %d/%d alive, pool %d, budget %d\n", redtext("effects"), fx_live_count,
+				fx_high, fx_count, FxBudget());
+	G_sprint(self, 2, "spawned %d, recycled %d, skipped %d\n", fx_spawned, fx_recycled, fx_skipped);
+}
@@ -79,7 +79,7 @@ static char callalias_buf[MAX_CLIENTS][CALLALIAS_SIZE];
 static char f_checks[MAX_CLIENTS][F_CHECK_SIZE];
 
 static wreg_t wregs[MAX_CLIENTS][MAX_WREGS];
-static plrfrm_t plrfrms[MAX_CLIENTS][MAX_PLRFRMS];
+static mv_movie_t movies[MAX_CLIENTS];
 
 gameData_t gamedata =
 	{ (edict_t*) g_edicts, sizeof(gedict_t), &g_globalvars, expfields,
@@ -206,10 +206,10 @@ intptr_t VISIBILITY_VISIBLE vmMain(
 			self->k_msgcount = g_globalvars.time;
 
 			self->wreg = wregs[(int)(self - world) - 1];
-			self->plrfrms = plrfrms[(int)(self - world) - 1];
+			self->movie = &movies[(int)(self - world) - 1];
 
 			memset(self->wreg, 0, sizeof(wreg_t) * MAX_WREGS);     // clear
-			memset(self->plrfrms, 0, sizeof(plrfrm_t) * MAX_PLRFRMS); // clear
+			self->movie->frames = self->movie->size = self->movie->keyframes_cnt = 0; // clear
 
 			self->callalias = callalias_buf[(int)(self - world) - 1];
 			self->callalias[0] = 0;
@@ -481,12 +481,20 @@ void G_InitGame(int levelTime, int randomSeed)
 	starttime = levelTime * 0.001;
 	G_Printf("Init Game\n");
 	G_InitMemory();
+	G_InitSpawnRegistry();
 	memset(g_edicts, 0, sizeof(gedict_t) * MAX_EDICTS);
+	G_SpatialReset();
+	G_TimersReset();
+	FxReset();
+	TimelineReset();
+	SpawnSlotsReset();
+	CA_TeamsChanged();
 	for ( i = 0; i < MAX_CLIENTS; i++ ) {
 		g_edicts[i + 1].netname = netnames[i];
 	}
 
 	GetMapList();
+	MapPoolReset();
 
 	ra_init_que();
 
@@ -494,6 +502,8 @@ void G_InitGame(int levelTime, int randomSeed)
 
 	race_init();
 
+	InvalidateBestPlayers();
+
 	// put mod version in serverinfo
 	localcmd("serverinfo \"%s\" \"%s\"\n", MOD_SERVERINFO_MOD_KEY, MOD_VERSION);
 
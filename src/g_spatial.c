@@ -0,0 +1,334 @@
+//
+// g_spatial.c - uniform grid over g_edicts for mod side radius and box queries
+//
+// Entities are kept in the bucket of the grid cell their bbox center is in (same center as
+// trap_findradius uses). setorigin/setsize/setmodel and the movement wrappers relink entity
+// at once, the rest of the movement is picked up by the sweep at the start of each frame.
+// Queries are widened by how far anything could have moved since that sweep.
+//
+
+#include "g_local.h"
+
+#define SPATIAL_CELL		256
+#define SPATIAL_BUCKETS		1024					// must be power of two
+#define SPATIAL_UNPLACED	SPATIAL_BUCKETS			// spawned since the last sweep, origin not known yet
+#define SPATIAL_SLACK		64						// moves we are not told about: walk steps, small origin nudges
+#define SPATIAL_RESULTS		(MAX_EDICTS * 4)		// shared by nested queries
+
+static int spatial_head[SPATIAL_BUCKETS + 1];		// edict number, 0 = empty
+static int spatial_next[MAX_EDICTS];
+static int spatial_prev[MAX_EDICTS];
+static int spatial_bucket[MAX_EDICTS];				// -1 = not tracked
+static int spatial_visit[SPATIAL_BUCKETS];			// query which already scanned the bucket
+static int spatial_query;
+static float spatial_pad;
+static float spatial_extent;						// half size of the biggest thing which took damage
+
+static gedict_t *spatial_results[SPATIAL_RESULTS];
+static int spatial_results_cnt;
+
+static int SpatialCell(float v)
+{
+	int c = (int)(v / SPATIAL_CELL);
+
+	return ((v < 0) && (c * SPATIAL_CELL != v)) ? c - 1 : c;
+}
+
+static int SpatialBucket(int cx, int cy)
+{
+	return ((cx * 73856093) ^ (cy * 19349663)) & (SPATIAL_BUCKETS - 1);
+}
+
+static void SpatialCenter(gedict_t *e, vec3_t center)
+{
+	VectorAdd(e->s.v.mins, e->s.v.maxs, center);
+	VectorMA(e->s.v.origin, 0.5, center, center);
+}
+
+static void SpatialRemove(int n)
+{
+	if (spatial_prev[n])
+	{
+		spatial_next[spatial_prev[n]] = spatial_next[n];
+	}
+	else
+	{
+		spatial_head[spatial_bucket[n]] = spatial_next[n];
+	}
+
+	if (spatial_next[n])
+	{
+		spatial_prev[spatial_next[n]] = spatial_prev[n];
+	}
+
+	spatial_bucket[n] = -1;
+}
+
+static void SpatialInsert(int n, int bucket)
+{
+	if (spatial_bucket[n] == bucket)
+	{
+		return;
+	}
+
+	if (spatial_bucket[n] >= 0)
+	{
+		SpatialRemove(n);
+	}
+
+	spatial_bucket[n] = bucket;
+	spatial_prev[n] = 0;
+	spatial_next[n] = spatial_head[bucket];
+	if (spatial_head[bucket])
+	{
+		spatial_prev[spatial_head[bucket]] = n;
+	}
+
+	spatial_head[bucket] = n;
+}
+
+void G_SpatialReset(void)
+{
+	int i;
+
+	memset(spatial_head, 0, sizeof(spatial_head));
+	for (i = 0; i < MAX_EDICTS; i++)
+	{
+		spatial_bucket[i] = -1;
+	}
+
+	memset(spatial_visit, 0, sizeof(spatial_visit));
+	spatial_query = 0;
+	spatial_pad = SPATIAL_SLACK;
+	spatial_extent = 0;
+	spatial_results_cnt = 0;
+
+	// client slots are never spawned or removed
+	for (i = 1; i <= MAX_CLIENTS; i++)
+	{
+		SpatialInsert(i, SPATIAL_UNPLACED);
+	}
+}
+
+// newly spawned entity, its origin is set after spawn() returns
+void G_SpatialSpawn(gedict_t *e)
+{
+	SpatialInsert(NUM_FOR_EDICT(e), SPATIAL_UNPLACED);
+}
+
+void G_SpatialRemove(gedict_t *e)
+{
+	int n = NUM_FOR_EDICT(e);
+
+	if (spatial_bucket[n] >= 0)
+	{
+		SpatialRemove(n);
+	}
+}
+
+// entity moved, put it in the bucket of its cell
+void G_SpatialLink(gedict_t *e)
+{
+	int n = NUM_FOR_EDICT(e);
+	vec3_t center;
+
+	if ((n <= 0) || (n >= MAX_EDICTS) || (spatial_bucket[n] < 0))
+	{
+		return;
+	}
+
+	if (e->s.v.takedamage)
+	{
+		spatial_extent = max(spatial_extent,
+								max(e->s.v.size[0], max(e->s.v.size[1], e->s.v.size[2])) * 0.5);
+	}
+
+	SpatialCenter(e, center);
+	SpatialInsert(n, SpatialBucket(SpatialCell(center[0]), SpatialCell(center[1])));
+}
+
+// relink everything, physics of this frame may move entities by at most velocity * frametime
+void G_SpatialSweep(void)
+{
+	float speed, max_speed = 0;
+	int i;
+
+	for (i = 1; i < MAX_EDICTS; i++)
+	{
+		if (spatial_bucket[i] < 0)
+		{
+			continue;
+		}
+
+		G_SpatialLink(&g_edicts[i]);
+
+		speed = VectorLength(g_edicts[i].s.v.velocity);
+		if (speed > max_speed)
+		{
+			max_speed = speed;
+		}
+	}
+
+	spatial_pad = max_speed * g_globalvars.frametime + SPATIAL_SLACK;
+}
+
+// Half the biggest bbox side of anything which took damage since the map started. A box
+// query widened by it finds every such entity whose box reaches into the original box.
+float G_SpatialExtent(void)
+{
+	return spatial_extent;
+}
+
+static qbool SpatialFilter(gedict_t *e, int flags, char *classname)
+{
+	if (!(flags & SPATIAL_NONSOLID) && (e->s.v.solid == SOLID_NOT))
+	{
+		return false;
+	}
+
+	if ((flags & SPATIAL_TAKEDAMAGE) && !e->s.v.takedamage)
+	{
+		return false;
+	}
+
+	if ((flags & SPATIAL_PLAYERS) && (e->ct != ctPlayer))
+	{
+		return false;
+	}
+
+	if (classname && strneq(e->classname, classname))
+	{
+		return false;
+	}
+
+	return true;
+}
+
+static int SpatialCompare(const void *a, const void *b)
+{
+	return NUM_FOR_EDICT(*(gedict_t**)a) - NUM_FOR_EDICT(*(gedict_t**)b);
+}
+
+static void SpatialScan(int bucket, vec3_t mins, vec3_t maxs, vec3_t org, float rad, int flags,
+						char *classname)
+{
+	vec3_t center, delta;
+	gedict_t *e;
+	int n;
+
+	if (bucket < SPATIAL_BUCKETS)
+	{
+		if (spatial_visit[bucket] == spatial_query)
+		{
+			return;
+		}
+
+		spatial_visit[bucket] = spatial_query;
+	}
+
+	for (n = spatial_head[bucket]; n; n = spatial_next[n])
+	{
+		e = &g_edicts[n];
+		if (!SpatialFilter(e, flags, classname))
+		{
+			continue;
+		}
+
+		SpatialCenter(e, center);
+
+		if (org)
+		{
+			VectorSubtract(center, org, delta);
+			if (DotProduct(delta, delta) > rad * rad)
+			{
+				continue;
+			}
+		}
+		else if ((center[0] < mins[0]) || (center[1] < mins[1]) || (center[2] < mins[2])
+				|| (center[0] > maxs[0]) || (center[1] > maxs[1]) || (center[2] > maxs[2]))
+		{
+			continue;
+		}
+
+		if (spatial_results_cnt >= SPATIAL_RESULTS)
+		{
+			G_cprint("SpatialScan: too many results\n");
+
+			return;
+		}
+
+		spatial_results[spatial_results_cnt++] = e;
+	}
+}
+
+static int SpatialQuery(vec3_t mins, vec3_t maxs, vec3_t org, float rad, int flags,
+						char *classname, gedict_t ***list)
+{
+	int first = spatial_results_cnt;
+	int x0, y0, x1, y1, cx, cy;
+	int i;
+
+	// clients move between frames, relink them now
+	for (i = 1; i <= MAX_CLIENTS; i++)
+	{
+		G_SpatialLink(&g_edicts[i]);
+	}
+
+	spatial_query++;
+
+	x0 = SpatialCell(mins[0] - spatial_pad);
+	y0 = SpatialCell(mins[1] - spatial_pad);
+	x1 = SpatialCell(maxs[0] + spatial_pad);
+	y1 = SpatialCell(maxs[1] + spatial_pad);
+
+	if ((x1 - x0 + 1) * (y1 - y0 + 1) >= SPATIAL_BUCKETS)
+	{
+		for (i = 0; i < SPATIAL_BUCKETS; i++)
+		{
+			SpatialScan(i, mins, maxs, org, rad, flags, classname);
+		}
+	}
+	else
+	{
+		for (cx = x0; cx <= x1; cx++)
+		{
+			for (cy = y0; cy <= y1; cy++)
+			{
+				SpatialScan(SpatialBucket(cx, cy), mins, maxs, org, rad, flags, classname);
+			}
+		}
+	}
+
+	SpatialScan(SPATIAL_UNPLACED, mins, maxs, org, rad, flags, classname);
+
+	// same order as trap_findradius()
+	qsort(spatial_results + first, spatial_results_cnt - first, sizeof(spatial_results[0]),
+			SpatialCompare);
+
+	*list = spatial_results + first;
+
+	return spatial_results_cnt - first;
+}
+
+// Entities with bbox center within rad of org, in edict order.
+// Every query must be followed by G_SpatialRelease(), in reverse order when nested.
+int G_FindRadius(vec3_t org, float rad, int flags, char *classname, gedict_t ***list)
+{
+	vec3_t mins, maxs;
+
+	VectorSet(mins, org[0] - rad, org[1] - rad, org[2] - rad);
+	VectorSet(maxs, org[0] + rad, org[1] + rad, org[2] + rad);
+
+	return SpatialQuery(mins, maxs, org, rad, flags, classname, list);
+}
+
+// Entities with bbox center inside the box, in edict order
+int G_FindBox(vec3_t mins, vec3_t maxs, int flags, char *classname, gedict_t ***list)
+{
+	return SpatialQuery(mins, maxs, NULL, 0, flags, classname, list);
+}
+
+void G_SpatialRelease(int count)
+{
+	spatial_results_cnt = (count < spatial_results_cnt) ? spatial_results_cnt - count : 0;
+}
@@ -33,6 +33,41 @@ char *spawnVars[MAX_SPAWN_VARS][2];	// key / value pairs
 int numSpawnVarChars;
 char spawnVarChars[MAX_SPAWN_VARS_CHARS];
 
+/*
+ ===============
+ G_ParseVector
+
+ Decodes up to three whitespace separated floats into out,
+ returning how many were found (the rest of out is left untouched)
+ ===============
+ */
+static int G_ParseVector(const char *s, float *out)
+{
+	int i;
+
+	for (i = 0; i < 3; i++)
+	{
+		while ((*s == ' ') || (*s == '\t'))
+		{
+			s++;
+		}
+
+		if (!*s)
+		{
+			break;
+		}
+
+		out[i] = atof(s);
+
+		while (*s && (*s != ' ') && (*s != '\t'))
+		{
+			s++;
+		}
+	}
+
+	return i;
+}
+
 qbool G_SpawnString(const char *key, const char *defaultString, char **out)
 {
 	int i;
@@ -85,7 +120,7 @@ qbool G_SpawnVector(const char *key, const char *defaultString, float *out)
 	qbool present;
 
 	present = G_SpawnString(key, defaultString, &s);
-	sscanf(s, "%f %f %f", &out[0], &out[1], &out[2]);
+	G_ParseVector(s, out);
 
 	return present;
 }
@@ -179,7 +214,7 @@ field_t fields[] =
 // trigger_heal
 	{ "heal_amount", 				FOFS(healamount), 					F_FLOAT },
 // Colorized entities in map
-	{ "colormod" 					-1, 								F_VECTOR },
+	{ "colormod", 					-1, 								F_VECTOR },
 	{ NULL }
 };
 
@@ -508,6 +543,127 @@ spawn_t spawns[] =
 	{ 0, 0 }
 };
 
+/*
+ ===============
+ Spawn registry
+
+ Open-addressed hash tables over spawns[] and fields[], built once at
+ game init so entity loading doesn't scan both tables for every key
+ ===============
+ */
+#define SPAWN_HASH_SIZE		512		// power of two, at least twice the size of spawns[]
+#define FIELD_HASH_SIZE		256		// power of two, at least twice the size of fields[]
+
+static short spawn_hash[SPAWN_HASH_SIZE];	// index + 1 into spawns[], 0 = empty
+static short field_hash[FIELD_HASH_SIZE];	// index + 1 into fields[], 0 = empty
+static qbool spawn_registry_ready;
+
+static unsigned int G_HashName(const char *name, qbool nocase)
+{
+	unsigned int hash = 5381;
+	int c;
+
+	while ((c = (unsigned char)*name++))
+	{
+		if (nocase && (c >= 'A') && (c <= 'Z'))
+		{
+			c += 'a' - 'A';
+		}
+
+		hash = (hash * 33) + c;
+	}
+
+	return hash;
+}
+
+void G_InitSpawnRegistry(void)
+{
+	unsigned int slot;
+	int i;
+
+	memset(spawn_hash, 0, sizeof(spawn_hash));
+	memset(field_hash, 0, sizeof(field_hash));
+
+	for (i = 0; spawns[i].name; i++)
+	{
+		// first entry wins, same as the linear lookup did
+		for (slot = G_HashName(spawns[i].name, false) & (SPAWN_HASH_SIZE - 1); spawn_hash[slot];
+				slot = (slot + 1) & (SPAWN_HASH_SIZE - 1))
+		{
+			if (!strcmp(spawns[spawn_hash[slot] - 1].name, spawns[i].name))
+			{
+				break;
+			}
+		}
+
+		if (!spawn_hash[slot])
+		{
+			spawn_hash[slot] = i + 1;
+		}
+	}
+
+	for (i = 0; fields[i].name; i++)
+	{
+		for (slot = G_HashName(fields[i].name, true) & (FIELD_HASH_SIZE - 1); field_hash[slot];
+				slot = (slot + 1) & (FIELD_HASH_SIZE - 1))
+		{
+			if (!Q_stricmp(fields[field_hash[slot] - 1].name, fields[i].name))
+			{
+				break;
+			}
+		}
+
+		if (!field_hash[slot])
+		{
+			field_hash[slot] = i + 1;
+		}
+	}
+
+	spawn_registry_ready = true;
+}
+
+static spawn_t* G_FindSpawn(const char *classname)
+{
+	unsigned int slot;
+
+	if (!spawn_registry_ready)
+	{
+		G_InitSpawnRegistry();
+	}
+
+	for (slot = G_HashName(classname, false) & (SPAWN_HASH_SIZE - 1); spawn_hash[slot];
+			slot = (slot + 1) & (SPAWN_HASH_SIZE - 1))
+	{
+		if (!strcmp(spawns[spawn_hash[slot] - 1].name, classname))
+		{
+			return &spawns[spawn_hash[slot] - 1];
+		}
+	}
+
+	return NULL;
+}
+
+static field_t* G_FindField(const char *key)
+{
+	unsigned int slot;
+
+	if (!spawn_registry_ready)
+	{
+		G_InitSpawnRegistry();
+	}
+
+	for (slot = G_HashName(key, true) & (FIELD_HASH_SIZE - 1); field_hash[slot];
+			slot = (slot + 1) & (FIELD_HASH_SIZE - 1))
+	{
+		if (!Q_stricmp(fields[field_hash[slot] - 1].name, key))
+		{
+			return &fields[field_hash[slot] - 1];
+		}
+	}
+
+	return NULL;
+}
+
 /*
  ===============
  G_CallSpawn
@@ -528,6 +684,8 @@ qbool G_CallSpawn(gedict_t *ent)
 		return false;
 	}
 
+	SpawnIndexChanged(ent); // may be a new spawn point
+
 	/*	// check item spawn functions
 	 for ( item=bg_itemlist+1 ; item->classname ; item++ ) {
 	 if ( !strcmp(item->classname, ent->classname) ) {
@@ -537,17 +695,14 @@ qbool G_CallSpawn(gedict_t *ent)
 	 }*/
 
 	// check normal spawn functions
-	for (s = spawns; s->name; s++)
+	if ((s = G_FindSpawn(ent->classname)))
 	{
-		if (!strcmp(s->name, ent->classname))
-		{
-			// found it
-			self = ent;
-			//G_Printf("%8i %s\n",ent->classname,ent->classname);
-			s->spawn();
+		// found it
+		self = ent;
+		//G_Printf("%8i %s\n",ent->classname,ent->classname);
+		s->spawn();
 
-			return true;
-		}
+		return true;
 	}
 
 	G_Printf("%s doesn't have a spawn function\n", ent->classname);
@@ -613,65 +768,62 @@ static void G_ParseField(const char *key, const char *value, gedict_t *ent)
 	float v;
 	vec3_t vec;
 
-	for (f = fields; f->name; f++)
+	if (!(f = G_FindField(key)))
 	{
-		if (!Q_stricmp(f->name, key))
-		{
-			// found it
-			b = (byte*) ent;
+		G_Printf("unknown field: %s\n", key);
+
+		return;
+	}
 
-			switch (f->type)
+	b = (byte*) ent;
+
+	switch (f->type)
+	{
+		case F_LSTRING:
+			*(char**)(b + f->ofs) = G_NewString(value);
+			break;
+
+		case F_VECTOR:
+			VectorClear(vec);
+			G_ParseVector(value, vec);
+			if (f->ofs >= 0)
 			{
-				case F_LSTRING:
-					*(char**)(b + f->ofs) = G_NewString(value);
-					break;
-
-				case F_VECTOR:
-					sscanf(value, "%f %f %f", &vec[0], &vec[1], &vec[2]);
-					if (f->ofs >= 0)
-					{
-						((float*)(b + f->ofs))[0] = vec[0];
-						((float*)(b + f->ofs))[1] = vec[1];
-						((float*)(b + f->ofs))[2] = vec[2];
-					}
-					else if (!strcmp(f->name, "colormod"))
-					{
-						ExtFieldSetColorMod(ent, vec[0], vec[1], vec[2]);
-					}
-					break;
-
-				case F_INT:
-					*(int*)(b + f->ofs) = atoi(value);
-					break;
-
-				case F_FLOAT:
-					if (f->ofs >= 0)
-					{
-						*(float*)(b + f->ofs) = atof(value);
-					}
-					else if (!strcmp(f->name, "alpha"))
-					{
-						ExtFieldSetAlpha(ent, atof(value));
-					}
-					break;
-
-				case F_ANGLEHACK:
-					v = atof(value);
-					((float*)(b + f->ofs))[0] = 0;
-					((float*)(b + f->ofs))[1] = v;
-					((float*)(b + f->ofs))[2] = 0;
-					break;
-
-				default:
-				case F_IGNORE:
-					break;
+				((float*)(b + f->ofs))[0] = vec[0];
+				((float*)(b + f->ofs))[1] = vec[1];
+				((float*)(b + f->ofs))[2] = vec[2];
 			}
+			else if (!strcmp(f->name, "colormod"))
+			{
+				ExtFieldSetColorMod(ent, vec[0], vec[1], vec[2]);
+			}
+			break;
 
-			return;
-		}
-	}
+		case F_INT:
+			*(int*)(b + f->ofs) = atoi(value);
+			break;
+
+		case F_FLOAT:
+			if (f->ofs >= 0)
+			{
+				*(float*)(b + f->ofs) = atof(value);
+			}
+			else if (!strcmp(f->name, "alpha"))
+			{
+				ExtFieldSetAlpha(ent, atof(value));
+			}
+			break;
 
-	G_Printf("unknown field: %s\n", key);
+		case F_ANGLEHACK:
+			v = atof(value);
+			((float*)(b + f->ofs))[0] = 0;
+			((float*)(b + f->ofs))[1] = v;
+			((float*)(b + f->ofs))[2] = 0;
+			break;
+
+		default:
+		case F_IGNORE:
+			break;
+	}
 }
 
 /*
@@ -439,23 +439,13 @@ intptr_t QVMstrftime(char *valbuff, intptr_t sizebuff, const char *fmt, intptr_t
 	return syscall(G_QVMstrftime, (intptr_t) valbuff, sizebuff, (intptr_t) fmt, offset);
 }
 
+// Pure math, no need to go through the engine. The QVM still uses G_MAKEVECTORS since
+// sin() and cos() are syscalls there too.
 void trap_makevectors(float *v)
 {
-	syscall(G_MAKEVECTORS, (intptr_t) v);
+	AngleVectors(v, g_globalvars.v_forward, g_globalvars.v_right, g_globalvars.v_up);
 }
 
-#if defined( __linux__ ) || defined( _WIN32 ) /* || defined( __APPLE__ ) require?*/
-size_t strlcpy(char *dst, const char *src, size_t siz)
-{
-	return syscall(g_strlcpy, (intptr_t) dst, (intptr_t) src, (intptr_t) siz);
-}
-
-size_t strlcat(char *dst, const char *src, size_t siz)
-{
-	return syscall(g_strlcat, (intptr_t) dst, (intptr_t) src, (intptr_t) siz);
-}
-#endif
-
 intptr_t trap_SetUserInfo(intptr_t edn, const char *varname, const char *value, intptr_t flags)
 {
 	return syscall(G_SETUSERINFO, edn, (intptr_t) varname, (intptr_t) value, flags);
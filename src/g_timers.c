@@ -0,0 +1,333 @@
+//
+// g_timers.c - hierarchical timer wheel for deferred game events
+//
+// Deadlines are hashed into three wheels of ticks: 256 slots of one tick, then 64 slots of
+// 256 ticks and 64 slots of 16384 ticks. Timers of an outer wheel move inward when the inner
+// wheel wraps, so G_TimersRun() only touches timers which are due or about to be.
+// A timer may belong to an entity, the callback then runs with self set to it and the timer
+// is cancelled when the entity is removed.
+//
+
+#include "g_local.h"
+
+#define TIMER_MAX			4096					// must be power of two above MAX_EDICTS, timer 0 is never used
+#define TIMER_INDEX_BITS	12
+#define TIMER_TICKS			100						// ticks per second
+#define TIMER_BITS0			8
+#define TIMER_BITS			6
+#define TIMER_WHEEL0		(1 << TIMER_BITS0)
+#define TIMER_WHEEL			(1 << TIMER_BITS)
+#define TIMER_RUNNING		(TIMER_WHEEL0 + 2 * TIMER_WHEEL)	// slot being drained
+#define TIMER_SLOTS			(TIMER_RUNNING + 1)
+
+typedef struct g_timer_s
+{
+	timer_func_t func;
+	gedict_t *ent;
+	float time;
+	int serial;										// bumped on every reuse, stale handles don't match
+	int slot;										// -1 = free
+	int next, prev;
+	int ent_next, ent_prev;							// timers of the same entity
+} g_timer_t;
+
+static g_timer_t timers[TIMER_MAX];
+static int timer_head[TIMER_SLOTS];
+static int timer_ent_head[MAX_EDICTS];
+static int timer_free;
+static int timer_serial;
+static int timer_tick;								// last tick G_TimersRun() got to
+static qbool timer_started;
+
+static int TimerTick(float time)
+{
+	return (int)(time * TIMER_TICKS);
+}
+
+// first call after reset, start counting from now
+static void TimerStart(void)
+{
+	if (!timer_started)
+	{
+		timer_tick = TimerTick(g_globalvars.time);
+		timer_started = true;
+	}
+}
+
+static int TimerSlot(int tick)
+{
+	int delta = tick - timer_tick;
+
+	if (delta < TIMER_WHEEL0)
+	{
+		return ((delta < 0) ? timer_tick : tick) & (TIMER_WHEEL0 - 1);
+	}
+
+	if (delta < (1 << (TIMER_BITS0 + TIMER_BITS)))
+	{
+		return TIMER_WHEEL0 + ((tick >> TIMER_BITS0) & (TIMER_WHEEL - 1));
+	}
+
+	// out of range, parked in the farthest slot and placed again when it cascades
+	if (delta >= (1 << (TIMER_BITS0 + 2 * TIMER_BITS)))
+	{
+		tick = timer_tick + (1 << (TIMER_BITS0 + 2 * TIMER_BITS)) - 1;
+	}
+
+	return TIMER_WHEEL0 + TIMER_WHEEL + ((tick >> (TIMER_BITS0 + TIMER_BITS)) & (TIMER_WHEEL - 1));
+}
+
+static void TimerLink(int i, int slot)
+{
+	g_timer_t *t = &timers[i];
+
+	t->slot = slot;
+	t->prev = 0;
+	t->next = timer_head[slot];
+	if (timer_head[slot])
+	{
+		timers[timer_head[slot]].prev = i;
+	}
+
+	timer_head[slot] = i;
+}
+
+static void TimerUnlink(int i)
+{
+	g_timer_t *t = &timers[i];
+
+	if (t->prev)
+	{
+		timers[t->prev].next = t->next;
+	}
+	else
+	{
+		timer_head[t->slot] = t->next;
+	}
+
+	if (t->next)
+	{
+		timers[t->next].prev = t->prev;
+	}
+}
+
+static void TimerFree(int i)
+{
+	g_timer_t *t = &timers[i];
+	int n;
+
+	TimerUnlink(i);
+
+	if (t->ent)
+	{
+		n = NUM_FOR_EDICT(t->ent);
+
+		if (t->ent_prev)
+		{
+			timers[t->ent_prev].ent_next = t->ent_next;
+		}
+		else
+		{
+			timer_ent_head[n] = t->ent_next;
+		}
+
+		if (t->ent_next)
+		{
+			timers[t->ent_next].ent_prev = t->ent_prev;
+		}
+	}
+
+	t->slot = -1;
+	t->ent = NULL;
+	t->next = timer_free;
+	timer_free = i;
+}
+
+// moves a whole slot to the running list, so callbacks can add and cancel timers meanwhile
+static void TimerDetach(int slot)
+{
+	int i;
+
+	while ((i = timer_head[slot]))
+	{
+		TimerUnlink(i);
+		TimerLink(i, TIMER_RUNNING);
+	}
+}
+
+// puts timers of an outer wheel slot where they belong now
+static void TimerCascade(int slot)
+{
+	int i;
+
+	TimerDetach(slot);
+
+	while ((i = timer_head[TIMER_RUNNING]))
+	{
+		TimerUnlink(i);
+		TimerLink(i, TimerSlot(TimerTick(timers[i].time)));
+	}
+}
+
+static void TimerRunSlot(int slot)
+{
+	gedict_t *oself;
+	timer_func_t func;
+	gedict_t *ent;
+	int i;
+
+	TimerDetach(slot);
+
+	while ((i = timer_head[TIMER_RUNNING]))
+	{
+		if (timers[i].time > g_globalvars.time)
+		{
+			// due later within the current tick
+			TimerUnlink(i);
+			TimerLink(i, slot);
+			continue;
+		}
+
+		func = timers[i].func;
+		ent = timers[i].ent;
+		TimerFree(i);
+
+		oself = self;
+		self = ent ? ent : world;
+		func();
+		self = oself;
+	}
+}
+
+void G_TimersReset(void)
+{
+	int i;
+
+	memset(timers, 0, sizeof(timers));
+	memset(timer_head, 0, sizeof(timer_head));
+	memset(timer_ent_head, 0, sizeof(timer_ent_head));
+
+	timer_free = 0;
+	for (i = TIMER_MAX - 1; i > 0; i--)
+	{
+		timers[i].slot = -1;
+		timers[i].next = timer_free;
+		timer_free = i;
+	}
+
+	timer_started = false;
+}
+
+// Calls func at time, with self set to ent (world if ent is NULL).
+// Returns a handle for G_TimerCancel(), 0 if out of timers.
+int G_TimerAdd(float time, timer_func_t func, gedict_t *ent)
+{
+	g_timer_t *t;
+	int i, n;
+
+	if (!timer_free)
+	{
+		G_cprint("G_TimerAdd: no free timers, event of edict %d dropped\n", ent ? NUM_FOR_EDICT(ent) : 0);
+
+		return 0;
+	}
+
+	TimerStart();
+
+	i = timer_free;
+	t = &timers[i];
+	timer_free = t->next;
+
+	t->func = func;
+	t->ent = ent;
+	t->time = time;
+	t->serial = timer_serial = (timer_serial + 1) & 0x7FFFF;
+	t->ent_prev = t->ent_next = 0;
+
+	if (ent)
+	{
+		n = NUM_FOR_EDICT(ent);
+		t->ent_next = timer_ent_head[n];
+		if (timer_ent_head[n])
+		{
+			timers[timer_ent_head[n]].ent_prev = i;
+		}
+
+		timer_ent_head[n] = i;
+	}
+
+	TimerLink(i, TimerSlot(TimerTick(time)));
+
+	return (t->serial << TIMER_INDEX_BITS) | i;
+}
+
+static int TimerFromHandle(int handle)
+{
+	int i = handle & (TIMER_MAX - 1);
+
+	if (!i || (timers[i].slot < 0) || (timers[i].serial != (handle >> TIMER_INDEX_BITS)))
+	{
+		return 0;
+	}
+
+	return i;
+}
+
+qbool G_TimerPending(int handle)
+{
+	return (TimerFromHandle(handle) != 0);
+}
+
+// Safe to call with 0 or with the handle of a timer which already fired
+void G_TimerCancel(int handle)
+{
+	int i = TimerFromHandle(handle);
+
+	if (i)
+	{
+		TimerFree(i);
+	}
+}
+
+// entity is being removed
+void G_TimersRemoveEntity(gedict_t *e)
+{
+	int n = NUM_FOR_EDICT(e);
+
+	while (timer_ent_head[n])
+	{
+		TimerFree(timer_ent_head[n]);
+	}
+}
+
+// Once per frame, runs every timer which is due
+void G_TimersRun(void)
+{
+	int now;
+
+	TimerStart();
+	now = TimerTick(g_globalvars.time);
+
+	for (;;)
+	{
+		TimerRunSlot(timer_tick & (TIMER_WHEEL0 - 1));
+
+		if (timer_tick >= now)
+		{
+			break;
+		}
+
+		timer_tick++;
+
+		if (!(timer_tick & (TIMER_WHEEL0 - 1)))
+		{
+			if (!((timer_tick >> TIMER_BITS0) & (TIMER_WHEEL - 1)))
+			{
+				TimerCascade(TIMER_WHEEL0 + TIMER_WHEEL
+								+ ((timer_tick >> (TIMER_BITS0 + TIMER_BITS)) & (TIMER_WHEEL - 1)));
+			}
+
+			TimerCascade(TIMER_WHEEL0 + ((timer_tick >> TIMER_BITS0) & (TIMER_WHEEL - 1)));
+		}
+	}
+}
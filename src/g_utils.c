@@ -143,6 +143,7 @@ gedict_t* spawn(void)
 
 	t->spawn_time = g_globalvars.time;
 	initialise_spawned_ent(t);
+	G_SpatialSpawn(t);
 
 	return t;
 }
@@ -159,6 +160,15 @@ void ent_remove(gedict_t *t)
 		G_Error("remove client");
 	}
 
+	SpawnIndexChanged(t);
+	G_SpatialRemove(t);
+	G_TimersRemoveEntity(t);
+
+	if (FxRelease(t))
+	{
+		return; // pooled effect, edict is kept for the next one
+	}
+
 	trap_remove(NUM_FOR_EDICT(t));
 }
 
@@ -467,33 +477,6 @@ gedict_t *findradius( gedict_t * start, vec3_t org, float rad )
 
 #endif
 
-// Same as findradius but ignore solid field.
-gedict_t* findradius_ignore_solid(gedict_t *start, vec3_t org, float rad)
-{
-	gedict_t *ent;
-	vec3_t eorg;
-	int j;
-
-	for (ent = nextent(start); ent; ent = nextent(ent))
-	{
-//		if ( ent->s.v.solid == SOLID_NOT )
-//			continue;
-		for (j = 0; j < 3; j++)
-		{
-			eorg[j] = org[j] - (ent->s.v.origin[j] + (ent->s.v.mins[j] + ent->s.v.maxs[j]) * 0.5);
-		}
-
-		if (VectorLength(eorg) > rad)
-		{
-			continue;
-		}
-
-		return ent;
-
-	}
-
-	return NULL;
-}
 /*
  ==============
  changeyaw
@@ -901,17 +884,20 @@ void stuffcmd_flags(gedict_t *ed, int flags, const char *fmt, ...)
 void setorigin(gedict_t *ed, float origin_x, float origin_y, float origin_z)
 {
 	trap_setorigin(NUM_FOR_EDICT(ed), origin_x, origin_y, origin_z);
+	G_SpatialLink(ed);
 }
 
 void setsize(gedict_t *ed, float min_x, float min_y, float min_z, float max_x, float max_y,
 				float max_z)
 {
 	trap_setsize(NUM_FOR_EDICT(ed), min_x, min_y, min_z, max_x, max_y, max_z);
+	G_SpatialLink(ed);
 }
 
 void setmodel(gedict_t *ed, char *model)
 {
 	trap_setmodel(NUM_FOR_EDICT(ed), model);
+	G_SpatialLink(ed);
 }
 
 void sound(gedict_t *ed, int channel, char *samp, float vol, float att)
@@ -953,7 +939,11 @@ void TraceCapsule(float v1_x, float v1_y, float v1_z, float v2_x, float v2_y, fl
 
 int droptofloor(gedict_t *ed)
 {
-	return trap_droptofloor(NUM_FOR_EDICT(ed));
+	int retv = trap_droptofloor(NUM_FOR_EDICT(ed));
+
+	G_SpatialLink(ed);
+
+	return retv;
 }
 
 int checkbottom(gedict_t *ed)
@@ -1062,6 +1052,7 @@ int walkmove(gedict_t *ed, float yaw, float dist)
 	saveactivator = activator;
 
 	retv = trap_walkmove(NUM_FOR_EDICT(ed), yaw, dist);
+	G_SpatialLink(ed);
 
 	self = saveself;
 	other = saveother;
@@ -1079,6 +1070,7 @@ int movetogoal(float dist)
 	saveactivator = activator;
 
 	retv = trap_movetogoal(dist);
+	G_SpatialLink(saveself);
 
 	self = saveself;
 	other = saveother;
@@ -1997,6 +1989,29 @@ gedict_t *ed_best1 = NULL;
 gedict_t *ed_best2 = NULL;
 gedict_t *ed_bestPow = NULL;
 
+// Ranking is cached and recalculated only when something which affects it happened
+// (pickup, death, respawn, frags change) or when some powerup is about to run out.
+// Ammo running dry is not tracked, AUTOTRACK_RANKING_REFRESH limits how long we may miss it.
+#define AUTOTRACK_RANKING_REFRESH 0.5
+
+static qbool best_players_valid = false;
+static float best_players_expire = 0;
+
+// something which affects autotrack ranking happened, recalculate it on next query
+void InvalidateBestPlayers(void)
+{
+	best_players_valid = false;
+}
+
+// remember when ranking changes by itself due to powerup timeout
+static void BestPlayersExpireAt(float finished)
+{
+	if ((finished >= g_globalvars.time) && (finished < best_players_expire))
+	{
+		best_players_expire = finished;
+	}
+}
+
 void CalculateBestPlayers(void)
 {
 	gedict_t *p;
@@ -2048,6 +2063,11 @@ void CalculateBestPlayers(void)
 		best += (((int)p->s.v.items & IT_SUPER_SHOTGUN) && p->s.v.ammo_shells > 0) ? 50 : 0; // ssg with ammo
 		best += p->s.v.frags;
 
+		BestPlayersExpireAt(p->invincible_finished);
+		BestPlayersExpireAt(p->super_damage_finished);
+		BestPlayersExpireAt(p->invisible_finished);
+		BestPlayersExpireAt(p->radsuit_finished);
+
 		if (!ed_best1)
 		{ // select some first player as best
 			ed_best1 = p;
@@ -2124,23 +2144,38 @@ void CalculateBestPowPlayers(void)
 	}
 }
 
-gedict_t* get_ed_best1(void)
+static void UpdateBestPlayers(void)
 {
+	if (best_players_valid && (g_globalvars.time < best_players_expire))
+	{
+		return;
+	}
+
+	best_players_expire = g_globalvars.time + AUTOTRACK_RANKING_REFRESH;
 	CalculateBestPlayers();
+	CalculateBestPowPlayers();
+
+	// race ranking depends on race state only, do not cache it
+	best_players_valid = !isRACE();
+}
+
+gedict_t* get_ed_best1(void)
+{
+	UpdateBestPlayers();
 
 	return ed_best1;
 }
 
 gedict_t* get_ed_best2(void)
 {
-	CalculateBestPlayers();
+	UpdateBestPlayers();
 
 	return ed_best2;
 }
 
 gedict_t* get_ed_bestPow(void)
 {
-	CalculateBestPowPlayers();
+	UpdateBestPlayers();
 
 	return ed_bestPow;
 }
@@ -2580,6 +2615,8 @@ void refresh_plus_scores(void)
 {
 	gedict_t *p;
 
+	InvalidateBestPlayers(); // frags changed
+
 	for (p = world; (p = find_client(p));)
 	{
 		cl_refresh_plus_scores(p);
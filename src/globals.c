@@ -65,6 +65,7 @@ int k_lastvotedmap;				// last voted map, used for agree command?
 
 // { CTF
 int k_ctf_custom_models;		// if server has flag/grapple models you can enable them here
+int k_ctf_hookstyle;			// k_ctf_hookstyle cvar, read once per frame
 // http://www.quakeworld.us/ult/ctf/pak0.pak  (only 300kb)
 // if not we use old style keys and ax/voreball for grapple
 #ifdef CTF_RELOADMAP
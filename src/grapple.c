@@ -41,6 +41,233 @@ float DecreasePullSpeed(float currentSpeed, float decrAmount)
 	return newSpeed;
 }
 
+//
+// GrappleChainBeam - With k_ctf_hookbeam the chain is drawn as a beam from the
+//                    owner to the hook, clients keep one beam per entity so
+//                    each update replaces the last one. The beam belongs to the
+//                    hook entity, the owner's lightning gun beam is keyed on
+//                    the owner. A beam of zero length clears it.
+//
+static void GrappleChainBeam(gedict_t *rhook, vec3_t end)
+{
+	gedict_t *owner = PROG_TO_EDICT(rhook->s.v.owner);
+
+	WriteByte( MSG_MULTICAST, SVC_TEMPENTITY);
+	WriteByte( MSG_MULTICAST, TE_LIGHTNING1);
+	WriteEntity( MSG_MULTICAST, rhook);
+	WriteCoord( MSG_MULTICAST, owner->s.v.origin[0]);
+	WriteCoord( MSG_MULTICAST, owner->s.v.origin[1]);
+	WriteCoord( MSG_MULTICAST, owner->s.v.origin[2]);
+	WriteCoord( MSG_MULTICAST, end[0]);
+	WriteCoord( MSG_MULTICAST, end[1]);
+	WriteCoord( MSG_MULTICAST, end[2]);
+
+	trap_multicast(PASSVEC3(owner->s.v.origin), MULTICAST_PVS);
+}
+
+//
+// MakeLink - spawns a chain link entity
+//
+static gedict_t* MakeLink(gedict_t *rhook)
+{
+	gedict_t *link = spawn();
+
+	link->s.v.movetype = MOVETYPE_FLYMISSILE;
+	link->s.v.solid = SOLID_NOT;
+	link->s.v.owner = EDICT_TO_PROG(rhook);
+
+	if (k_ctf_custom_models)
+	{
+		setmodel(link, "progs/bit.mdl");
+	}
+	else
+	{
+		setmodel(link, "progs/spike.mdl");
+	}
+
+	setorigin(link, PASSVEC3(rhook->s.v.origin));
+	setsize(link, 0, 0, 0, 0, 0, 0);
+
+	return link;
+}
+
+//
+// RemoveLinks - Removes a chain link entity and the ones after it
+//
+static void RemoveLinks(gedict_t *link)
+{
+	int i;
+
+	for (i = 0; (i < 3) && (link != world); i++)
+	{
+		link->think = (func_t) SUB_Remove;
+		link->s.v.nextthink = next_frame();
+		link = PROG_TO_EDICT(link->s.v.goalentity);
+	}
+}
+
+//
+// RemoveChain - Stops drawing the chain of a hook; this is a separate
+//                function because GrappleReset also needs to be able
+//                to remove the chain.
+//
+static void RemoveChain(gedict_t *rhook)
+{
+	gedict_t *owner = PROG_TO_EDICT(rhook->s.v.owner);
+
+	if (!rhook->hook_chain)
+	{
+		return;
+	}
+
+	rhook->hook_chain = false;
+
+	if (rhook->s.v.goalentity)
+	{
+		RemoveLinks(PROG_TO_EDICT(rhook->s.v.goalentity));
+		rhook->s.v.goalentity = 0;
+	}
+	else
+	{
+		GrappleChainBeam(rhook, owner->s.v.origin);
+	}
+}
+
+//
+// UpdateChain - Keeps the chain of a hook up to date each frame. It is called
+//                by the first link entity, or by the hook itself when the
+//                chain is a beam.
+//
+static void UpdateChain(gedict_t *rhook)
+{
+	vec3_t t1, t2, t3;
+	vec3_t temp;
+	gedict_t *owner = PROG_TO_EDICT(rhook->s.v.owner), *goal, *goal2;
+
+	if (!rhook->hook_chain)
+	{
+		return;
+	}
+
+	if (!owner->hook_out)
+	{
+		RemoveChain(rhook);
+
+		return;
+	}
+
+	if (k_ctf_hookstyle != HOOK_STYLE_CLASSIC)
+	{
+		owner->hook_cancel_time += 1;
+		// delay cancelling the hook until ~250ms (13 * 19) if `smooth hook` is enabled (prevent spam attacks)
+		if (k_ctf_hookstyle == HOOK_STYLE_SMOOTH && owner->hook_cancel_time > 19)
+		{
+			CancelHook(owner);
+		}
+
+		if (k_ctf_hookstyle == HOOK_STYLE_FAST && owner->hook_cancel_time > 6)
+		{
+			CancelHook(owner);
+		}
+
+		if (k_ctf_hookstyle == HOOK_STYLE_CR)
+		{
+			CancelHook(owner);
+		}
+
+		if (!rhook->hook_chain)
+		{
+			return; // cancelled
+		}
+	}
+
+	VectorSubtract(rhook->s.v.origin, owner->s.v.origin, temp);
+
+	if (vlen(temp) <= 100 && owner->on_hook)
+	{
+		// If there is a chain, ditch it now. We're close enough.
+		// Having extra entities lying around is never a good idea.
+		RemoveChain(rhook);
+
+		return;
+	}
+
+	if (!rhook->s.v.goalentity)
+	{
+		GrappleChainBeam(rhook, rhook->s.v.origin);
+
+		return;
+	}
+
+	goal = PROG_TO_EDICT(rhook->s.v.goalentity);
+	goal2 = PROG_TO_EDICT(goal->s.v.goalentity);
+
+	VectorScale(temp, 0.25, t1);
+	VectorAdd(t1, owner->s.v.origin, t1);
+	VectorScale(temp, 0.50, t2);
+	VectorAdd(t2, owner->s.v.origin, t2);
+	VectorScale(temp, 0.75, t3);
+	VectorAdd(t3, owner->s.v.origin, t3);
+
+	// These numbers are correct assuming 3 links.
+	// 4 links would be *20 *40 *60 and *80
+	setorigin(goal, PASSVEC3(t1));
+	setorigin(goal2, PASSVEC3(t2));
+	setorigin(PROG_TO_EDICT(goal2->s.v.goalentity), PASSVEC3(t3));
+}
+
+//
+// LinkThink - Think of the first chain link, it repositions all of them.
+//              Links of a hook which is gone remove themselves.
+//
+static void LinkThink(void)
+{
+	gedict_t *rhook = PROG_TO_EDICT(self->s.v.owner);
+
+	if ((rhook->s.v.goalentity != EDICT_TO_PROG(self))
+			|| (PROG_TO_EDICT(rhook->s.v.owner)->hook != rhook))
+	{
+		RemoveLinks(self);
+
+		return;
+	}
+
+	UpdateChain(rhook);
+
+	if (rhook->hook_chain)
+	{
+		self->s.v.nextthink = next_frame();
+	}
+}
+
+//
+// BuildChain - Builds the chain (linked list) of three link entities
+//
+static void BuildChain(gedict_t *rhook)
+{
+	gedict_t *link = MakeLink(rhook);
+
+	rhook->s.v.goalentity = EDICT_TO_PROG(link);
+	link->think = (func_t) LinkThink;
+	link->s.v.nextthink = next_frame();
+	link->s.v.goalentity = EDICT_TO_PROG(MakeLink(rhook));
+	link = PROG_TO_EDICT(link->s.v.goalentity);
+	link->s.v.goalentity = EDICT_TO_PROG(MakeLink(rhook));
+}
+
+//
+// GrappleFly - Think of the hook while it flies, only when the chain is a beam
+//
+static void GrappleFly(void)
+{
+	UpdateChain(self);
+
+	if (self->hook_chain)
+	{
+		self->s.v.nextthink = next_frame();
+	}
+}
+
 //
 // GrappleReset - Removes the hook and resets its owner's state.
 //                 expects a pointer to the hook
@@ -59,7 +286,7 @@ void GrappleReset(gedict_t *rhook)
 	owner->hook_out = false;
 	owner->s.v.weaponframe = 0;
 
-	if (cvar("k_ctf_hookstyle") == 1)
+	if (k_ctf_hookstyle == HOOK_STYLE_SMOOTH)
 	{
 		owner->attack_finished = (self->ctf_flag & CTF_RUNE_HST) ? 
 			g_globalvars.time + ((HOOK_FIRE_RATE / 2) / cvar("k_ctf_rune_power_hst")) : g_globalvars.time + (HOOK_FIRE_RATE / 2);
@@ -73,6 +300,8 @@ void GrappleReset(gedict_t *rhook)
 		owner->hook_reset_time = g_globalvars.time;
 	}
 
+	RemoveChain(rhook);
+
 	rhook->think = (func_t) SUB_Remove;
 	rhook->s.v.nextthink = next_frame();
 }
@@ -135,126 +364,11 @@ void GrappleTrack(void)
 		VectorCopy(enemy->s.v.velocity, self->s.v.velocity);
 	}
 
-	self->s.v.nextthink = next_frame();
-}
-
-//
-// MakeLink - spawns the chain link entities
-//
-gedict_t* MakeLink(void)
-{
-	newmis = spawn();
-	g_globalvars.newmis = EDICT_TO_PROG(newmis);
-
-	newmis->s.v.movetype = MOVETYPE_FLYMISSILE;
-	newmis->s.v.solid = SOLID_NOT;
-	newmis->s.v.owner = EDICT_TO_PROG(self);
-
-	if (k_ctf_custom_models)
+	// link entities update the chain themselves
+	if (!self->s.v.goalentity)
 	{
-		setmodel(newmis, "progs/bit.mdl");
+		UpdateChain(self);
 	}
-	else
-	{
-		setmodel(newmis, "progs/spike.mdl");
-	}
-
-	setorigin(newmis, PASSVEC3(self->s.v.origin));
-	setsize(newmis, 0, 0, 0, 0, 0, 0);
-
-	return newmis;
-}
-
-//
-// RemoveChain - Removes all chain link entities; this is a separate
-//                function because CLIENT also needs to be able
-//                to remove the chain. Only one function required to
-//                remove all links.
-//
-void RemoveChain(void)
-{
-	self->think = (func_t) SUB_Remove;
-	self->s.v.nextthink = next_frame();
-
-	if (self->s.v.goalentity)
-	{
-		gedict_t *goal = PROG_TO_EDICT(self->s.v.goalentity);
-		goal->think = (func_t) SUB_Remove;
-		goal->s.v.nextthink = next_frame();
-
-		if (goal->s.v.goalentity)
-		{
-			gedict_t *goal2 = PROG_TO_EDICT(goal->s.v.goalentity);
-			goal2->think = (func_t) SUB_Remove;
-			goal2->s.v.nextthink = next_frame();
-		}
-	}
-}
-
-//
-// Update_Chain - Repositions the chain links each frame. This single function
-//                maintains the positions of all of the links. Only one link
-//                is thinking every frame. 
-//
-void UpdateChain(void)
-{
-	vec3_t t1, t2, t3;
-	vec3_t temp;
-	gedict_t *owner = PROG_TO_EDICT(self->s.v.owner), *goal, *goal2;
-
-	if (!owner->hook_out)
-	{
-		self->think = (func_t) RemoveChain;
-		self->s.v.nextthink = next_frame();
-		return;
-	}
-
-	if (cvar("k_ctf_hookstyle") != 3)
-	{
-		owner->hook_cancel_time += 1;
-		// delay cancelling the hook until ~250ms (13 * 19) if `smooth hook` is enabled (prevent spam attacks)
-		if (cvar("k_ctf_hookstyle") == 1 && owner->hook_cancel_time > 19)
-		{
-			CancelHook(owner);
-		}
-
-		if(cvar("k_ctf_hookstyle") == 2 && owner->hook_cancel_time > 6)
-		{
-			CancelHook(owner);
-		}
-
-		if (cvar("k_ctf_hookstyle") == 4)
-		{
-			CancelHook(owner);
-		}
-	}
-
-	VectorSubtract(owner->hook->s.v.origin, owner->s.v.origin, temp);
-
-	goal = PROG_TO_EDICT(self->s.v.goalentity);
-	goal2 = PROG_TO_EDICT(goal->s.v.goalentity);
-
-	if(vlen(temp) <= 100 && owner->on_hook)
-	{
-		// If there is a chain, ditch it now. We're close enough. 
-		// Having extra entities lying around is never a good idea.
-		self->think = (func_t) RemoveChain;
-		self->s.v.nextthink = next_frame();
-		return;
-	}
-
-	VectorScale(temp, 0.25, t1);
-	VectorAdd(t1, owner->s.v.origin, t1);
-	VectorScale(temp, 0.50, t2);
-	VectorAdd(t2, owner->s.v.origin, t2);
-	VectorScale(temp, 0.75, t3);
-	VectorAdd(t3, owner->s.v.origin, t3);
-
-	// These numbers are correct assuming 3 links.
-	// 4 links would be *20 *40 *60 and *80
-	setorigin(self, PASSVEC3(t1));
-	setorigin(goal, PASSVEC3(t2));
-	setorigin(goal2, PASSVEC3(t3));
 
 	self->s.v.nextthink = next_frame();
 }
@@ -270,20 +384,6 @@ void CancelHook(gedict_t *owner)
 	}
 }
 
-//
-// BuildChain - Builds the chain (linked list)
-//
-void BuildChain(void)
-{
-	self->s.v.goalentity = EDICT_TO_PROG(MakeLink());
-	PROG_TO_EDICT(self->s.v.goalentity)->think = (func_t)UpdateChain;
-	PROG_TO_EDICT(self->s.v.goalentity)->s.v.nextthink = next_frame();
-	PROG_TO_EDICT(self->s.v.goalentity)->s.v.owner = self->s.v.owner;
-	PROG_TO_EDICT(self->s.v.goalentity)->s.v.goalentity = EDICT_TO_PROG(MakeLink());
-	PROG_TO_EDICT(PROG_TO_EDICT(self->s.v.goalentity)->s.v.goalentity)->s.v.goalentity =
-			EDICT_TO_PROG(MakeLink());
-}
-
 void GrappleAnchor(void)
 {
 	gedict_t *owner = PROG_TO_EDICT(self->s.v.owner);
@@ -399,7 +499,7 @@ void GrappleService(void)
 	VectorCopy(hookVector, hookVelocity);
 	VectorNormalize(hookVelocity);
 
-	if (cvar("k_ctf_hookstyle") == 1)
+	if (k_ctf_hookstyle == HOOK_STYLE_SMOOTH)
 	{
 		if (self->hook_pullspeed_accel > 0) // accelerate
 		{
@@ -440,11 +540,11 @@ void GrappleThrow(void)
 
 	throwSpeed = NEW_THROW_SPEED;
 
-	if (cvar("k_ctf_hookstyle") == 3)
+	if (k_ctf_hookstyle == HOOK_STYLE_CLASSIC)
 	{
 		throwSpeed = THROW_SPEED;
 	}
-	else if (cvar("k_ctf_hookstyle") == 4)
+	else if (k_ctf_hookstyle == HOOK_STYLE_CR)
 	{
 		throwSpeed = CR_THROW_SPEED;
 	}
@@ -461,7 +561,7 @@ void GrappleThrow(void)
 	newmis->s.v.owner = EDICT_TO_PROG(self);
 	self->hook = newmis;
 	newmis->classname = "hook";
-	if (cvar("k_ctf_hookstyle") != 3)
+	if (k_ctf_hookstyle != HOOK_STYLE_CLASSIC)
 	{
 		self->hook_cancel_time = 0;
 	}
@@ -487,8 +587,7 @@ void GrappleThrow(void)
 
 
 	newmis->touch = (func_t) GrappleAnchor;
-	newmis->think = (func_t) BuildChain;
-	newmis->s.v.nextthink = next_frame();
+	newmis->hook_chain = true;
 
 	if (k_ctf_custom_models)
 	{
@@ -504,4 +603,14 @@ void GrappleThrow(void)
 				self->s.v.origin[2] + g_globalvars.v_forward[2] * 16 + 16);
 	setsize(newmis, 0, 0, 0, 0, 0, 0);
 	self->hook_out = true;
+
+	if (cvar("k_ctf_hookbeam"))
+	{
+		newmis->think = (func_t) GrappleFly;
+		newmis->s.v.nextthink = next_frame();
+	}
+	else
+	{
+		BuildChain(newmis);
+	}
 }
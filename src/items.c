@@ -46,6 +46,7 @@ static qbool ItemTouched(gedict_t *item, gedict_t *player)
 
 static void ItemTaken(gedict_t *item, gedict_t *player)
 {
+	InvalidateBestPlayers();
 	TeamplayEventItemTaken(player, item);
 
 #ifdef BOT_SUPPORT
@@ -212,16 +213,8 @@ float T_Heal(gedict_t *e, float healamount, float ignore)
 	 cleantext(playername),
 	 (int)real_healamount );
 	 */
-	log_printf("\t\t<event>\n"
-				"\t\t\t<pick_mapitem>\n"
-				"\t\t\t\t<time>%f</time>\n"
-				"\t\t\t\t<item>health_%d</item>\n"
-				"\t\t\t\t<player>%s</player>\n"
-				"\t\t\t\t<value>%d</value>\n"
-				"\t\t\t</pick_mapitem>\n"
-				"\t\t</event>\n",
-				g_globalvars.time - match_start_time, (int)healamount, cleantext(playername),
-				(int)real_healamount);
+	LogEventItem(lePickMapItem, playername, va("health_%d", (int)healamount),
+					(int)real_healamount, 0);
 
 	return 1;
 }
@@ -312,6 +305,7 @@ void health_touch(void)
 		}
 
 		other->ps.itm[itHEALTH_100].tooks++;
+		TimelineItem(other, itHEALTH_100);
 
 		mi_print(other, IT_SUPERHEALTH, va("%s got Megahealth", getname(other)));
 	}
@@ -326,10 +320,12 @@ void health_touch(void)
 		{
 			case 15:
 				other->ps.itm[itHEALTH_15].tooks++;
+				TimelineItem(other, itHEALTH_15);
 				break;
 
 			case 25:
 				other->ps.itm[itHEALTH_25].tooks++;
+				TimelineItem(other, itHEALTH_25);
 				break;
 		}
 	}
@@ -505,6 +501,7 @@ void armor_touch(void)
 		adjust_pickup_time(&other->it_pickup_time[armorType], &other->ps.itm[armorType].time);
 		other->it_pickup_time[armorType] = g_globalvars.time;
 		other->ps.itm[armorType].tooks++;
+		TimelineItem(other, armorType);
 		switch (armorType)
 		{
 			case itGA:
@@ -554,16 +551,7 @@ void armor_touch(void)
 	 cleantext(playername),
 	 (int)real_value );
 	 */
-	log_printf("\t\t<event>\n"
-				"\t\t\t<pick_mapitem>\n"
-				"\t\t\t\t<time>%f</time>\n"
-				"\t\t\t\t<item>%s</item>\n"
-				"\t\t\t\t<player>%s</player>\n"
-				"\t\t\t\t<value>%d</value>\n"
-				"\t\t\t</pick_mapitem>\n"
-				"\t\t</event>\n",
-				g_globalvars.time - match_start_time, self->classname, cleantext(playername),
-				(int)real_value);
+	LogEventItem(lePickMapItem, playername, self->classname, (int)real_value, 0);
 
 	G_sprint(other, PRINT_LOW, "You got the %s\n", self->netname);
 // armor touch sound
@@ -1008,16 +996,7 @@ void weapon_touch(void)
 	 cleantext(playername),
 	 real_ammo );
 	 */
-	log_printf("\t\t<event>\n"
-				"\t\t\t<pick_mapitem>\n"
-				"\t\t\t\t<time>%f</time>\n"
-				"\t\t\t\t<item>%s</item>\n"
-				"\t\t\t\t<player>%s</player>\n"
-				"\t\t\t\t<value>%d</value>\n"
-				"\t\t\t</pick_mapitem>\n"
-				"\t\t</event>\n",
-				g_globalvars.time - match_start_time, self->classname, cleantext(playername),
-				real_ammo);
+	LogEventItem(lePickMapItem, playername, self->classname, real_ammo, 0);
 
 // change to the weapon
 	other->s.v.items = (int)other->s.v.items | new;
@@ -1274,16 +1253,7 @@ void ammo_touch(void)
 	 cleantext(playername),
 	 real_ammo );
 	 */
-	log_printf("\t\t<event>\n"
-				"\t\t\t<pick_mapitem>\n"
-				"\t\t\t\t<time>%f</time>\n"
-				"\t\t\t\t<item>%s</item>\n"
-				"\t\t\t\t<player>%s</player>\n"
-				"\t\t\t\t<value>%d</value>\n"
-				"\t\t\t</pick_mapitem>\n"
-				"\t\t</event>\n",
-				g_globalvars.time - match_start_time, self->classname, cleantext(playername),
-				real_ammo);
+	LogEventItem(lePickMapItem, playername, self->classname, real_ammo, 0);
 
 	G_sprint(other, PRINT_LOW, "You got the %s\n", self->netname);
 // ammo touch sound
@@ -1529,15 +1499,7 @@ void key_touch(void)
 	 cleantext(playername),
 	 0 );
 	 */
-	log_printf("\t\t<event>\n"
-				"\t\t\t<pick_mapitem>\n"
-				"\t\t\t\t<time>%f</time>\n"
-				"\t\t\t\t<item>%s</item>\n"
-				"\t\t\t\t<player>%s</player>\n"
-				"\t\t\t\t<value>%d</value>\n"
-				"\t\t\t</pick_mapitem>\n"
-				"\t\t</event>\n",
-				g_globalvars.time - match_start_time, self->classname, cleantext(playername), 0);
+	LogEventItem(lePickMapItem, playername, self->classname, 0, 0);
 
 	G_sprint(other, PRINT_LOW, "You got the %s\n", self->netname);
 
@@ -1693,15 +1655,7 @@ void sigil_touch(void)
 	 cleantext(playername),
 	 0 );
 	 */
-	log_printf("\t\t<event>\n"
-				"\t\t\t<pick_mapitem>\n"
-				"\t\t\t\t<time>%f</time>\n"
-				"\t\t\t\t<item>%s</item>\n"
-				"\t\t\t\t<player>%s</player>\n"
-				"\t\t\t\t<value>%d</value>\n"
-				"\t\t\t</pick_mapitem>\n"
-				"\t\t</event>\n",
-				g_globalvars.time - match_start_time, self->classname, cleantext(playername), 0);
+	LogEventItem(lePickMapItem, playername, self->classname, 0, 0);
 
 	G_centerprint(other, "You got the rune!");
 
@@ -1899,16 +1853,7 @@ void DropPowerup(float timeleft, int powerup)
 
 	playername = swp->netname;
 
-	log_printf("\t\t<event>\n"
-				"\t\t\t<drop_powerup>\n"
-				"\t\t\t\t<time>%f</time>\n"
-				"\t\t\t\t<item>%s</item>\n"
-				"\t\t\t\t<player>%s</player>\n"
-				"\t\t\t\t<timeleft>%f</timeleft>\n"
-				"\t\t\t</drop_powerup>\n"
-				"\t\t</event>\n",
-				g_globalvars.time - match_start_time, self->classname, cleantext(playername),
-				timeleft);
+	LogEventItem(leDropPowerup, playername, self->classname, 0, timeleft);
 
 	if (swp->ct == ctPlayer)
 	{
@@ -2123,6 +2068,7 @@ void powerup_touch(void)
 		other->it_pickup_time[itPENT] = g_globalvars.time;
 
 		other->ps.itm[itPENT].tooks++;
+		TimelineItem(other, itPENT);
 		other->invincible_time = 1;
 		other->invincible_finished = g_globalvars.time + 30;
 
@@ -2138,6 +2084,7 @@ void powerup_touch(void)
 		other->it_pickup_time[itRING] = g_globalvars.time;
 
 		other->ps.itm[itRING].tooks++;
+		TimelineItem(other, itRING);
 		other->invisible_time = 1;
 		other->invisible_finished = g_globalvars.time + 30;
 
@@ -2153,6 +2100,7 @@ void powerup_touch(void)
 		other->it_pickup_time[itQUAD] = g_globalvars.time;
 
 		other->ps.itm[itQUAD].tooks++;
+		TimelineItem(other, itQUAD);
 		other->ps.spree_max_q = max(other->ps.spree_current_q, other->ps.spree_max_q);
 		other->ps.spree_current_q = 0;
 
@@ -2206,16 +2154,7 @@ void powerup_touch(void)
 
 	playername = other->netname;
 
-	log_printf("\t\t<event>\n"
-				"\t\t\t<pick_powerup>\n"
-				"\t\t\t\t<time>%f</time>\n"
-				"\t\t\t\t<item>%s</item>\n"
-				"\t\t\t\t<player>%s</player>\n"
-				"\t\t\t\t<timeleft>%f</timeleft>\n"
-				"\t\t\t</pick_powerup>\n"
-				"\t\t</event>\n",
-				g_globalvars.time - match_start_time, self->classname, cleantext(playername),
-				real_time);
+	LogEventItem(lePickPowerup, playername, self->classname, 0, real_time);
 
 	ktpro_autotrack_on_powerup_take(other);
 
@@ -2518,20 +2457,7 @@ void BackpackTouch(void)
 	 (int)self->s.v.ammo_cells,
 	 cleantext(playername) );
 	 */
-	log_printf("\t\t<event>\n"
-				"\t\t\t<pick_backpack>\n"
-				"\t\t\t\t<time>%f</time>\n"
-				"\t\t\t\t<weapon>%s</weapon>\n"
-				"\t\t\t\t<shells>%d</shells>\n"
-				"\t\t\t\t<nails>%d</nails>\n"
-				"\t\t\t\t<rockets>%d</rockets>\n"
-				"\t\t\t\t<cells>%d</cells>\n"
-				"\t\t\t\t<player>%s</player>\n"
-				"\t\t\t</pick_backpack>\n"
-				"\t\t</event>\n",
-				g_globalvars.time - match_start_time, new_wp, (int)self->s.v.ammo_shells,
-				(int)self->s.v.ammo_nails, (int)self->s.v.ammo_rockets,
-				(int)self->s.v.ammo_cells, cleantext(playername));
+	LogEventBackpack(lePickBackpack, playername, new_wp, self);
 
 	if (self->s.v.ammo_shells)
 	{
@@ -2817,20 +2743,7 @@ void DropBackpack(void)
 
 	playername = self->netname;
 
-	log_printf("\t\t<event>\n"
-				"\t\t\t<drop_backpack>\n"
-				"\t\t\t\t<time>%f</time>\n"
-				"\t\t\t\t<weapon>%s</weapon>\n"
-				"\t\t\t\t<shells>%d</shells>\n"
-				"\t\t\t\t<nails>%d</nails>\n"
-				"\t\t\t\t<rockets>%d</rockets>\n"
-				"\t\t\t\t<cells>%d</cells>\n"
-				"\t\t\t\t<player>%s</player>\n"
-				"\t\t\t</drop_backpack>\n"
-				"\t\t</event>\n",
-				g_globalvars.time - match_start_time, item->netname, (int)item->s.v.ammo_shells,
-				(int)item->s.v.ammo_nails, (int)item->s.v.ammo_rockets,
-				(int)item->s.v.ammo_cells, cleantext(playername));
+	LogEventBackpack(leDropBackpack, playername, item->netname, item);
 
 	item->s.v.velocity[2] = 300;
 	item->s.v.velocity[0] = -100 + (g_random() * 200);
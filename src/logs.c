@@ -20,7 +20,38 @@
 #include "g_local.h"
 #include "stats.h"
 
+// Match events are not written to the logs right away, they are queued in the ring
+// and written by LogsFrame() with a per-frame budget, so I/O is spread across the match.
+// Same queue feeds both XML extralog and NDJSON event stream.
+
+#define LOG_EVENTS_MAX		1024	// must be power of two
+#define LOG_EVENT_NAME		CLIENT_NAME_LEN
+#define LOG_EVENT_TEXT		1024
+#define LOG_DEFAULT_BUDGET	4096	// bytes per frame
+
+typedef struct log_event_s
+{
+	logEventType_t type;
+	float time;					// since match start
+	char player[LOG_EVENT_NAME];	// attacker for damage and death, team for round end
+	char target[LOG_EVENT_NAME];
+	char item[LOG_EVENT_NAME];	// item, weapon or death type
+	int value;					// pickup value, damage, armor left or round number
+	int quad;
+	int splash;
+	int armor;
+	int height;
+	int ammo[4];				// shells, nails, rockets, cells
+	float timeleft;				// powerup time left or player lifetime
+} log_event_t;
+
+static log_event_t log_events[LOG_EVENTS_MAX];
+static int log_events_head;		// next event to write
+static int log_events_tail;		// next free slot
+static int log_events_overrun;	// how many times queue was full and we had to write synchronously
+
 fileHandle_t log_handle = -1;
+static fileHandle_t event_handle = -1;
 
 void log_close(void)
 {
@@ -90,6 +121,428 @@ void log_printf(const char *fmt, ...)
 	trap_FS_WriteFile(text, strlen(text), log_handle);
 }
 
+static void event_log_close(void)
+{
+	if (event_handle < 0)
+	{
+		return;
+	}
+
+	trap_FS_CloseFile(event_handle);
+	event_handle = -1;
+}
+
+static void event_log_printf(const char *fmt, ...) PRINTF_FUNC(1);
+static void event_log_printf(const char *fmt, ...)
+{
+	va_list argptr;
+	char text[LOG_EVENT_TEXT] =
+		{ 0 };
+
+	if (event_handle < 0)
+	{
+		return;
+	}
+
+	va_start(argptr, fmt);
+	Q_vsnprintf(text, sizeof(text), fmt, argptr);
+	va_end(argptr);
+
+	text[sizeof(text) - 1] = 0;
+
+	trap_FS_WriteFile(text, strlen(text), event_handle);
+}
+
+static qbool log_events_enabled(void)
+{
+	return ((log_handle >= 0) || (event_handle >= 0));
+}
+
+static int log_event_xml(log_event_t *ev, char *buf, int size)
+{
+	switch (ev->type)
+	{
+		case leDamage:
+			return snprintf(buf, size, "\t\t<event>\n"
+							"\t\t\t<damage>\n"
+							"\t\t\t\t<time>%f</time>\n"
+							"\t\t\t\t<attacker>%s</attacker>\n"
+							"\t\t\t\t<target>%s</target>\n"
+							"\t\t\t\t<type>%s</type>\n"
+							"\t\t\t\t<quad>%d</quad>\n"
+							"\t\t\t\t<splash>%d</splash>\n"
+							"\t\t\t\t<value>%d</value>\n"
+							"\t\t\t\t<armor>%d</armor>\n"
+							"\t\t\t</damage>\n"
+							"\t\t</event>\n",
+							ev->time, cleantext(ev->player), cleantext(ev->target), ev->item,
+							ev->quad, ev->splash, ev->value, ev->armor);
+
+		case leDeath:
+			return snprintf(buf, size, "\t\t<event>\n"
+							"\t\t\t<death>\n"
+							"\t\t\t\t<time>%f</time>\n"
+							"\t\t\t\t<attacker>%s</attacker>\n"
+							"\t\t\t\t<target>%s</target>\n"
+							"\t\t\t\t<type>%s</type>\n"
+							"\t\t\t\t<quad>%d</quad>\n"
+							"\t\t\t\t<armorleft>%d</armorleft>\n"
+							"\t\t\t\t<killheight>%d</killheight>\n"
+							"\t\t\t\t<lifetime>%f</lifetime>\n"
+							"\t\t\t</death>\n"
+							"\t\t</event>\n",
+							ev->time, cleantext(ev->player), cleantext(ev->target), ev->item,
+							ev->quad, ev->value, ev->height, ev->timeleft);
+
+		case lePickMapItem:
+			return snprintf(buf, size, "\t\t<event>\n"
+							"\t\t\t<pick_mapitem>\n"
+							"\t\t\t\t<time>%f</time>\n"
+							"\t\t\t\t<item>%s</item>\n"
+							"\t\t\t\t<player>%s</player>\n"
+							"\t\t\t\t<value>%d</value>\n"
+							"\t\t\t</pick_mapitem>\n"
+							"\t\t</event>\n",
+							ev->time, ev->item, cleantext(ev->player), ev->value);
+
+		case lePickPowerup:
+		case leDropPowerup:
+			return snprintf(buf, size, "\t\t<event>\n"
+							"\t\t\t<%s>\n"
+							"\t\t\t\t<time>%f</time>\n"
+							"\t\t\t\t<item>%s</item>\n"
+							"\t\t\t\t<player>%s</player>\n"
+							"\t\t\t\t<timeleft>%f</timeleft>\n"
+							"\t\t\t</%s>\n"
+							"\t\t</event>\n",
+							LogEventName(ev->type), ev->time, ev->item, cleantext(ev->player),
+							ev->timeleft, LogEventName(ev->type));
+
+		case lePickBackpack:
+		case leDropBackpack:
+			return snprintf(buf, size, "\t\t<event>\n"
+							"\t\t\t<%s>\n"
+							"\t\t\t\t<time>%f</time>\n"
+							"\t\t\t\t<weapon>%s</weapon>\n"
+							"\t\t\t\t<shells>%d</shells>\n"
+							"\t\t\t\t<nails>%d</nails>\n"
+							"\t\t\t\t<rockets>%d</rockets>\n"
+							"\t\t\t\t<cells>%d</cells>\n"
+							"\t\t\t\t<player>%s</player>\n"
+							"\t\t\t</%s>\n"
+							"\t\t</event>\n",
+							LogEventName(ev->type), ev->time, ev->item, ev->ammo[0], ev->ammo[1],
+							ev->ammo[2], ev->ammo[3], cleantext(ev->player),
+							LogEventName(ev->type));
+
+		default:
+			return 0; // not part of ktxlog schema
+	}
+}
+
+static int log_event_json(log_event_t *ev, char *buf, int size)
+{
+	int len = snprintf(buf, size, "{\"type\":\"%s\",\"time\":%.3f", LogEventName(ev->type),
+						ev->time);
+
+	switch (ev->type)
+	{
+		case leDamage:
+			len += snprintf(buf + len, size - len,
+							",\"attacker\":\"%s\",\"target\":\"%s\",\"deathtype\":\"%s\","
+							"\"quad\":%d,\"splash\":%d,\"value\":%d,\"armor\":%d",
+							json_string(ev->player), json_string(ev->target), ev->item, ev->quad,
+							ev->splash, ev->value, ev->armor);
+			break;
+
+		case leDeath:
+			len += snprintf(buf + len, size - len,
+							",\"attacker\":\"%s\",\"target\":\"%s\",\"deathtype\":\"%s\","
+							"\"quad\":%d,\"armorleft\":%d,\"killheight\":%d,\"lifetime\":%.3f",
+							json_string(ev->player), json_string(ev->target), ev->item, ev->quad,
+							ev->value, ev->height, ev->timeleft);
+			break;
+
+		case lePickMapItem:
+			len += snprintf(buf + len, size - len,
+							",\"player\":\"%s\",\"item\":\"%s\",\"value\":%d",
+							json_string(ev->player), ev->item, ev->value);
+			break;
+
+		case lePickPowerup:
+		case leDropPowerup:
+			len += snprintf(buf + len, size - len,
+							",\"player\":\"%s\",\"item\":\"%s\",\"timeleft\":%.3f",
+							json_string(ev->player), ev->item, ev->timeleft);
+			break;
+
+		case lePickBackpack:
+		case leDropBackpack:
+			len += snprintf(buf + len, size - len,
+							",\"player\":\"%s\",\"weapon\":\"%s\",\"shells\":%d,\"nails\":%d,"
+							"\"rockets\":%d,\"cells\":%d",
+							json_string(ev->player), ev->item, ev->ammo[0], ev->ammo[1],
+							ev->ammo[2], ev->ammo[3]);
+			break;
+
+		case leSpawn:
+			len += snprintf(buf + len, size - len, ",\"player\":\"%s\",\"team\":\"%s\"",
+							json_string(ev->player), json_string(ev->target));
+			break;
+
+		case leRoundEnd:
+			len += snprintf(buf + len, size - len, ",\"round\":%d,\"winner\":\"%s\"",
+							ev->value, json_string(ev->player));
+			break;
+
+		default:
+			break;
+	}
+
+	len += snprintf(buf + len, size - len, "}\n");
+
+	return len;
+}
+
+// write oldest queued event, returns amount of bytes written
+static int log_event_write(qbool xml)
+{
+	static char text[LOG_EVENT_TEXT];
+	log_event_t *ev;
+	int len, written = 0;
+
+	if (log_events_head == log_events_tail)
+	{
+		return 0;
+	}
+
+	ev = &log_events[log_events_head & (LOG_EVENTS_MAX - 1)];
+	log_events_head++;
+
+	if (xml)
+	{
+		len = bound(0, log_event_xml(ev, text, sizeof(text)), sizeof(text) - 1);
+		trap_FS_WriteFile(text, len, log_handle);
+		written += len;
+	}
+
+	if (event_handle >= 0)
+	{
+		len = bound(0, log_event_json(ev, text, sizeof(text)), sizeof(text) - 1);
+		trap_FS_WriteFile(text, len, event_handle);
+		written += len;
+	}
+
+	return written;
+}
+
+static qbool log_events_xml(void)
+{
+	return ((log_handle >= 0) && cvar("k_extralog"));
+}
+
+static void log_events_flush(int budget)
+{
+	qbool xml = log_events_xml();
+	int written = 0;
+
+	while ((log_events_head != log_events_tail) && ((budget <= 0) || (written < budget)))
+	{
+		written += log_event_write(xml);
+	}
+}
+
+const char* LogEventName(logEventType_t type)
+{
+	switch (type)
+	{
+		case leDamage:
+			return "damage";
+		case leDeath:
+			return "death";
+		case lePickMapItem:
+			return "pick_mapitem";
+		case lePickPowerup:
+			return "pick_powerup";
+		case leDropPowerup:
+			return "drop_powerup";
+		case lePickBackpack:
+			return "pick_backpack";
+		case leDropBackpack:
+			return "drop_backpack";
+		case leSpawn:
+			return "spawn";
+		case leRoundEnd:
+			return "round_end";
+		default:
+			return "unknown";
+	}
+}
+
+// returns new event to fill in or NULL if nobody logging events
+static log_event_t* log_event_new(logEventType_t type)
+{
+	log_event_t *ev;
+
+	if (!log_events_enabled())
+	{
+		return NULL;
+	}
+
+	if (log_events_tail - log_events_head >= LOG_EVENTS_MAX)
+	{
+		// queue is full, budget is too small for this match
+		log_events_overrun++;
+		log_event_write(log_events_xml());
+	}
+
+	ev = &log_events[log_events_tail & (LOG_EVENTS_MAX - 1)];
+	log_events_tail++;
+
+	memset(ev, 0, sizeof(*ev));
+	ev->type = type;
+	ev->time = g_globalvars.time - match_start_time;
+
+	return ev;
+}
+
+void LogEventDamage(gedict_t *attacker, const char *attackername, const char *targetname,
+					int deathtype, int splash, int value, qbool armor)
+{
+	log_event_t *ev = log_event_new(leDamage);
+
+	if (!ev)
+	{
+		return;
+	}
+
+	strlcpy(ev->player, attackername, sizeof(ev->player));
+	strlcpy(ev->target, targetname, sizeof(ev->target));
+	strlcpy(ev->item, death_type(deathtype), sizeof(ev->item));
+	ev->quad = (attacker->super_damage_finished > g_globalvars.time ? 1 : 0);
+	ev->splash = splash;
+	ev->value = value;
+	ev->armor = armor ? 1 : 0;
+}
+
+void LogEventDeath(gedict_t *attacker, const char *attackername, gedict_t *targ,
+					const char *targetname, int killheight)
+{
+	log_event_t *ev = log_event_new(leDeath);
+
+	if (!ev)
+	{
+		return;
+	}
+
+	strlcpy(ev->player, attackername, sizeof(ev->player));
+	strlcpy(ev->target, targetname, sizeof(ev->target));
+	strlcpy(ev->item, death_type(targ->deathtype), sizeof(ev->item));
+	ev->quad = (attacker->super_damage_finished > g_globalvars.time ? 1 : 0);
+	ev->value = (int)targ->s.v.armorvalue;
+	ev->height = killheight;
+	ev->timeleft = g_globalvars.time - targ->spawn_time;
+}
+
+// pick_mapitem, pick_powerup and drop_powerup
+void LogEventItem(logEventType_t type, const char *playername, const char *item, int value,
+					float timeleft)
+{
+	log_event_t *ev = log_event_new(type);
+
+	if (!ev)
+	{
+		return;
+	}
+
+	strlcpy(ev->player, playername, sizeof(ev->player));
+	strlcpy(ev->item, item, sizeof(ev->item));
+	ev->value = value;
+	ev->timeleft = timeleft;
+}
+
+// pick_backpack and drop_backpack
+void LogEventBackpack(logEventType_t type, const char *playername, const char *weapon,
+						gedict_t *backpack)
+{
+	log_event_t *ev = log_event_new(type);
+
+	if (!ev)
+	{
+		return;
+	}
+
+	strlcpy(ev->player, playername, sizeof(ev->player));
+	strlcpy(ev->item, weapon, sizeof(ev->item));
+	ev->ammo[0] = (int)backpack->s.v.ammo_shells;
+	ev->ammo[1] = (int)backpack->s.v.ammo_nails;
+	ev->ammo[2] = (int)backpack->s.v.ammo_rockets;
+	ev->ammo[3] = (int)backpack->s.v.ammo_cells;
+}
+
+void LogEventSpawn(gedict_t *p)
+{
+	log_event_t *ev = log_event_new(leSpawn);
+
+	if (!ev)
+	{
+		return;
+	}
+
+	strlcpy(ev->player, p->netname, sizeof(ev->player));
+	strlcpy(ev->target, getteam(p), sizeof(ev->target));
+}
+
+void LogEventRoundEnd(int round, const char *winner)
+{
+	log_event_t *ev = log_event_new(leRoundEnd);
+
+	if (!ev)
+	{
+		return;
+	}
+
+	strlcpy(ev->player, winner, sizeof(ev->player));
+	ev->value = round;
+}
+
+// called each frame, writes queued events within the budget
+void LogsFrame(void)
+{
+	if (log_events_head == log_events_tail)
+	{
+		return;
+	}
+
+	log_events_flush(cvar("k_extralog_budget") ? cvar("k_extralog_budget") : LOG_DEFAULT_BUDGET);
+}
+
+static void StartEventLog(char *ip, int port, const char *date)
+{
+	char name[256];
+
+	event_log_close();
+
+	if (!cvar("k_eventlog"))
+	{
+		return;
+	}
+
+	// This file over-written every match, like demoinfo
+	snprintf(name, sizeof(name), "matchevents_%s_%d.ndjson", ip, port);
+	if (trap_FS_OpenFile(name, &event_handle, FS_WRITE_BIN) < 0)
+	{
+		event_handle = -1;
+
+		return;
+	}
+
+	event_log_printf("{\"type\":\"match_start\",\"timestamp\":\"%s\",\"hostname\":\"%s\","
+						"\"ip\":\"%s\",\"port\":%d,\"map\":\"%s\",\"mode\":\"%s\"}\n",
+						json_string(date), json_string(cvar_string("_k_host")), ip, port,
+						json_string(mapname), GetMode());
+}
+
 void StartLogs(void)
 {
 	char date[64] =
@@ -134,11 +587,23 @@ void StartLogs(void)
 				"\t</match_info>\n",
 				date, cleantext(cvar_string("_k_host")), ip, i, mapname, GetMode());
 	log_printf("\t<events>\n");
+
+	StartEventLog(ip, i, date);
+
+	log_events_head = log_events_tail = log_events_overrun = 0;
 }
 
 void StopLogs(void)
 {
+	log_events_flush(0);
+
 	log_printf("\t</events>\n");
 	log_printf("</ktxlog>\n");
 	log_close();
+
+	event_log_printf("{\"type\":\"match_end\",\"time\":%.3f,\"overruns\":%d}\n",
+						g_globalvars.time - match_start_time, log_events_overrun);
+	event_log_close();
+
+	log_events_head = log_events_tail = 0;
 }
@@ -0,0 +1,377 @@
+//
+// map_bundle.c - binary cache of parsed per-map text files
+//
+// Text sources that the mod tokenizes itself on every map change (.bot routes, .loc files)
+// are parsed once and the result is saved as a section of bundles/<map>.mbc.
+// Each section remembers the name, length and checksum of the text it was built from,
+// so a later load can skip tokenizing and use the cached data while the text is unchanged.
+// A source too large for the text buffer is not cached, its lines are read straight from the
+// file as before.
+//
+
+#include "g_local.h"
+
+#define MAP_BUNDLE_VERSION		1
+#define MAP_BUNDLE_SIZE			(96 * 1024)		// whole bundle image, twice the dm3 routes and locs
+#define MAP_BUNDLE_TEXT_SIZE	(64 * 1024)		// largest text source cached, the biggest .bot we ship is 44 KB
+
+typedef struct map_bundle_header_s
+{
+	char magic[4];
+	int version;
+	int sections;
+} map_bundle_header_t;
+
+typedef struct map_bundle_section_s
+{
+	int id;
+	int size;						// bytes of data following this header
+	int source_length;
+	unsigned int source_checksum;
+	char source[64];
+} map_bundle_section_t;
+
+static int bundle_image[MAP_BUNDLE_SIZE / sizeof(int)];
+static int bundle_length;
+static char bundle_name[128];
+
+static char bundle_text[MAP_BUNDLE_TEXT_SIZE];
+static char source_name[64];
+static int source_length;
+static unsigned int source_checksum;
+static fileHandle_t source_stream = -1;	// too large source read line by line, not cached
+
+static map_bundle_section_t *building;	// section being built by MapBundleBegin()
+
+static map_bundle_header_t* MapBundleHeader(void)
+{
+	return (map_bundle_header_t*)bundle_image;
+}
+
+static void MapBundleClear(void)
+{
+	map_bundle_header_t *header = MapBundleHeader();
+
+	memcpy(header->magic, "KMBC", 4);
+	header->version = MAP_BUNDLE_VERSION;
+	header->sections = 0;
+	bundle_length = sizeof(map_bundle_header_t);
+	building = NULL;
+}
+
+static unsigned int MapBundleChecksum(const char *data, int length)
+{
+	unsigned int hash = 5381;
+	int i;
+
+	for (i = 0; i < length; i++)
+	{
+		hash = (hash * 33) ^ (unsigned char)data[i];
+	}
+
+	return hash;
+}
+
+// Checks every section header lies within the image
+static qbool MapBundleValid(void)
+{
+	map_bundle_header_t *header = MapBundleHeader();
+	int offset = sizeof(map_bundle_header_t);
+	int i;
+
+	if ((bundle_length < (int)sizeof(map_bundle_header_t)) || (bundle_length >= MAP_BUNDLE_SIZE)
+			|| memcmp(header->magic, "KMBC", 4) || (header->version != MAP_BUNDLE_VERSION))
+	{
+		return false;
+	}
+
+	for (i = 0; i < header->sections; i++)
+	{
+		map_bundle_section_t *section = (map_bundle_section_t*)((byte*)bundle_image + offset);
+
+		if ((offset + (int)sizeof(map_bundle_section_t) > bundle_length) || (section->size < 0)
+				|| (section->size & 3))
+		{
+			return false;
+		}
+
+		offset += sizeof(map_bundle_section_t) + section->size;
+		if (offset > bundle_length)
+		{
+			return false;
+		}
+	}
+
+	return (offset == bundle_length);
+}
+
+// Reads the bundle of the current map, once per map
+static void MapBundleLoad(void)
+{
+	char *entityFile = cvar_string("k_entityfile");
+	char name[128];
+	fileHandle_t handle;
+
+	snprintf(name, sizeof(name), "bundles/%s.mbc", strnull(entityFile) ? mapname : entityFile);
+	if (streq(name, bundle_name))
+	{
+		return;
+	}
+
+	strlcpy(bundle_name, name, sizeof(bundle_name));
+	MapBundleClear();
+
+	if (trap_FS_OpenFile(bundle_name, &handle, FS_READ_BIN) < 0)
+	{
+		return;
+	}
+
+	// single read, a bundle that fills the whole image is treated as truncated
+	bundle_length = trap_FS_ReadFile((char*)bundle_image, MAP_BUNDLE_SIZE, handle);
+	trap_FS_CloseFile(handle);
+
+	if (!MapBundleValid())
+	{
+		G_cprint("Ignoring invalid map bundle %s\n", bundle_name);
+		MapBundleClear();
+	}
+}
+
+static map_bundle_section_t* MapBundleFind(int id)
+{
+	map_bundle_header_t *header = MapBundleHeader();
+	int offset = sizeof(map_bundle_header_t);
+	int i;
+
+	for (i = 0; i < header->sections; i++)
+	{
+		map_bundle_section_t *section = (map_bundle_section_t*)((byte*)bundle_image + offset);
+
+		if (section->id == id)
+		{
+			return section;
+		}
+
+		offset += sizeof(map_bundle_section_t) + section->size;
+	}
+
+	return NULL;
+}
+
+static void MapBundleRemove(int id)
+{
+	map_bundle_section_t *section = MapBundleFind(id);
+	byte *end;
+	int size;
+
+	if (!section)
+	{
+		return;
+	}
+
+	size = sizeof(map_bundle_section_t) + section->size;
+	end = (byte*)section + size;
+	memmove(section, end, ((byte*)bundle_image + bundle_length) - end);
+	bundle_length -= size;
+	MapBundleHeader()->sections--;
+}
+
+static void MapBundleCloseStream(void)
+{
+	if (source_stream >= 0)
+	{
+		trap_FS_CloseFile(source_stream);
+		source_stream = -1;
+	}
+}
+
+// Reads a whole text source into memory and remembers its checksum, NULL if it can't be read.
+// A source larger than the text buffer is opened for MapBundleNextLine() to read from the file.
+char* MapBundleOpenSource(const char *fmt, ...)
+{
+	va_list argptr;
+	char name[64];
+	fileHandle_t handle;
+	int length;
+
+	MapBundleCloseStream();
+
+	va_start(argptr, fmt);
+	Q_vsnprintf(name, sizeof(name), fmt, argptr);
+	va_end(argptr);
+
+	if (trap_FS_OpenFile(name, &handle, FS_READ_BIN) < 0)
+	{
+		return NULL;
+	}
+
+	length = trap_FS_ReadFile(bundle_text, MAP_BUNDLE_TEXT_SIZE, handle);
+	trap_FS_CloseFile(handle);
+	if (length < 0)
+	{
+		return NULL;
+	}
+
+	if (length >= MAP_BUNDLE_TEXT_SIZE)
+	{
+		// start over, the whole file is parsed line by line
+		if (trap_FS_OpenFile(name, &source_stream, FS_READ_BIN) < 0)
+		{
+			source_stream = -1;
+
+			return NULL;
+		}
+
+		bundle_text[0] = 0;
+		source_name[0] = 0;
+		source_length = -1;
+		source_checksum = 0;
+
+		return bundle_text;
+	}
+
+	bundle_text[length] = 0;
+	strlcpy(source_name, name, sizeof(source_name));
+	source_length = length;
+	source_checksum = MapBundleChecksum(bundle_text, length);
+
+	return bundle_text;
+}
+
+// Copies the next line of a text source into line, NULL at end of text
+char* MapBundleNextLine(char **cursor, char *line, int size)
+{
+	char *s = *cursor;
+	int i = 0;
+
+	if (source_stream >= 0)
+	{
+		if (!std_fgets(source_stream, line, size))
+		{
+			MapBundleCloseStream();
+
+			return NULL;
+		}
+
+		for (i = 0; line[i] && (line[i] != '\r') && (line[i] != '\n'); i++)
+		{
+		}
+
+		line[i] = 0;
+
+		return line;
+	}
+
+	if (!*s)
+	{
+		return NULL;
+	}
+
+	while (*s && (*s != '\n'))
+	{
+		if (i < size - 1)
+		{
+			line[i++] = *s;
+		}
+
+		s++;
+	}
+
+	if (*s == '\n')
+	{
+		s++;
+	}
+
+	line[i] = 0;
+	*cursor = s;
+
+	return line;
+}
+
+// Cached data for the last opened source, NULL if there is none or it was built from other text
+void* MapBundleSection(mapBundleSection_t id, int *size)
+{
+	map_bundle_section_t *section;
+
+	MapBundleLoad();
+
+	section = MapBundleFind(id);
+	if (!section || (source_length < 0) || strneq(section->source, source_name) || (section->source_length != source_length)
+			|| (section->source_checksum != source_checksum))
+	{
+		return NULL;
+	}
+
+	*size = section->size;
+
+	return (section + 1);
+}
+
+// Starts rebuilding section id for the last opened source
+void MapBundleBegin(mapBundleSection_t id)
+{
+	MapBundleLoad();
+	MapBundleRemove(id);
+
+	if ((source_length < 0)
+			|| (bundle_length + (int)sizeof(map_bundle_section_t) >= MAP_BUNDLE_SIZE))
+	{
+		building = NULL;
+
+		return;
+	}
+
+	building = (map_bundle_section_t*)((byte*)bundle_image + bundle_length);
+	memset(building, 0, sizeof(*building));
+	building->id = id;
+	building->source_length = source_length;
+	building->source_checksum = source_checksum;
+	strlcpy(building->source, source_name, sizeof(building->source));
+}
+
+void MapBundleAppend(const void *data, int size)
+{
+	int offset;
+
+	if (!building)
+	{
+		return;
+	}
+
+	offset = bundle_length + sizeof(map_bundle_section_t) + building->size;
+	if (offset + size >= MAP_BUNDLE_SIZE)
+	{
+		G_cprint("Map bundle full, %s not cached\n", building->source);
+		building = NULL;
+
+		return;
+	}
+
+	memcpy((byte*)bundle_image + offset, data, size);
+	building->size += size;
+}
+
+// Adds the section built since MapBundleBegin() and saves the bundle
+void MapBundleCommit(void)
+{
+	fileHandle_t handle;
+
+	MapBundleCloseStream();
+
+	if (!building)
+	{
+		return;
+	}
+
+	bundle_length += sizeof(map_bundle_section_t) + building->size;
+	MapBundleHeader()->sections++;
+	building = NULL;
+
+	if (trap_FS_OpenFile(bundle_name, &handle, FS_WRITE_BIN) < 0)
+	{
+		return;
+	}
+
+	trap_FS_WriteFile((char*)bundle_image, bundle_length, handle);
+	trap_FS_CloseFile(handle);
+}
@@ -55,6 +55,22 @@ static int maps_cnt = 0;
 static char ml_buf[MAX_MAPS * 32] =
 { 0 }; // OUCH OUCH!!! btw, 32 is some average len of map name here, with path
 
+#define MAPS_HASH (MAX_MAPS * 2) // must be power of two
+
+static short mapslist_hash[MAPS_HASH]; // index + 1 of the first map with that name, 0 = empty
+
+static unsigned int MapNameHash(const char *name, int size)
+{
+	unsigned int hash = 5381;
+
+	while (*name)
+	{
+		hash = (hash * 33) + (unsigned char)*name++;
+	}
+
+	return hash & (size - 1);
+}
+
 // NOTE: we did not check is this map alredy in list or not...
 static void Map_AddMapToList(char *name)
 {
@@ -74,6 +90,18 @@ static void Map_AddMapToList(char *name)
 	mapslist[maps_cnt] = G_Alloc(l);		// alloc mem
 	strlcpy(mapslist[maps_cnt], name, l);	// copy
 
+	if (!GetMapNum(name))
+	{
+		unsigned int slot = MapNameHash(name, MAPS_HASH);
+
+		while (mapslist_hash[slot])
+		{
+			slot = (slot + 1) & (MAPS_HASH - 1);
+		}
+
+		mapslist_hash[slot] = maps_cnt + 1;
+	}
+
 	maps_cnt++;
 }
 
@@ -371,18 +399,18 @@ char* GetMapName(int imp)
 
 int GetMapNum(char *map)
 {
-	int i;
+	unsigned int slot;
 
 	if (strnull(map))
 	{
 		return 0;
 	}
 
-	for (i = 0; i < maps_cnt; i++)
+	for (slot = MapNameHash(map, MAPS_HASH); mapslist_hash[slot]; slot = (slot + 1) & (MAPS_HASH - 1))
 	{
-		if (streq(mapslist[i], map))
+		if (streq(mapslist[mapslist_hash[slot] - 1], map))
 		{
-			return (i + 1);
+			return mapslist_hash[slot];
 		}
 	}
 
@@ -549,32 +577,151 @@ void ShowMaps(void)
 	}
 }
 
-int IsMapInCycle(char *map)
+//===============================================
+// map pool: the k_ml_* rotation and its k_ml_minp_/k_ml_maxp_ player bounds,
+// read from cvars once (after game init or on mappool_reload) instead of on every lookup
+
+#define MAP_POOL_MAX	1000
+#define MAP_POOL_HASH	2048	// must be power of two
+
+typedef struct map_pool_entry_s
+{
+	char name[64];
+	int minp;
+	int maxp;
+} map_pool_entry_t;
+
+static map_pool_entry_t map_pool[MAP_POOL_MAX];
+static int map_pool_cnt;
+static short map_pool_hash[MAP_POOL_HASH];	// index + 1 of the first entry with that name, 0 = empty
+static short map_pool_eligible[MAX_CLIENTS + 1][MAP_POOL_MAX];	// entries allowed per player count
+static short map_pool_eligible_cnt[MAX_CLIENTS + 1];
+static qbool map_pool_loaded;
+
+void MapPoolReset(void)
+{
+	map_pool_loaded = false;
+}
+
+void MapPoolReload(void)
 {
-	char newmap[128] =
-		{ 0 }, mapid[128] =
+	char mapid[128] =
 		{ 0 };
-	int i;
+	unsigned int slot;
+	int n;
 
-	if (strnull(map))
+	memset(map_pool_hash, 0, sizeof(map_pool_hash));
+	memset(map_pool_eligible_cnt, 0, sizeof(map_pool_eligible_cnt));
+
+	for (map_pool_cnt = 0; map_pool_cnt < MAP_POOL_MAX; map_pool_cnt++)
 	{
-		return 0;
+		map_pool_entry_t *e = &map_pool[map_pool_cnt];
+
+		snprintf(mapid, sizeof(mapid), "k_ml_%d", map_pool_cnt);
+		trap_cvar_string(mapid, e->name, sizeof(e->name));
+
+		if (strnull(e->name)) // end of list
+		{
+			break;
+		}
+
+		e->maxp = cvar(va("k_ml_maxp_%d", map_pool_cnt));
+		e->maxp = e->maxp == 0 ? MAX_CLIENTS : e->maxp;
+		e->minp = cvar(va("k_ml_minp_%d", map_pool_cnt));
+
+		for (slot = MapNameHash(e->name, MAP_POOL_HASH); map_pool_hash[slot]; slot = (slot + 1) & (MAP_POOL_HASH - 1))
+		{
+			if (streq(map_pool[map_pool_hash[slot] - 1].name, e->name))
+			{
+				break;
+			}
+		}
+
+		if (!map_pool_hash[slot])
+		{
+			map_pool_hash[slot] = map_pool_cnt + 1;
+		}
+
+		for (n = 0; n <= MAX_CLIENTS; n++)
+		{
+			if ((e->maxp >= n) && (n >= e->minp))
+			{
+				map_pool_eligible[n][map_pool_eligible_cnt[n]++] = map_pool_cnt;
+			}
+		}
 	}
 
-	for (i = 0; i < 1000; i++)
+	map_pool_loaded = true;
+}
+
+static void MapPoolLoad(void)
+{
+	if (!map_pool_loaded)
 	{
-		snprintf(mapid, sizeof(mapid), "k_ml_%d", i);
-		// huge for(), so using trap version instead of lazy but unsafe cvar_string()
-		trap_cvar_string(mapid, newmap, sizeof(newmap));
+		MapPoolReload();
+	}
+}
 
-		if (strnull(newmap)) // end of list
+// first entry at or after 'from' that allows 'players', -1 if none
+static int MapPoolNextEligible(int from, int players)
+{
+	short *list;
+	int lo = 0, hi;
+
+	players = bound(0, players, MAX_CLIENTS);
+	list = map_pool_eligible[players];
+	hi = map_pool_eligible_cnt[players];
+
+	while (lo < hi)
+	{
+		int mid = (lo + hi) / 2;
+
+		if (list[mid] < from)
+		{
+			lo = mid + 1;
+		}
+		else
 		{
-			return 0;
+			hi = mid;
 		}
+	}
+
+	return (lo < map_pool_eligible_cnt[players] ? list[lo] : -1);
+}
+
+void MapPoolReloadCmd(void)
+{
+	int i;
 
-		if (streq(map, newmap)) // ok map found in map list
+	MapPoolReload();
+
+	for (i = 0; i < map_pool_cnt; i++)
+	{
+		if (!GetMapNum(map_pool[i].name))
 		{
-			return (i + 1); // i may be 0, so returning i + 1
+			G_sprint(self, 2, "k_ml_%d: %s not found on server\n", i, map_pool[i].name);
+		}
+	}
+
+	G_sprint(self, 2, "map pool: %d maps\n", map_pool_cnt);
+}
+
+int IsMapInCycle(char *map)
+{
+	unsigned int slot;
+
+	if (strnull(map))
+	{
+		return 0;
+	}
+
+	MapPoolLoad();
+
+	for (slot = MapNameHash(map, MAP_POOL_HASH); map_pool_hash[slot]; slot = (slot + 1) & (MAP_POOL_HASH - 1))
+	{
+		if (streq(map_pool[map_pool_hash[slot] - 1].name, map)) // ok map found in map list
+		{
+			return map_pool_hash[slot]; // index may be 0, so returning index + 1
 		}
 	}
 
@@ -583,34 +730,26 @@ int IsMapInCycle(char *map)
 
 char* SelectRandomMap(char *buf, int buf_size)
 {
-	char newmap[128] =
-		{ 0 }, mapid[128] =
-		{ 0 };
+	int players = bound(0, CountPlayers(), MAX_CLIENTS);
 	int cnt, c;
 
 	buf[0] = 0;
 
-	// find how much maps in pool.
-	for (cnt = 0; cnt < 1000; cnt++)
-	{
-		snprintf(mapid, sizeof(mapid), "k_ml_%d", cnt);
-		// huge for(), so using trap version instead of lazy but unsafe cvar_string()
-		trap_cvar_string(mapid, newmap, sizeof(newmap));
+	MapPoolLoad();
 
-		if (strnull(newmap)) // end of list
-		{
-			break;
-		}
+	// pick among the maps allowed for this many players, any map if there are none
+	cnt = map_pool_eligible_cnt[players] ? map_pool_eligible_cnt[players] : map_pool_cnt;
+	if (!cnt)
+	{
+		return buf;
 	}
 
 	// few attempts, to minimize selecting current map.
 	for (c = 0; c < 5; c++)
 	{
 		int id = i_rnd(0, cnt - 1); // generate random id
-
-		// get map.
-		snprintf(mapid, sizeof(mapid), "k_ml_%d", id);
-		trap_cvar_string(mapid, newmap, sizeof(newmap));
+		char *newmap =
+				map_pool[map_pool_eligible_cnt[players] ? map_pool_eligible[players][id] : id].name;
 
 		if (streq(mapname, newmap))
 		{
@@ -633,10 +772,7 @@ char* SelectRandomMap(char *buf, int buf_size)
 
 char* SelectMapInCycle(char *buf, int buf_size)
 {
-	char newmap[128] =
-		{ 0 }, mapid[128] =
-		{ 0 };
-	int player_count = CountPlayers(), maxp = 0, minp = 0, i;
+	int player_count = CountPlayers(), i, next;
 
 	buf[0] = 0;
 
@@ -648,6 +784,13 @@ char* SelectMapInCycle(char *buf, int buf_size)
 		}
 	}
 
+	MapPoolLoad();
+
+	if (!map_pool_cnt)
+	{
+		return buf;
+	}
+
 	if (!(i = cvar("_k_last_cycle_map")))
 	{
 		if (!(i = IsMapInCycle(mapname)))
@@ -656,39 +799,27 @@ char* SelectMapInCycle(char *buf, int buf_size)
 		}
 	}
 
-	while (i < 1000)
+	next = MapPoolNextEligible(i, player_count);
+	for (; i < (next < 0 ? map_pool_cnt : next); i++)
 	{
-		maxp = cvar(va("k_ml_maxp_%d", i >= 1000 ? 0 : i));
-		maxp = maxp == 0 ? MAX_CLIENTS : maxp;
-		minp = cvar(va("k_ml_minp_%d", i >= 1000 ? 0 : i));
-
-		if ((maxp >= player_count) && (player_count >= minp))
-		{
-			snprintf(mapid, sizeof(mapid), "k_ml_%d", i >= 1000 ? 0 : i);
-			trap_cvar_string(mapid, newmap, sizeof(newmap));
-			break;
-		}
-		else
-		{
-			G_bprint(
-					2,
-					"Player requirements not met for map #%d in the map cycle, continuing to next map. (Minimum: %d, Maximum: %d)\n",
-					(i + 1), minp, maxp);
-		}
-		i++;
+		G_bprint(
+				2,
+				"Player requirements not met for map #%d in the map cycle, continuing to next map. (Minimum: %d, Maximum: %d)\n",
+				(i + 1), map_pool[i].minp, map_pool[i].maxp);
 	}
 
-	if (strnull(newmap)) // last resort, trying get first entry in map list
+	if (next < 0) // end of list, start over from the first suitable entry
 	{
-		trap_cvar_string("k_ml_0", newmap, sizeof(newmap));
+		next = MapPoolNextEligible(0, player_count);
 	}
 
-	strlcpy(buf, newmap, buf_size);
-
-	if ((i = IsMapInCycle(buf)))
+	if (next < 0) // last resort, first entry in map list
 	{
-		cvar_fset("_k_last_cycle_map", i);
+		next = 0;
 	}
 
+	strlcpy(buf, map_pool[next].name, buf_size);
+	cvar_fset("_k_last_cycle_map", next + 1);
+
 	return buf;
 }
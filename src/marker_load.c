@@ -363,234 +363,208 @@ void SetMarkerViewOffset(int marker, float zOffset)
 	markers[marker]->s.v.view_ofs[2] = zOffset;
 }
 
-qbool LoadBotRoutingFromFile(void)
+// .bot commands as stored in the map bundle
+typedef enum
 {
-	fileHandle_t file = -1;
-	char lineData[128];
-	char argument[128];
+	brCreateMarker = 1,
+	brSetGoal,
+	brSetZone,
+	brSetMarkerPath,
+	brSetMarkerPathFlags,
+	brSetMarkerFlag,
+	brSetMarkerViewOfs,
+	brSetMarkerPathAngleHint,
+	brSetMapDeathHeight,
+	brSetRocketJumpPathFields
+} botRouteOp_t;
+
+typedef union bot_route_arg_u
+{
+	int i;
+	float f;
+} bot_route_arg_t;
 
-	// Load bot definition file: frogbots rely on objects spawning 
-	//    markers, so be aware of alternative .ent files
-	char *entityFile = cvar_string("k_entityfile");
-	if (!strnull(entityFile))
-	{
-		file = std_fropen("maps/%s.bot", entityFile);
-		if (file == -1)
-		{
-			file = std_fropen("bots/maps/%s.bot", entityFile);
-		}
-	}
+typedef struct bot_route_cmd_s
+{
+	int op;
+	bot_route_arg_t args[5];
+} bot_route_cmd_t;
 
-	if (file == -1)
-	{
-		file = std_fropen("maps/%s.bot", mapname);
-		if (file == -1)
-		{
-			file = std_fropen("bots/maps/%s.bot", mapname);
-		}
-	}
+// Decodes the tokenized line into cmd, false if the line should be skipped
+static qbool ParseBotRouteCommand(bot_route_cmd_t *cmd)
+{
+	static const struct
+	{
+		char *name;
+		botRouteOp_t op;
+		int argc;
+		char *types;	// i = int, f = float, p = path flags, m = marker flags
+	} commands[] =
+	{
+		{ "CreateMarker", brCreateMarker, 4, "fff" },
+		{ "SetGoal", brSetGoal, 3, "ii" },
+		{ "SetZone", brSetZone, 3, "ii" },
+		{ "SetMarkerPath", brSetMarkerPath, 4, "iii" },
+		{ "SetMarkerPathFlags", brSetMarkerPathFlags, 4, "iip" },
+		{ "SetMarkerFlag", brSetMarkerFlag, 3, "im" },
+		{ "SetMarkerViewOfs", brSetMarkerViewOfs, 3, "if" },
+		{ "SetMarkerPathAngleHint", brSetMarkerPathAngleHint, 4, "iii" },
+		{ "SetMapDeathHeight", brSetMapDeathHeight, 2, "i" },
+		{ "SetRocketJumpPathFields", brSetRocketJumpPathFields, 6, "iiffi" },
+	};
+	char argument[128];
+	int i, j;
+
+	trap_CmdArgv(0, argument, sizeof(argument));
 
-	if (file == -1)
+	if (strnull(argument) || ((argument[0] == '/') && (argument[1] == '/')))
 	{
 		return false;
 	}
 
-	while (std_fgets(file, lineData, sizeof(lineData)))
+	for (i = 0; i < sizeof(commands) / sizeof(commands[0]); ++i)
 	{
-		trap_CmdTokenize(lineData);
-
-		trap_CmdArgv(0, argument, sizeof(argument));
-
-		if (strnull(argument) || ((argument[0] == '/') && (argument[1] == '/')))
+		if (strneq(argument, commands[i].name))
 		{
 			continue;
 		}
 
-		if (streq(argument, "CreateMarker"))
+		if (trap_CmdArgc() != commands[i].argc)
 		{
-			// CreateMarker %f %f %f
-			float x, y, z;
-
-			if (trap_CmdArgc() != 4)
-			{
-				continue;
-			}
-
-			trap_CmdArgv(1, argument, sizeof(argument));
-			x = atof(argument);
-			trap_CmdArgv(2, argument, sizeof(argument));
-			y = atof(argument);
-			trap_CmdArgv(3, argument, sizeof(argument));
-			z = atof(argument);
-
-			CreateMarker(x, y, z);
+			return false;
 		}
-		else if (streq(argument, "SetGoal"))
-		{
-			// SetGoal %d %d
-			int marker, goal;
-
-			if (trap_CmdArgc() != 3)
-			{
-				continue;
-			}
-
-			trap_CmdArgv(1, argument, sizeof(argument));
-			marker = atoi(argument);
-			trap_CmdArgv(2, argument, sizeof(argument));
-			goal = atoi(argument);
 
-			SetGoal(goal, marker);
-		}
-		else if (streq(argument, "SetZone"))
+		memset(cmd, 0, sizeof(*cmd));
+		cmd->op = commands[i].op;
+		for (j = 0; commands[i].types[j]; ++j)
 		{
-			// SetZone %d %d
-			int marker, zone;
+			trap_CmdArgv(j + 1, argument, sizeof(argument));
 
-			if (trap_CmdArgc() != 3)
+			switch (commands[i].types[j])
 			{
-				continue;
+				case 'f':
+					cmd->args[j].f = atof(argument);
+					break;
+				case 'p':
+					cmd->args[j].i = DecodeMarkerPathFlagString(argument);
+					break;
+				case 'm':
+					cmd->args[j].i = DecodeMarkerFlagString(argument);
+					break;
+				default:
+					cmd->args[j].i = atoi(argument);
+					break;
 			}
-
-			trap_CmdArgv(1, argument, sizeof(argument));
-			marker = atoi(argument);
-			trap_CmdArgv(2, argument, sizeof(argument));
-			zone = atoi(argument);
-
-			SetZone(zone, marker);
 		}
-		else if (streq(argument, "SetMarkerPath"))
-		{
-			// SetMarkerPath %d %d %d
-			int source_marker, path_number, next_marker;
-
-			if (trap_CmdArgc() != 4)
-			{
-				continue;
-			}
 
-			trap_CmdArgv(1, argument, sizeof(argument));
-			source_marker = atoi(argument);
-			trap_CmdArgv(2, argument, sizeof(argument));
-			path_number = atoi(argument);
-			trap_CmdArgv(3, argument, sizeof(argument));
-			next_marker = atoi(argument);
+		return true;
+	}
 
-			SetMarkerPath(source_marker, path_number, next_marker);
-		}
-		else if (streq(argument, "SetMarkerPathFlags"))
-		{
-			// SetMarkerPathFlags %d %d %s
-			int source_marker, path_number, path_flags;
+	return false;
+}
 
-			if (trap_CmdArgc() != 4)
-			{
-				continue;
-			}
+static void ApplyBotRouteCommand(bot_route_cmd_t *cmd)
+{
+	bot_route_arg_t *arg = cmd->args;
+
+	switch (cmd->op)
+	{
+		case brCreateMarker:
+			CreateMarker(arg[0].f, arg[1].f, arg[2].f);
+			break;
+		case brSetGoal:
+			SetGoal(arg[1].i, arg[0].i);
+			break;
+		case brSetZone:
+			SetZone(arg[1].i, arg[0].i);
+			break;
+		case brSetMarkerPath:
+			SetMarkerPath(arg[0].i, arg[1].i, arg[2].i);
+			break;
+		case brSetMarkerPathFlags:
+			SetMarkerPathFlags(arg[0].i, arg[1].i, arg[2].i);
+			break;
+		case brSetMarkerFlag:
+			SetMarkerFlag(arg[0].i, arg[1].i);
+			break;
+		case brSetMarkerViewOfs:
+			SetMarkerViewOffset(arg[0].i, arg[1].f);
+			break;
+		case brSetMarkerPathAngleHint:
+			SetMarkerAngleHint(arg[0].i, arg[1].i, arg[2].i);
+			break;
+		case brSetMapDeathHeight:
+			mapDeathHeight = arg[0].i;
+			G_Printf("Set death height to %d\n", mapDeathHeight);
+			break;
+		case brSetRocketJumpPathFields:
+			BotSetRocketJumpFields(arg[0].i, arg[1].i, arg[2].f, arg[3].f, arg[4].i);
+			break;
+		default:
+			break;
+	}
+}
 
-			trap_CmdArgv(1, argument, sizeof(argument));
-			source_marker = atoi(argument);
-			trap_CmdArgv(2, argument, sizeof(argument));
-			path_number = atoi(argument);
-			trap_CmdArgv(3, argument, sizeof(argument));
-			path_flags = DecodeMarkerPathFlagString(argument);
+qbool LoadBotRoutingFromFile(void)
+{
+	char *text = NULL;
+	char lineData[128];
+	bot_route_cmd_t *cached;
+	bot_route_cmd_t cmd;
+	int size = 0;
+	int i;
 
-			SetMarkerPathFlags(source_marker, path_number, path_flags);
-		}
-		else if (streq(argument, "SetMarkerFlag"))
+	// Load bot definition file: frogbots rely on objects spawning 
+	//    markers, so be aware of alternative .ent files
+	char *entityFile = cvar_string("k_entityfile");
+	if (!strnull(entityFile))
+	{
+		text = MapBundleOpenSource("maps/%s.bot", entityFile);
+		if (text == NULL)
 		{
-			// SetMarkerFlag %d %s
-			int source_marker, marker_flags;
-
-			if (trap_CmdArgc() != 3)
-			{
-				continue;
-			}
-
-			trap_CmdArgv(1, argument, sizeof(argument));
-			source_marker = atoi(argument);
-			trap_CmdArgv(2, argument, sizeof(argument));
-			marker_flags = DecodeMarkerFlagString(argument);
-
-			SetMarkerFlag(source_marker, marker_flags);
+			text = MapBundleOpenSource("bots/maps/%s.bot", entityFile);
 		}
-		else if (streq(argument, "SetMarkerViewOfs"))
-		{
-			// SetMarkerViewOfs %d %f
-			int source_marker;
-			float offset;
+	}
 
-			if (trap_CmdArgc() != 3)
-			{
-				continue;
-			}
+	if (text == NULL)
+	{
+		text = MapBundleOpenSource("maps/%s.bot", mapname);
+		if (text == NULL)
+		{
+			text = MapBundleOpenSource("bots/maps/%s.bot", mapname);
+		}
+	}
 
-			trap_CmdArgv(1, argument, sizeof(argument));
-			source_marker = atoi(argument);
-			trap_CmdArgv(2, argument, sizeof(argument));
-			offset = atof(argument);
+	if (text == NULL)
+	{
+		return false;
+	}
 
-			SetMarkerViewOffset(source_marker, offset);
-		}
-		else if (streq(argument, "SetMarkerPathAngleHint"))
+	// Same file as last time: replay the already parsed commands
+	if ((cached = MapBundleSection(mbsBotRoutes, &size)))
+	{
+		for (i = 0; i < size / (int)sizeof(bot_route_cmd_t); ++i)
 		{
-			int source_marker;
-			int path_number;
-			int hint;
+			ApplyBotRouteCommand(&cached[i]);
+		}
 
-			if (trap_CmdArgc() != 4)
-			{
-				continue;
-			}
+		return true;
+	}
 
-			trap_CmdArgv(1, argument, sizeof(argument));
-			source_marker = atoi(argument);
-			trap_CmdArgv(2, argument, sizeof(argument));
-			path_number = atoi(argument);
-			trap_CmdArgv(3, argument, sizeof(argument));
-			hint = atoi(argument);
+	MapBundleBegin(mbsBotRoutes);
 
-			SetMarkerAngleHint(source_marker, path_number, hint);
-		}
-		else if (streq(argument, "SetMapDeathHeight"))
-		{
-			if (trap_CmdArgc() != 2)
-			{
-				continue;
-			}
+	while (MapBundleNextLine(&text, lineData, sizeof(lineData)))
+	{
+		trap_CmdTokenize(lineData);
 
-			trap_CmdArgv(1, argument, sizeof(argument));
-			mapDeathHeight = atoi(argument);
-			G_Printf("Set death height to %d\n", mapDeathHeight);
-		}
-		else if (streq(argument, "SetRocketJumpPathFields"))
+		if (ParseBotRouteCommand(&cmd))
 		{
-			int marker_number;
-			int path_number;
-			float pitch, yaw;
-			int delay;
-
-			if (trap_CmdArgc() != 6)
-			{
-				continue;
-			}
-
-			trap_CmdArgv(1, argument, sizeof(argument));
-			marker_number = atoi(argument);
-			trap_CmdArgv(2, argument, sizeof(argument));
-			path_number = atoi(argument);
-			trap_CmdArgv(3, argument, sizeof(argument));
-			pitch = atof(argument);
-			trap_CmdArgv(4, argument, sizeof(argument));
-			yaw = atof(argument);
-			trap_CmdArgv(5, argument, sizeof(argument));
-			delay = atoi(argument);
-
-			BotSetRocketJumpFields(marker_number, path_number, pitch, yaw, delay);
+			ApplyBotRouteCommand(&cmd);
+			MapBundleAppend(&cmd, sizeof(cmd));
 		}
 	}
 
-	std_fclose(file);
+	MapBundleCommit();
 
 	return true;
 }
@@ -0,0 +1,110 @@
+/*
+ marker_pvs.c
+
+ Which markers can possibly see each other, so SightMarkerQuery() can skip its traces.
+ A pair is traced between the eye points SightMarkerQuery() uses the first time it is asked
+ about, and kept until the routes are loaded again. It counts as visible if the line is clear
+ or only blocked by a door, plat or other mover, so only the world itself hides a pair.
+ Only MARKER_PVS_BUDGET new pairs are traced a frame, later ones are reported visible.
+ Entities are not answered from the markers they touch, a marker box is far bigger than
+ what one line between two points can speak for.
+ */
+
+#ifdef BOT_SUPPORT
+
+#include "g_local.h"
+
+#define MARKER_PVS_WORDS	((NUMBER_MARKERS + 31) / 32)
+#define MARKER_PVS_BUDGET	8
+
+// FIXME: globals
+extern gedict_t *markers[];
+
+static unsigned int pvs_known[NUMBER_MARKERS][MARKER_PVS_WORDS];
+static unsigned int pvs_visible[NUMBER_MARKERS][MARKER_PVS_WORDS];
+static int pvs_framecount;
+static int pvs_traced;
+
+void MarkerPVSReset(void)
+{
+	memset(pvs_known, 0, sizeof(pvs_known));
+	memset(pvs_visible, 0, sizeof(pvs_visible));
+	pvs_traced = 0;
+}
+
+static int MarkerPVSIndex(gedict_t *marker)
+{
+	int i;
+
+	if (!marker || !marker->fb.fl_marker)
+	{
+		return -1;
+	}
+
+	i = marker->fb.index;
+
+	return ((i >= 0) && (i < NUMBER_MARKERS) && (markers[i] == marker)) ? i : -1;
+}
+
+// eye height above the middle, as SightMarkerQuery() traces
+static void MarkerPVSPoint(gedict_t *marker, vec3_t point)
+{
+	VectorAdd(marker->s.v.absmin, marker->s.v.view_ofs, point);
+	point[2] += 32;
+}
+
+static qbool MarkerPVSTrace(gedict_t *from, gedict_t *to)
+{
+	vec3_t from_point, to_point;
+
+	MarkerPVSPoint(from, from_point);
+	MarkerPVSPoint(to, to_point);
+
+	traceline(PASSVEC3(to_point), PASSVEC3(from_point), true, world);
+
+	return ((g_globalvars.trace_fraction == 1) || (g_globalvars.trace_ent != EDICT_TO_PROG(world)));
+}
+
+// False only when the world blocks the line between the eye points of the markers
+qbool MarkersMaySee(gedict_t *from, gedict_t *to)
+{
+	int a = MarkerPVSIndex(from);
+	int b = MarkerPVSIndex(to);
+	qbool visible;
+
+	if ((a < 0) || (b < 0) || (a == b) || FrogbotOptionEnabled(FB_OPTION_EDITOR_MODE))
+	{
+		return true;
+	}
+
+	if (pvs_known[a][b >> 5] & (1u << (b & 31)))
+	{
+		return (pvs_visible[a][b >> 5] & (1u << (b & 31))) != 0;
+	}
+
+	if (pvs_framecount != framecount)
+	{
+		pvs_framecount = framecount;
+		pvs_traced = 0;
+	}
+
+	if (pvs_traced >= MARKER_PVS_BUDGET)
+	{
+		return true;
+	}
+
+	pvs_traced++;
+	visible = MarkerPVSTrace(from, to);
+
+	pvs_known[a][b >> 5] |= (1u << (b & 31));
+	pvs_known[b][a >> 5] |= (1u << (a & 31));
+	if (visible)
+	{
+		pvs_visible[a][b >> 5] |= (1u << (b & 31));
+		pvs_visible[b][a >> 5] |= (1u << (a & 31));
+	}
+
+	return visible;
+}
+
+#endif
@@ -99,6 +99,8 @@ gedict_t* LocateNextMarker(vec3_t org, gedict_t *ignore_ent)
 	float distance = 0;
 	float min_distance = 0;
 	float max_distance = editor_mode ? 100 : 1000;
+	gedict_t **list;
+	int i, count;
 
 	if (ignore_ent)
 	{
@@ -107,8 +109,11 @@ gedict_t* LocateNextMarker(vec3_t org, gedict_t *ignore_ent)
 		min_distance = VectorDistance(marker_center, org);
 	}
 
-	for (marker_ = world; (marker_ = trap_findradius(marker_, org, max_distance));)
+	count = G_FindRadius(org, max_distance, 0, NULL, &list);
+	for (i = 0; i < count; i++)
 	{
+		marker_ = list[i];
+
 		if (marker_ == ignore_ent)
 		{
 			ignore_ent = NULL;
@@ -156,6 +161,8 @@ gedict_t* LocateNextMarker(vec3_t org, gedict_t *ignore_ent)
 		}
 	}
 
+	G_SpatialRelease(count);
+
 	return closest_marker;
 }
 
@@ -911,6 +911,11 @@ static void SM_PrepareClients(void)
 
 	initial_match_spawns = true;
 
+	if (!hoonymode_reset)
+	{
+		TimelineReset();
+	}
+
 	for (p = world; (p = find_plr(p));)
 	{
 		players[player_count++] = p;
@@ -509,31 +509,40 @@ void make_bubbles(void)
 {
 	gedict_t *bubble;
 
-	bubble = spawn();
-	setmodel(bubble, "progs/s_bubble.spr");
-	setorigin(bubble, PASSVEC3(self->s.v.origin));
-	bubble->s.v.movetype = MOVETYPE_NOCLIP;
-	bubble->s.v.solid = SOLID_NOT;
+	bubble = FxSpawn();
+	if (bubble)
+	{
+		setmodel(bubble, "progs/s_bubble.spr");
+		setorigin(bubble, PASSVEC3(self->s.v.origin));
+		bubble->s.v.movetype = MOVETYPE_NOCLIP;
+		bubble->s.v.solid = SOLID_NOT;
 
-	SetVector(bubble->s.v.velocity, 0, 0, 15);
-	bubble->s.v.nextthink = g_globalvars.time + 0.5;
-	bubble->think = (func_t) bubble_bob;
-	bubble->touch = (func_t) bubble_remove;
-	bubble->classname = "bubble";
-	bubble->s.v.frame = 0;
-	bubble->cnt = 0;
+		SetVector(bubble->s.v.velocity, 0, 0, 15);
+		bubble->s.v.nextthink = g_globalvars.time + 0.5;
+		bubble->think = (func_t) bubble_bob;
+		bubble->touch = (func_t) bubble_remove;
+		bubble->classname = "bubble";
+		bubble->s.v.frame = 0;
+		bubble->cnt = 0;
 
-	setsize(bubble, -8, -8, -8, 8, 8, 8);
+		setsize(bubble, -8, -8, -8, 8, 8, 8);
+	}
 
 	self->s.v.nextthink = g_globalvars.time + g_random() + 0.5;
 	self->think = (func_t) make_bubbles;
 }
 
-void bubble_split(void)
+// returns true if self was removed
+qbool bubble_split(void)
 {
 	gedict_t *bubble;
 
-	bubble = spawn();
+	bubble = FxSpawn();
+	if (!bubble)
+	{
+		return false;
+	}
+
 	setmodel(bubble, "progs/s_bubble.spr");
 	setorigin(bubble, PASSVEC3(self->s.v.origin));
 
@@ -557,7 +566,11 @@ void bubble_split(void)
 	if (self->s.v.waterlevel != 3)
 	{
 		ent_remove(self);
+
+		return true;
 	}
+
+	return false;
 }
 
 void bubble_remove(void)
@@ -580,12 +593,17 @@ void bubble_bob(void)
 	self->cnt = self->cnt + 1;
 	if (self->cnt == 4)
 	{
-		bubble_split();
+		if (bubble_split())
+		{
+			return;
+		}
 	}
 
 	if (self->cnt == 20)
 	{
 		ent_remove(self);
+
+		return; // pooled bubbles are not freed, don't make it think again
 	}
 
 	rnd1 = self->s.v.velocity[0] + (-10 + (g_random() * 20));
@@ -886,27 +886,32 @@ void DeathBubblesSpawn(void)
 
 	if (PROG_TO_EDICT(self->s.v.owner)->s.v.waterlevel != 3)
 	{
+		ent_remove(self); // spawner would never think again
+
 		return;
 	}
 
-	bubble = spawn();
-	setmodel(bubble, "progs/s_bubble.spr");
-	setorigin(bubble, PROG_TO_EDICT(self->s.v.owner)->s.v.origin[0],
-	PROG_TO_EDICT(self->s.v.owner)->s.v.origin[1],
-				PROG_TO_EDICT(self->s.v.owner)->s.v.origin[2] + 24);
+	bubble = FxSpawn();
+	if (bubble)
+	{
+		setmodel(bubble, "progs/s_bubble.spr");
+		setorigin(bubble, PROG_TO_EDICT(self->s.v.owner)->s.v.origin[0],
+		PROG_TO_EDICT(self->s.v.owner)->s.v.origin[1],
+					PROG_TO_EDICT(self->s.v.owner)->s.v.origin[2] + 24);
 
-	bubble->s.v.movetype = MOVETYPE_NOCLIP;
-	bubble->s.v.solid = SOLID_NOT;
+		bubble->s.v.movetype = MOVETYPE_NOCLIP;
+		bubble->s.v.solid = SOLID_NOT;
 
-	SetVector(bubble->s.v.velocity, 0, 0, 15);
+		SetVector(bubble->s.v.velocity, 0, 0, 15);
 
-	bubble->s.v.nextthink = g_globalvars.time + 0.5;
-	bubble->think = (func_t) bubble_bob;
-	bubble->classname = "bubble";
-	bubble->s.v.frame = 0;
-	bubble->cnt = 0;
+		bubble->s.v.nextthink = g_globalvars.time + 0.5;
+		bubble->think = (func_t) bubble_bob;
+		bubble->classname = "bubble";
+		bubble->s.v.frame = 0;
+		bubble->cnt = 0;
 
-	setsize(bubble, -8, -8, -8, 8, 8, 8);
+		setsize(bubble, -8, -8, -8, 8, 8, 8);
+	}
 
 	self->s.v.nextthink = g_globalvars.time + 0.1;
 	self->think = (func_t) DeathBubblesSpawn;
@@ -922,7 +927,12 @@ void DeathBubbles(float num_bubbles)
 {
 	gedict_t *bubble_spawner;
 
-	bubble_spawner = spawn();
+	bubble_spawner = FxSpawn();
+	if (!bubble_spawner)
+	{
+		return;
+	}
+
 	setorigin(bubble_spawner, PASSVEC3(self->s.v.origin));
 
 	bubble_spawner->s.v.movetype = MOVETYPE_NONE;
@@ -1047,7 +1057,12 @@ gedict_t* ThrowGib(char *gibname, float dm)
 	gedict_t *newent;
 	int k_short_gib = cvar("k_short_gib"); // if set - remove faster
 
-	newent = spawn();
+	newent = FxSpawn();
+	if (!newent)
+	{
+		return NULL;
+	}
+
 	VectorCopy(self->s.v.origin, newent->s.v.origin);
 	setmodel(newent, gibname);
 	setsize(newent, 0, 0, 0, 0, 0, 0);
@@ -394,3 +394,85 @@ void Q_strcat(char *dest, int size, const char *src)
 
 	Q_strncpyz(dest + l1, src, size - l1);
 }
+
+// native builds used to ask the engine for these, the QVM still does (g_syscalls.asm)
+#if !defined( Q3_VM ) && (defined( __linux__ ) || defined( _WIN32 ))
+
+/*
+ =============
+ strlcpy
+
+ Copies src into dst of size siz, always terminated unless siz is 0.
+ Returns strlen(src), if that is >= siz the string got truncated.
+ =============
+ */
+size_t strlcpy(char *dst, const char *src, size_t siz)
+{
+	const char *s = src;
+	size_t n = siz;
+
+	if (n)
+	{
+		while (--n)
+		{
+			if ((*dst++ = *s++) == '\0')
+			{
+				return (s - src - 1);
+			}
+		}
+
+		*dst = '\0';
+	}
+
+	while (*s++)
+	{
+	}
+
+	return (s - src - 1);
+}
+
+/*
+ =============
+ strlcat
+
+ Appends src to dst of size siz, always terminated unless dst already fills siz.
+ Returns strlen(src) plus the initial length of dst, at most siz.
+ =============
+ */
+size_t strlcat(char *dst, const char *src, size_t siz)
+{
+	char *d = dst;
+	const char *s = src;
+	size_t n = siz;
+	size_t dlen;
+
+	while (n-- && *d)
+	{
+		d++;
+	}
+
+	dlen = d - dst;
+	n = siz - dlen;
+
+	if (!n)
+	{
+		return (dlen + strlen(s));
+	}
+
+	while (*s)
+	{
+		if (n != 1)
+		{
+			*d++ = *s;
+			n--;
+		}
+
+		s++;
+	}
+
+	*d = '\0';
+
+	return (dlen + (s - src));
+}
+
+#endif
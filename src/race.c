@@ -214,6 +214,23 @@ static const char* race_filename(const char *extension)
 	return filename;
 }
 
+// all routes of the map share one records log
+static const char* race_records_filename(void)
+{
+	static char filename[128];
+
+	if (cvar("k_race_times_per_port"))
+	{
+		snprintf(filename, sizeof(filename), "race/race[%s]_%d.rdb", mapname, get_server_port());
+	}
+	else
+	{
+		snprintf(filename, sizeof(filename), "race/race[%s].rdb", mapname);
+	}
+
+	return filename;
+}
+
 qbool isRACE(void)
 {
 	return (cvar("k_race"));
@@ -521,6 +538,8 @@ void race_init(void)
 	}
 
 	race.rounds = bound(RACE_MIN_MATCH_ROUNDS, cvar(RACE_MATCH_ROUNDS_CVAR), RACE_MAX_MATCH_ROUNDS);
+
+	race_records_reset();
 }
 
 // clean up, so we can start actual match and there will be no some shit around
@@ -1329,6 +1348,35 @@ static void race_end_point_touched(gedict_t *self, gedict_t *other)
 	race_end(other, true, true);
 }
 
+// every legal run goes to records store, not only top scores
+static void race_store_run(gedict_t *racer, int player_num, const char *demoname)
+{
+	raceRecord_t record;
+
+	if (!race.active_route)
+	{
+		return;
+	}
+
+	memset(&record, 0, sizeof(record));
+	record.time = race.currentrace[player_num].time;
+	strlcpy(record.racername, racer->netname, sizeof(record.racername));
+	strlcpy(record.demoname, demoname, sizeof(record.demoname));
+	record.distance = race.currentrace[player_num].distance;
+	record.maxspeed = race.currentrace[player_num].maxspeed;
+	record.avgspeed = race.currentrace[player_num].avgspeed
+			/ max(1, race.currentrace[player_num].avgcount);
+	record.weaponmode = race.weapon;
+	record.startmode = race.falsestart;
+	record.playernumber = player_num;
+	if (!QVMstrftime(record.date, sizeof(record.date), "%Y-%m-%d %H:%M:%S", 0))
+	{
+		record.date[0] = 0; // bad date
+	}
+
+	race_records_add(race.active_route, race.weapon, race.falsestart, &record);
+}
+
 static void race_over(void)
 {
 	char demoFileName[MAX_OSPATH];
@@ -1400,6 +1448,12 @@ static void race_over(void)
 						race.currentrace[player_num].time, timeposition, nameposition);
 		}
 
+		if (!blocked_record)
+		{
+			race_store_run(racer, player_num,
+							(race.race_recording && (timeposition != -1)) ? demoFileName : "");
+		}
+
 		// run time is within top scores range
 		if (timeposition != -1)
 		{
@@ -1884,6 +1938,100 @@ void display_scores(void)
 	}
 }
 
+// full leaderboard from records store, starting at given position
+void display_ranking(void)
+{
+	raceRecord_t record;
+	char arg_1[64] =
+		{ 0 };
+	int i, first = 0;
+	int ranked;
+
+	if (!race_command_checks())
+	{
+		return;
+	}
+
+	if (!race.active_route)
+	{
+		G_sprint(self, 2, "ranking is available for predefined routes only\n");
+
+		return;
+	}
+
+	ranked = race_records_ranked(race.active_route, race.weapon, race.falsestart);
+
+	if (trap_CmdArgc() > 1)
+	{
+		trap_CmdArgv(1, arg_1, sizeof(arg_1));
+		first = bound(0, atoi(arg_1) - 1, max(0, ranked - 1));
+	}
+
+	G_sprint(self, 2, "\n\235\236\236\236\236\237 %s \235\236\236\236\236\237\n", redtext("ranking"));
+	G_sprint(self, 2, "%s players, %s runs\n", dig3(ranked),
+				dig3(race_records_runs(race.active_route, race.weapon, race.falsestart, NULL)));
+	G_sprint(self, 2, "pos.  time      name\n");
+
+	for (i = first; i < first + NUM_BESTSCORES; i++)
+	{
+		if (!race_records_get(race.active_route, race.weapon, race.falsestart, i, &record))
+		{
+			break;
+		}
+
+		G_sprint(self, 2, "%4d %s %07.3f%s  %s\n", i + 1,
+					streq(record.racername, self->netname) ? "\215" : " ", record.time / 1000.0,
+					redtext("s"), record.racername);
+	}
+}
+
+// personal best and rank of the player, self if name is not specified
+void display_personal_best(void)
+{
+	raceRecord_t record;
+	char name[64];
+	int rank;
+
+	if (!race_command_checks())
+	{
+		return;
+	}
+
+	if (!race.active_route)
+	{
+		G_sprint(self, 2, "personal best is available for predefined routes only\n");
+
+		return;
+	}
+
+	if (trap_CmdArgc() > 1)
+	{
+		trap_CmdArgv(1, name, sizeof(name));
+	}
+	else
+	{
+		strlcpy(name, self->netname, sizeof(name));
+	}
+
+	rank = race_records_rank(race.active_route, race.weapon, race.falsestart, name, &record);
+	if (rank < 0)
+	{
+		G_sprint(self, 2, "%s has no runs on this route\n", name);
+
+		return;
+	}
+
+	G_sprint(self, 2, "\n\235\236\236\236\236\237 %s \235\236\236\236\236\237\n",
+				redtext("personal best"));
+	G_sprint(self, 2, "racer: %s\n", record.racername);
+	G_sprint(self, 2, "rank: %s/%s\n", dig3(rank + 1),
+				dig3(race_records_ranked(race.active_route, race.weapon, race.falsestart)));
+	G_sprint(self, 2, "time: %s\n", dig3s("%7.3f%s", record.time / 1000, redtext("s")));
+	G_sprint(self, 2, "runs: %s\n",
+				dig3(race_records_runs(race.active_route, race.weapon, race.falsestart, name)));
+	G_sprint(self, 2, "date: %s\n", redtext(record.date));
+}
+
 void race_display_line(void)
 {
 	int i = 0;
@@ -3557,6 +3705,29 @@ char* race_fgets(char *buf, int limit)
 	return ((c == -1) && (string = buf)) ? NULL : buf;
 }
 
+// fill top scores from records store, returns false if there are no records for current route
+static qbool read_topscores_from_records(void)
+{
+	int i;
+	int ranked = race_records_ranked(race.active_route, race.weapon, race.falsestart);
+
+	if (!ranked)
+	{
+		return false;
+	}
+
+	init_scores();
+	for (i = 0; i < NUM_BESTSCORES && i < ranked; i++)
+	{
+		race_records_get(race.active_route, race.weapon, race.falsestart, i, &race.records[i]);
+	}
+
+	race.top_time = race.records[0].time;
+	strlcpy(race.top_nick, race.records[0].racername, sizeof(race.top_nick));
+
+	return true;
+}
+
 void read_topscores(void)
 {
 	char line[MAX_TXTLEN] =
@@ -3569,6 +3740,12 @@ void read_topscores(void)
 		return;
 	}
 
+	race_records_open(race_records_filename());
+	if (read_topscores_from_records())
+	{
+		return;
+	}
+
 	race_fropen("%s", race_filename("top"));
 	if (race_fhandle >= 0)
 	{
@@ -3613,6 +3790,16 @@ void read_topscores(void)
 
 		race.top_time = race.records[0].time;
 		strlcpy(race.top_nick, race.records[0].racername, sizeof(race.top_nick));
+
+		// records store does not know about this route yet, import old top scores
+		for (cnt = 0; cnt < max && cnt < NUM_BESTSCORES; cnt++)
+		{
+			if (is_valid_record(&race.records[cnt]))
+			{
+				race_records_add(race.active_route, race.weapon, race.falsestart,
+									&race.records[cnt]);
+			}
+		}
 	}
 	else
 	{
@@ -0,0 +1,683 @@
+//
+// race_records.c - persistent race records store
+//
+// Every finished run is appended to a per-map log, one tab separated line per run.
+// The log is parsed once per map into an in-memory index, so top-N, personal best and rank
+// queries for any route/weapon mode/falsestart mode never touch the disk again.
+// When the log is found to contain garbage or more runs than we can keep in memory,
+// it is rewritten (compacted) right after loading.
+//
+
+#include "g_local.h"
+
+#define RDB_FILE_VERSION	1
+#define RDB_MAX_LINE		512
+#define RDB_READ_CHUNK		4096
+
+#define RDB_MAX_RUNS		4096	// runs kept in memory, across all routes of the map
+#define RDB_MAX_KEYS		64		// route/weapon mode/falsestart mode combinations
+#define RDB_MAX_NAMES		1024	// distinct racer names
+#define RDB_MAX_RANKED		256		// ranked players per key
+#define RDB_NAME_HASH		256		// must be power of two
+
+#define RDB_FIELDS			11
+
+typedef struct rdb_run_s
+{
+	float time;
+	float distance;
+	float maxspeed;
+	float avgspeed;
+	int playernumber;
+	short key;
+	short name;
+	char date[24];
+	char demoname[64];
+} rdb_run_t;
+
+typedef struct rdb_key_s
+{
+	int route;
+	int weapon;
+	int falsestart;
+	int runs;						// amount of runs, including not ranked ones
+	int ranked;						// amount of entries in board[]
+	int board[RDB_MAX_RANKED];		// personal best runs, sorted by time
+} rdb_key_t;
+
+typedef struct rdb_name_s
+{
+	char name[64];
+	int next;						// next name in the same hash bucket, -1 if none
+} rdb_name_t;
+
+static rdb_run_t rdb_runs[RDB_MAX_RUNS];
+static int rdb_runs_cnt;
+
+static rdb_key_t rdb_keys[RDB_MAX_KEYS];
+static int rdb_keys_cnt;
+
+static rdb_name_t rdb_names[RDB_MAX_NAMES];
+static int rdb_names_cnt;
+static int rdb_name_buckets[RDB_NAME_HASH];
+
+static char rdb_filename[128];
+static qbool rdb_loaded;
+static qbool rdb_file_exists;			// so we know when header has to be written
+
+// buffered reading, so we do not call trap_FS_ReadFile() for each byte
+static char rdb_chunk[RDB_READ_CHUNK];
+static int rdb_chunk_len;
+static int rdb_chunk_pos;
+
+//============================================
+
+static unsigned int rdb_hash(const char *s)
+{
+	unsigned int h = 5381;
+
+	while (*s)
+	{
+		h = ((h << 5) + h) + (unsigned char)*s++;
+	}
+
+	return h;
+}
+
+static int rdb_name_find(const char *name)
+{
+	int i = rdb_name_buckets[rdb_hash(name) & (RDB_NAME_HASH - 1)];
+
+	for (; i >= 0; i = rdb_names[i].next)
+	{
+		if (streq(rdb_names[i].name, name))
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static int rdb_name_add(const char *name)
+{
+	int i = rdb_name_find(name);
+	unsigned int bucket;
+
+	if (i >= 0)
+	{
+		return i;
+	}
+
+	if (rdb_names_cnt >= RDB_MAX_NAMES)
+	{
+		return -1;
+	}
+
+	bucket = rdb_hash(name) & (RDB_NAME_HASH - 1);
+	i = rdb_names_cnt++;
+	strlcpy(rdb_names[i].name, name, sizeof(rdb_names[i].name));
+	rdb_names[i].next = rdb_name_buckets[bucket];
+	rdb_name_buckets[bucket] = i;
+
+	return i;
+}
+
+static rdb_key_t* rdb_key_find(int route, int weapon, int falsestart, qbool create)
+{
+	rdb_key_t *key;
+	int i;
+
+	for (i = 0; i < rdb_keys_cnt; i++)
+	{
+		key = &rdb_keys[i];
+		if ((key->route == route) && (key->weapon == weapon) && (key->falsestart == falsestart))
+		{
+			return key;
+		}
+	}
+
+	if (!create || (rdb_keys_cnt >= RDB_MAX_KEYS))
+	{
+		return NULL;
+	}
+
+	key = &rdb_keys[rdb_keys_cnt++];
+	memset(key, 0, sizeof(*key));
+	key->route = route;
+	key->weapon = weapon;
+	key->falsestart = falsestart;
+
+	return key;
+}
+
+static void rdb_clear(void)
+{
+	int i;
+
+	rdb_runs_cnt = 0;
+	rdb_keys_cnt = 0;
+	rdb_names_cnt = 0;
+	for (i = 0; i < RDB_NAME_HASH; i++)
+	{
+		rdb_name_buckets[i] = -1;
+	}
+}
+
+// put run on the board of its key if it is personal best of the racer
+static void rdb_board_update(int run_idx)
+{
+	rdb_run_t *run = &rdb_runs[run_idx];
+	rdb_key_t *key = &rdb_keys[run->key];
+	int i, pos;
+
+	for (pos = 0; pos < key->ranked; pos++)
+	{
+		if (rdb_runs[key->board[pos]].name == run->name)
+		{
+			break;
+		}
+	}
+
+	if (pos < key->ranked)
+	{
+		if (rdb_runs[key->board[pos]].time <= run->time)
+		{
+			return; // not a personal best
+		}
+	}
+	else if (key->ranked < RDB_MAX_RANKED)
+	{
+		pos = key->ranked++;
+	}
+	else if (rdb_runs[key->board[key->ranked - 1]].time > run->time)
+	{
+		pos = key->ranked - 1; // board full, push out the slowest
+	}
+	else
+	{
+		return;
+	}
+
+	// move slower runs down until we find our place
+	for (i = pos; i > 0 && rdb_runs[key->board[i - 1]].time > run->time; i--)
+	{
+		key->board[i] = key->board[i - 1];
+	}
+
+	key->board[i] = run_idx;
+}
+
+static void rdb_board_rebuild(void)
+{
+	int i;
+
+	for (i = 0; i < rdb_keys_cnt; i++)
+	{
+		rdb_keys[i].ranked = 0;
+		rdb_keys[i].runs = 0;
+	}
+
+	for (i = 0; i < rdb_runs_cnt; i++)
+	{
+		rdb_keys[rdb_runs[i].key].runs++;
+		rdb_board_update(i);
+	}
+}
+
+// drop runs which are not personal bests, oldest first
+static int rdb_compact_memory(void)
+{
+	static byte keep[RDB_MAX_RUNS];
+	int i, j, kept, drop;
+
+	memset(keep, 0, sizeof(keep));
+	kept = 0;
+	for (i = 0; i < rdb_keys_cnt; i++)
+	{
+		for (j = 0; j < rdb_keys[i].ranked; j++)
+		{
+			keep[rdb_keys[i].board[j]] = 1;
+			kept++;
+		}
+	}
+
+	// free a quarter of the store, if there is enough history to drop
+	drop = rdb_runs_cnt - kept;
+	if (drop > RDB_MAX_RUNS / 4)
+	{
+		drop = RDB_MAX_RUNS / 4;
+	}
+
+	for (i = 0; i < rdb_runs_cnt; i++)
+	{
+		if (!keep[i] && drop <= 0)
+		{
+			keep[i] = 1;
+		}
+		else if (!keep[i])
+		{
+			drop--;
+		}
+	}
+
+	for (i = j = 0; i < rdb_runs_cnt; i++)
+	{
+		if (keep[i])
+		{
+			rdb_runs[j++] = rdb_runs[i];
+		}
+	}
+
+	drop = rdb_runs_cnt - j;
+	rdb_runs_cnt = j;
+	rdb_board_rebuild();
+
+	return drop;
+}
+
+static int rdb_insert(int route, int weapon, int falsestart, raceRecord_t *record, int *dropped)
+{
+	rdb_key_t *key;
+	rdb_run_t *run;
+	int name;
+
+	if (rdb_runs_cnt >= RDB_MAX_RUNS)
+	{
+		*dropped += rdb_compact_memory();
+	}
+
+	key = rdb_key_find(route, weapon, falsestart, true);
+	name = rdb_name_add(record->racername);
+	if (!key || (name < 0) || (rdb_runs_cnt >= RDB_MAX_RUNS))
+	{
+		(*dropped)++;
+
+		return -1;
+	}
+
+	run = &rdb_runs[rdb_runs_cnt];
+	run->time = record->time;
+	run->distance = record->distance;
+	run->maxspeed = record->maxspeed;
+	run->avgspeed = record->avgspeed;
+	run->playernumber = record->playernumber;
+	run->key = key - rdb_keys;
+	run->name = name;
+	strlcpy(run->date, record->date, sizeof(run->date));
+	strlcpy(run->demoname, record->demoname, sizeof(run->demoname));
+
+	key->runs++;
+	rdb_board_update(rdb_runs_cnt);
+
+	return rdb_runs_cnt++;
+}
+
+static void rdb_to_record(int run_idx, int position, raceRecord_t *record)
+{
+	rdb_run_t *run = &rdb_runs[run_idx];
+	rdb_key_t *key = &rdb_keys[run->key];
+
+	memset(record, 0, sizeof(*record));
+	record->time = run->time;
+	strlcpy(record->racername, rdb_names[run->name].name, sizeof(record->racername));
+	strlcpy(record->demoname, run->demoname, sizeof(record->demoname));
+	record->distance = run->distance;
+	record->maxspeed = run->maxspeed;
+	record->avgspeed = run->avgspeed;
+	strlcpy(record->date, run->date, sizeof(record->date));
+	record->weaponmode = key->weapon;
+	record->startmode = key->falsestart;
+	record->playernumber = run->playernumber;
+	record->position = position;
+}
+
+//============================================
+// file I/O
+
+static void rdb_fprintf(fileHandle_t handle, const char *fmt, ...)
+{
+	va_list argptr;
+	char text[RDB_MAX_LINE];
+
+	va_start(argptr, fmt);
+	Q_vsnprintf(text, sizeof(text), fmt, argptr);
+	va_end(argptr);
+
+	text[sizeof(text) - 1] = 0;
+
+	trap_FS_WriteFile(text, strlen(text), handle);
+}
+
+// tabs and new lines would break the line format, replace them
+static const char* rdb_clean(const char *s, char *buf, int size)
+{
+	char *c;
+
+	strlcpy(buf, s, size);
+	for (c = buf; *c; c++)
+	{
+		if ((*c == '\t') || (*c == '\n') || (*c == '\r'))
+		{
+			*c = ' ';
+		}
+	}
+
+	return buf;
+}
+
+static void rdb_write_run(fileHandle_t handle, rdb_run_t *run)
+{
+	rdb_key_t *key = &rdb_keys[run->key];
+	char name[64], demo[64], date[24];
+
+	rdb_fprintf(handle, "%d\t%d\t%d\t%f\t%f\t%f\t%f\t%d\t%s\t%s\t%s\n", key->route, key->weapon,
+				key->falsestart, run->time, run->distance, run->maxspeed, run->avgspeed,
+				run->playernumber, rdb_clean(run->date, date, sizeof(date)),
+				rdb_clean(run->demoname, demo, sizeof(demo)),
+				rdb_clean(rdb_names[run->name].name, name, sizeof(name)));
+}
+
+static void rdb_write_all(void)
+{
+	fileHandle_t handle;
+	int i;
+
+	if (trap_FS_OpenFile(rdb_filename, &handle, FS_WRITE_BIN) < 0)
+	{
+		G_cprint("race records: failed to write %s\n", rdb_filename);
+
+		return;
+	}
+
+	rdb_fprintf(handle, "ktxrdb %d\n", RDB_FILE_VERSION);
+	rdb_file_exists = true;
+	for (i = 0; i < rdb_runs_cnt; i++)
+	{
+		rdb_write_run(handle, &rdb_runs[i]);
+	}
+
+	trap_FS_CloseFile(handle);
+}
+
+static qbool rdb_getline(fileHandle_t handle, char *line, int size)
+{
+	int len = 0;
+	qbool eof = false;
+
+	while (!eof)
+	{
+		if (rdb_chunk_pos >= rdb_chunk_len)
+		{
+			rdb_chunk_len = trap_FS_ReadFile(rdb_chunk, sizeof(rdb_chunk), handle);
+			rdb_chunk_pos = 0;
+			if (rdb_chunk_len <= 0)
+			{
+				rdb_chunk_len = 0;
+				eof = true;
+				continue;
+			}
+		}
+
+		while (rdb_chunk_pos < rdb_chunk_len)
+		{
+			char c = rdb_chunk[rdb_chunk_pos++];
+
+			if (c == '\n')
+			{
+				line[len] = 0;
+
+				return true;
+			}
+
+			if ((c != '\r') && (len < size - 1))
+			{
+				line[len++] = c;
+			}
+		}
+	}
+
+	line[len] = 0;
+
+	return (len > 0);
+}
+
+// split line in place by tabs
+static int rdb_split(char *line, char **fields, int max_fields)
+{
+	int cnt = 0;
+
+	fields[cnt++] = line;
+	for (; *line && cnt < max_fields; line++)
+	{
+		if (*line == '\t')
+		{
+			*line = 0;
+			fields[cnt++] = line + 1;
+		}
+	}
+
+	return cnt;
+}
+
+static qbool rdb_parse_run(char *line, int *route, int *weapon, int *falsestart,
+							raceRecord_t *record)
+{
+	char *fields[RDB_FIELDS];
+
+	if (rdb_split(line, fields, RDB_FIELDS) != RDB_FIELDS || strnull(fields[RDB_FIELDS - 1]))
+	{
+		return false;
+	}
+
+	memset(record, 0, sizeof(*record));
+	*route = atoi(fields[0]);
+	*weapon = atoi(fields[1]);
+	*falsestart = atoi(fields[2]);
+	record->time = atof(fields[3]);
+	record->distance = atof(fields[4]);
+	record->maxspeed = atof(fields[5]);
+	record->avgspeed = atof(fields[6]);
+	record->playernumber = atoi(fields[7]);
+	strlcpy(record->date, fields[8], sizeof(record->date));
+	strlcpy(record->demoname, fields[9], sizeof(record->demoname));
+	strlcpy(record->racername, fields[10], sizeof(record->racername));
+
+	return ((*route > 0) && (record->time > 0));
+}
+
+static void rdb_load(void)
+{
+	static char line[RDB_MAX_LINE];
+	raceRecord_t record;
+	fileHandle_t handle;
+	int route, weapon, falsestart;
+	int dropped = 0;
+
+	rdb_clear();
+	rdb_loaded = true;
+	rdb_file_exists = false;
+
+	if (trap_FS_OpenFile(rdb_filename, &handle, FS_READ_BIN) < 0)
+	{
+		return;
+	}
+
+	rdb_file_exists = true;
+
+	rdb_chunk_len = rdb_chunk_pos = 0;
+
+	if (!rdb_getline(handle, line, sizeof(line)) || strncmp(line, "ktxrdb ", sizeof("ktxrdb ") - 1)
+			|| atoi(line + sizeof("ktxrdb ") - 1) != RDB_FILE_VERSION)
+	{
+		G_cprint("race records: %s has unknown format, ignored\n", rdb_filename);
+		trap_FS_CloseFile(handle);
+
+		return;
+	}
+
+	while (rdb_getline(handle, line, sizeof(line)))
+	{
+		if (!rdb_parse_run(line, &route, &weapon, &falsestart, &record))
+		{
+			dropped++;
+			continue;
+		}
+
+		rdb_insert(route, weapon, falsestart, &record, &dropped);
+	}
+
+	trap_FS_CloseFile(handle);
+
+	if (dropped)
+	{
+		G_cprint("race records: compacting %s, %d entries dropped\n", rdb_filename, dropped);
+		rdb_write_all();
+	}
+}
+
+//============================================
+// public API
+
+// forget everything, next race_records_open() will read the file again
+void race_records_reset(void)
+{
+	rdb_clear();
+	rdb_loaded = false;
+	rdb_filename[0] = 0;
+}
+
+// make sure records from given file are loaded, it is cheap to call it again with the same file
+void race_records_open(const char *filename)
+{
+	if (rdb_loaded && streq(rdb_filename, filename))
+	{
+		return;
+	}
+
+	strlcpy(rdb_filename, filename, sizeof(rdb_filename));
+	rdb_load();
+}
+
+// store finished run, returns its rank for given route/weapon mode/falsestart mode or -1
+int race_records_add(int route, int weapon, int falsestart, raceRecord_t *record)
+{
+	fileHandle_t handle;
+	int dropped = 0;
+	int run_idx;
+
+	if (!rdb_loaded || (route <= 0) || strnull(record->racername))
+	{
+		return -1;
+	}
+
+	run_idx = rdb_insert(route, weapon, falsestart, record, &dropped);
+	if (run_idx < 0)
+	{
+		return -1;
+	}
+
+	if (dropped)
+	{
+		// memory store was compacted, bring the log in line with it
+		rdb_write_all();
+	}
+	else if (trap_FS_OpenFile(rdb_filename, &handle, FS_APPEND_BIN) >= 0)
+	{
+		if (!rdb_file_exists)
+		{
+			rdb_fprintf(handle, "ktxrdb %d\n", RDB_FILE_VERSION);
+			rdb_file_exists = true;
+		}
+
+		rdb_write_run(handle, &rdb_runs[run_idx]);
+		trap_FS_CloseFile(handle);
+	}
+
+	return race_records_rank(route, weapon, falsestart, record->racername, NULL);
+}
+
+// amount of ranked players
+int race_records_ranked(int route, int weapon, int falsestart)
+{
+	rdb_key_t *key = rdb_key_find(route, weapon, falsestart, false);
+
+	return (key ? key->ranked : 0);
+}
+
+// get personal best of the player on given rank, rank is zero based
+qbool race_records_get(int route, int weapon, int falsestart, int rank, raceRecord_t *record)
+{
+	rdb_key_t *key = rdb_key_find(route, weapon, falsestart, false);
+
+	if (!key || (rank < 0) || (rank >= key->ranked))
+	{
+		return false;
+	}
+
+	rdb_to_record(key->board[rank], rank, record);
+
+	return true;
+}
+
+// zero based rank of the player or -1, also fills in personal best if record is not NULL
+int race_records_rank(int route, int weapon, int falsestart, const char *name,
+						raceRecord_t *record)
+{
+	rdb_key_t *key = rdb_key_find(route, weapon, falsestart, false);
+	int name_idx = rdb_name_find(name);
+	int i;
+
+	if (!key || (name_idx < 0))
+	{
+		return -1;
+	}
+
+	for (i = 0; i < key->ranked; i++)
+	{
+		if (rdb_runs[key->board[i]].name == name_idx)
+		{
+			if (record)
+			{
+				rdb_to_record(key->board[i], i, record);
+			}
+
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+// amount of runs player has for given route/weapon mode/falsestart mode, all runs if name is NULL
+int race_records_runs(int route, int weapon, int falsestart, const char *name)
+{
+	rdb_key_t *key = rdb_key_find(route, weapon, falsestart, false);
+	int name_idx;
+	int i, cnt = 0;
+
+	if (!key)
+	{
+		return 0;
+	}
+
+	if (!name)
+	{
+		return key->runs;
+	}
+
+	if ((name_idx = rdb_name_find(name)) < 0)
+	{
+		return 0;
+	}
+
+	for (i = 0; i < rdb_runs_cnt; i++)
+	{
+		if ((rdb_runs[i].name == name_idx) && (&rdb_keys[rdb_runs[i].key] == key))
+		{
+			cnt++;
+		}
+	}
+
+	return cnt;
+}
@@ -659,6 +659,8 @@ void InitialiseMarkerRoutes(void)
 {
 	int i;
 
+	MarkerPVSReset();
+
 	self = dropper;
 	for (i = 0; i < NUMBER_MARKERS; ++i)
 	{
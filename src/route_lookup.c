@@ -97,21 +97,72 @@ gedict_t* ZonePathMarker(gedict_t *from_marker, gedict_t *to_marker, qbool path_
 	return from_marker->fb.zones[to_marker->fb.Z_ - 1].reverse_next;
 }
 
+// Re-entrant equivalent of ZoneMarker() + SubZoneArrivalTime(), results are stored in the query.
+// Unlike ZoneMarker(), a marker without a zone is unreachable: ZoneMarker() leaves the globals
+// of whatever was looked up before, which has no equivalent without shared state.
+float RouteQuery(fb_route_query_t *query)
+{
+	gedict_t *from_marker = query->from_marker;
+	gedict_t *to_marker = query->to_marker;
+	fb_zone_t *zone;
+
+	if ((from_marker == NULL) || (to_marker == NULL) || !to_marker->fb.Z_)
+	{
+		query->middle_marker = dropper;
+		query->zone_time = 1000000;
+		query->traveltime = query->zone_time;
+
+		return query->traveltime;
+	}
+
+	zone = &from_marker->fb.zones[to_marker->fb.Z_ - 1];
+	if (query->path_normal)
+	{
+		query->middle_marker = query->rj_routes ? zone->marker_rj : zone->marker;
+		query->zone_time = query->rj_routes ? zone->rj_time : zone->time;
+	}
+	else
+	{
+		query->middle_marker = zone->reverse_marker;
+		query->zone_time = zone->reverse_time;
+	}
+
+	query->traveltime = SubZoneArrivalTime(query->zone_time, query->middle_marker, to_marker,
+											query->rj_routes);
+
+	return query->traveltime;
+}
+
+float RouteTravelTime(gedict_t *from_marker, gedict_t *to_marker, qbool path_normal,
+						qbool rj_routes)
+{
+	fb_route_query_t query;
+
+	query.from_marker = from_marker;
+	query.to_marker = to_marker;
+	query.path_normal = path_normal;
+	query.rj_routes = rj_routes;
+
+	return RouteQuery(&query);
+}
+
 // This is called when the standard highersight calculation has failed
 // Difference in 'higher' is that they must be on different heights (>=40)
 // Otherwise no difference?
-// from_marker = zone with all markers to be checked, marker->to_marker must be visible, marker must be higher
-gedict_t* SightMarker(gedict_t *from_marker, gedict_t *to_marker, float max_distance,
-						float min_height_diff)
+// query->from_marker = zone with all markers to be checked, marker->to_marker must be visible, marker must be higher
+// query->traveltime is set to the time to reach the returned marker
+gedict_t* SightMarkerQuery(fb_route_query_t *query, float max_distance, float min_height_diff)
 {
+	gedict_t *from_marker = query->from_marker;
+	gedict_t *to_marker = query->to_marker;
 	gedict_t *marker_;
 	vec3_t marker_pos;
 	vec3_t to_marker_pos;
 	gedict_t *look_marker = NULL;
 
-	look_traveltime = 1000000;
-	middle_marker = from_marker;
-	zone_time = 0;
+	query->traveltime = 1000000;
+	query->middle_marker = from_marker;
+	query->zone_time = 0;
 
 	VectorAdd(to_marker->s.v.absmin, to_marker->s.v.view_ofs, to_marker_pos);
 	to_marker_pos[2] += 32;
@@ -129,17 +180,19 @@ gedict_t* SightMarker(gedict_t *from_marker, gedict_t *to_marker, float max_dist
 			if ((max_distance == 0) || VectorDistance(marker_pos, to_marker_pos) <= max_distance)
 			{
 				// Must be able to draw straight line between the two
-				traceline(PASSVEC3(to_marker_pos), PASSVEC3(marker_pos), true, world);
-				if (g_globalvars.trace_fraction == 1)
+				if (MarkersMaySee(marker_, to_marker))
 				{
-					// 
-					traveltime = SubZoneArrivalTime(zone_time, middle_marker, marker_, false);
-					if (look_traveltime > traveltime)
+					traceline(PASSVEC3(to_marker_pos), PASSVEC3(marker_pos), true, world);
+					if (g_globalvars.trace_fraction == 1)
 					{
+						float marker_time = SubZoneArrivalTime(query->zone_time,
+																query->middle_marker, marker_, false);
+
 						// Teleports don't count
-						if (strneq(marker_->classname, "trigger_teleport"))
+						if ((query->traveltime > marker_time)
+								&& strneq(marker_->classname, "trigger_teleport"))
 						{
-							look_traveltime = traveltime;
+							query->traveltime = marker_time;
 							look_marker = marker_;
 						}
 					}
@@ -153,4 +206,22 @@ gedict_t* SightMarker(gedict_t *from_marker, gedict_t *to_marker, float max_dist
 	return look_marker;
 }
 
+// As SightMarkerQuery(), but leaves the result in the path-finding globals
+gedict_t* SightMarker(gedict_t *from_marker, gedict_t *to_marker, float max_distance,
+						float min_height_diff)
+{
+	fb_route_query_t query;
+	gedict_t *marker;
+
+	query.from_marker = from_marker;
+	query.to_marker = to_marker;
+	marker = SightMarkerQuery(&query, max_distance, min_height_diff);
+
+	look_traveltime = query.traveltime;
+	middle_marker = query.middle_marker;
+	zone_time = query.zone_time;
+
+	return marker;
+}
+
 #endif
@@ -199,31 +199,29 @@ void TossRune(void)
 
 	if (self->ctf_flag & CTF_RUNE_RGN)
 	{
-		gedict_t *regenrot = spawn();
 		DoTossRune( CTF_RUNE_RGN);
 		self->ps.rgn_time += g_globalvars.time - self->rune_pickup_time;
-		regenrot->s.v.nextthink = g_globalvars.time + 5;
-		regenrot->think = (func_t) RegenLostRot;
-		regenrot->s.v.owner = EDICT_TO_PROG(self);
+		G_TimerCancel(self->regen_rot_timer);
+		self->regen_rot_timer = G_TimerAdd(g_globalvars.time + 5, RegenLostRot, self);
 	}
 
 	self->ctf_flag -= (self->ctf_flag & (CTF_RUNE_MASK));
 	//self->s.v.items -= ( (int)self->s.v.items & (CTF_RUNE_MASK) );
 }
 
+// timer on the player who tossed the regen rune
 void RegenLostRot(void)
 {
-	other = PROG_TO_EDICT(self->s.v.owner);
-	if ((other->s.v.health < 101) || (other->ctf_flag & CTF_RUNE_RGN)
-			|| ((int)other->s.v.items & IT_SUPERHEALTH))
-	{
-		ent_remove(self);
+	self->regen_rot_timer = 0;
 
+	if ((self->s.v.health < 101) || (self->ctf_flag & CTF_RUNE_RGN)
+			|| ((int)self->s.v.items & IT_SUPERHEALTH))
+	{
 		return;
 	}
 
-	other->s.v.health--;
-	self->s.v.nextthink = g_globalvars.time + 1;
+	self->s.v.health--;
+	self->regen_rot_timer = G_TimerAdd(g_globalvars.time + 1, RegenLostRot, self);
 }
 
 void RuneResetOwner(void)
@@ -341,13 +339,11 @@ char* GetRuneSpawnName(void)
 gedict_t* UniqueRuneSpawn(int rune_type, int nrunes, gedict_t **runes)
 {
 	char *spawnname;
-	int i, nspawns;
+	int i, j, nspawns;
 	qbool unique;
-	gedict_t *e;
 
 	spawnname = GetRuneSpawnName();
-
-	for (e = world, nspawns = 0; (e = ez_find(e, spawnname)); nspawns++);
+	nspawns = SpawnIndexCount(spawnname);
 
 	for (i = 0; i < nspawns; i++)
 	{
@@ -355,9 +351,9 @@ gedict_t* UniqueRuneSpawn(int rune_type, int nrunes, gedict_t **runes)
 
 		unique = true;
 
-		for (i = 0; i < nrunes; i++)
+		for (j = 0; j < nrunes; j++)
 		{
-			if (runes && self == runes[i])
+			if (runes && self == runes[j])
 			{
 				unique = false;
 				break;
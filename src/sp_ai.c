@@ -164,6 +164,88 @@ float infront(gedict_t *targ)
 
 //============================================================================
 
+/*
+ =============
+ monster AI level of detail
+
+ Monsters far from every player run the full AI (target search, sight traces, attack checks)
+ only on every second or fourth think, the other thinks just keep moving towards the goal.
+ The tier is chosen again every half second or so, damage and sighting promote a monster
+ to the near tier at once.
+ =============
+ */
+#define LOD_NEAR		0
+#define LOD_MID			1
+#define LOD_FAR			2
+
+#define LOD_NEAR_DIST	1000
+#define LOD_FAR_DIST	2000
+#define LOD_SEEN_TIME	2		// monster which saw its enemy this recently stays near
+
+static const int lod_interval[] =
+{ 1, 2, 4 };
+
+void MonsterLodWake(gedict_t *m)
+{
+	m->lod_tier = LOD_NEAR;
+	m->lod_seen_time = g_globalvars.time;
+	m->lod_time = g_globalvars.time + LOD_SEEN_TIME;
+}
+
+static void MonsterLodUpdate(void)
+{
+	gedict_t *p;
+	vec3_t d;
+	float dist, best = -1;
+
+	if (self->lod_time > g_globalvars.time)
+	{
+		return;
+	}
+
+	self->lod_time = g_globalvars.time + 0.5 + g_random() * 0.2; // spread the updates over frames
+
+	if (!cvar("k_monster_lod") || (g_globalvars.time - self->lod_seen_time < LOD_SEEN_TIME))
+	{
+		self->lod_tier = LOD_NEAR;
+
+		return;
+	}
+
+	for (p = world; (p = find_plr(p));)
+	{
+		VectorSubtract(p->s.v.origin, self->s.v.origin, d);
+		dist = DotProduct(d, d);
+		if ((best < 0) || (dist < best))
+		{
+			best = dist;
+		}
+	}
+
+	if ((best >= 0) && (best < LOD_NEAR_DIST * LOD_NEAR_DIST))
+	{
+		self->lod_tier = LOD_NEAR;
+	}
+	else if ((best >= 0) && (best < LOD_FAR_DIST * LOD_FAR_DIST))
+	{
+		self->lod_tier = LOD_MID;
+	}
+	else
+	{
+		self->lod_tier = LOD_FAR;
+	}
+}
+
+// true if this think should run the full AI
+static qbool MonsterLodThink(void)
+{
+	MonsterLodUpdate();
+
+	return !(++self->lod_thinks % lod_interval[self->lod_tier]);
+}
+
+//============================================================================
+
 /*
 
  in nightmare mode, all attack_finished times become 0
@@ -297,10 +379,17 @@ void FoundTarget(void)
 
 	self->show_hostile = g_globalvars.time + 1;		// wake up other monsters
 
+	MonsterLodWake(self);
 	SightSound();
 	HuntTarget();
 }
 
+// another monster got angry just now, see the globals above
+static qbool SightEntityActive(void)
+{
+	return (((sight_entity_time + 0.1) >= g_globalvars.time) && !((int)self->s.v.spawnflags & 3));
+}
+
 /*
  ===========
  FindTarget
@@ -328,7 +417,7 @@ float FindTarget(void)
 // spawnflags & 3 is a big hack, because zombie crucified used the first
 // spawn flag prior to the ambush flag, and I forgot about it, so the second
 // spawn flag works as well
-	if (((sight_entity_time + 0.1) >= g_globalvars.time) && !((int)self->s.v.spawnflags & 3))
+	if (SightEntityActive())
 	{
 		client = sight_entity; // NOTE: may be NULL, so be careful
 
@@ -433,6 +522,8 @@ float FindTarget(void)
  */
 void GetMadAtAttacker(gedict_t *attacker)
 {
+	MonsterLodWake(self);
+
 	if (!attacker || (attacker == world))
 	{
 		return; // ignore world attacks
@@ -593,7 +684,7 @@ void ai_walk(float dist)
 	}
 
 	// check for noticing a player
-	if (FindTarget())
+	if ((MonsterLodThink() || SightEntityActive()) && FindTarget())
 	{
 		return;
 	}
@@ -610,7 +701,7 @@ void ai_walk(float dist)
  */
 void ai_stand(void)
 {
-	if (FindTarget())
+	if ((MonsterLodThink() || SightEntityActive()) && FindTarget())
 	{
 		return;
 	}
@@ -638,7 +729,7 @@ void ai_stand(void)
  */
 void ai_turn(void)
 {
-	if (FindTarget())
+	if ((MonsterLodThink() || SightEntityActive()) && FindTarget())
 	{
 		return;
 	}
@@ -965,6 +1056,7 @@ void ai_run_slide(void)
 void ai_run(float dist)
 {
 	vec3_t tmpv;
+	qbool full;
 
 	if (k_bloodfest)
 	{
@@ -1016,15 +1108,28 @@ void ai_run(float dist)
 
 	self->show_hostile = g_globalvars.time + 1;		// wake up other monsters
 
-// check knowledge of enemy
-	enemy_vis = visible(PROG_TO_EDICT(self->s.v.enemy));
+// check knowledge of enemy, far monsters reuse what they saw on the last full think
+	full = MonsterLodThink();
+	if (full)
+	{
+		enemy_vis = self->lod_enemy_vis = visible(PROG_TO_EDICT(self->s.v.enemy));
+		if (enemy_vis)
+		{
+			self->lod_seen_time = g_globalvars.time;
+		}
+	}
+	else
+	{
+		enemy_vis = self->lod_enemy_vis;
+	}
+
 	if (enemy_vis)
 	{
 		self->search_time = g_globalvars.time + 5; // does not search for enemy next 5 seconds
 	}
 
 // look for other coop players
-	if (coop && self->search_time < g_globalvars.time)
+	if (coop && (full || SightEntityActive()) && self->search_time < g_globalvars.time)
 	{
 		if (FindTarget())
 		{
@@ -1059,7 +1164,7 @@ void ai_run(float dist)
 		return;
 	}
 
-	if (CheckAnyAttack())
+	if (full && CheckAnyAttack())
 	{
 		return;					// beginning an attack
 	}
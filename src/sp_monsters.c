@@ -42,6 +42,7 @@ static const float k_bloodfest_boss_chance = -1;// percentage chance of boss spa
 
 // RUNTIME.
 bloodfest_t g_bloodfest;
+static qbool bloodfest_slot_clear;		// spawning into a checked spawn slot, skip the trace.
 
 typedef struct bloodfest_monster_s
 {
@@ -172,7 +173,7 @@ int projectiles_count(void)
 }
 
 // spawn one monster.
-gedict_t* bloodfest_spawn_monster(gedict_t *spot, char *classname)
+gedict_t* bloodfest_spawn_monster(vec3_t origin, vec3_t angles, char *classname)
 {
 	extern qbool G_CallSpawn(gedict_t *ent);
 
@@ -180,8 +181,8 @@ gedict_t* bloodfest_spawn_monster(gedict_t *spot, char *classname)
 	gedict_t *p = spawn();
 
 	p->classname = classname;
-	VectorCopy(spot->s.v.origin, p->s.v.origin);
-	VectorCopy(spot->s.v.angles, p->s.v.angles);
+	VectorCopy(origin, p->s.v.origin);
+	VectorCopy(angles, p->s.v.angles);
 	setorigin(p, PASSVEC3(p->s.v.origin));
 
 	// G_CallSpawn will change 'self', so we have to do trick about it.
@@ -258,11 +259,9 @@ void bloodfest_wave_calculate(void)
 // attempt to spawn more monsters.
 void bloodfest_spawn_monsters(void)
 {
-	gedict_t *spot;
+	spawn_slot_t *slot;
 	gedict_t *p;
-	int total_spawns;
 	int i;
-	intptr_t content;
 
 	// precache: spawn all possible monsters and remove them so they precached.
 	// we do it once at first frame of the map.
@@ -270,9 +269,14 @@ void bloodfest_spawn_monsters(void)
 	{
 		for (i = 0; i < bloodfest_monster_array_size; i++)
 		{
-			safe_ent_remove(bloodfest_spawn_monster(world, bloodfest_monster_array[i].class_name));
+			safe_ent_remove(
+					bloodfest_spawn_monster(world->s.v.origin, world->s.v.angles,
+											bloodfest_monster_array[i].class_name));
 		}
 
+		// find where waves can go, once per map.
+		SpawnSlotsBuild();
+
 		return;
 	}
 
@@ -294,42 +298,24 @@ void bloodfest_spawn_monsters(void)
 		return;
 	}
 
-	// find total amount of spots.
-	total_spawns = find_cnt( FOFCLSN, "info_monster_start");
-
-	// can't find spawn point.
-	if (!total_spawns)
-	{
-		return;
-	}
-
 	// attempt to spawn one monster,
 	// we trying to do it few times in row since we can fail because spawn point is busy or something.
 	for (i = 0; i < 30; i++)
 	{
 		int idx = 0;
 
-		// find some random spawn point.
-		spot = find_idx(i_rnd(0, total_spawns - 1), FOFCLSN, "info_monster_start");
+		// find some random free spawn slot, does not spawn boss in a water.
+		slot = SpawnSlotPick(!g_bloodfest.spawn_boss);
 
-		// can't find.
-		if (!spot)
+		// all taken.
+		if (!slot)
 		{
 			break;
 		}
 
-		// get spawn content.
-		content = trap_pointcontents(PASSVEC3(spot->s.v.origin));
-
 		// select monster.
 		if (g_bloodfest.spawn_boss)
 		{
-			// does not spawn boss in a water.
-			if (content == CONTENT_WATER)
-			{
-				continue;
-			}
-
 			idx = i_rnd(1, bloodfest_monster_array_size - 1);
 
 			// not a boss.
@@ -340,7 +326,7 @@ void bloodfest_spawn_monsters(void)
 		}
 		else
 		{
-			if (content == CONTENT_WATER)
+			if (slot->water)
 			{
 				idx = 0; // HACK: spawn fish.
 			}
@@ -351,10 +337,14 @@ void bloodfest_spawn_monsters(void)
 		}
 
 		// spawn monster.
-		p = bloodfest_spawn_monster(spot, bloodfest_monster_array[idx].class_name);
+		bloodfest_slot_clear = slot->clear;
+		p = bloodfest_spawn_monster(slot->origin, slot->angles, bloodfest_monster_array[idx].class_name);
+		bloodfest_slot_clear = false;
 
 		if (p)
 		{
+			SpawnSlotTake(slot, p);
+
 			// attempt to spawn boss.
 			if (g_bloodfest.spawn_boss && bloodfest_monster_array[idx].boss_able)
 			{
@@ -761,60 +751,53 @@ void monster_death_use(void)
 
 //============================================================================
 
-void check_monsters_respawn(void)
+static void monster_respawn_think(void)
 {
-	gedict_t *p, *oself;
+	self->monster_respawn_timer = 0;
 
-	if (deathmatch)
+	if (!((int)self->s.v.flags & FL_MONSTER) || ISLIVE(self) || !self->th_respawn)
 	{
-		return; // no need in dm
+		return; // came back some other way
 	}
 
-	if (k_bloodfest)
+	if ((skill < 3) || (cvar("k_monster_spawn_time") <= 0))
 	{
-		bloodfest_think();
+		// settings may change back, look again later
+		self->monster_respawn_timer = G_TimerAdd(g_globalvars.time + 1, monster_respawn_think, self);
 
 		return;
 	}
 
-	if (skill < 3)
-	{
-		return; // skill 3 or more required
-	}
+	self->th_respawn();
+}
+
+// Monster just died, respawn it at monster_desired_spawn_time (nightmare mode).
+// Without a spawn time k_monster_spawn_time was 0, it respawns once that is raised.
+void monster_schedule_respawn(gedict_t *e)
+{
+	G_TimerCancel(e->monster_respawn_timer);
+	e->monster_respawn_timer = 0;
 
-	if (cvar("k_monster_spawn_time") <= 0)
+	if (deathmatch || k_bloodfest || !e->th_respawn)
 	{
 		return;
 	}
 
-	for (p = world; (p = nextent(p));)
-	{
-		if (!((int)p->s.v.flags & FL_MONSTER))
-		{
-			continue; // not a monster
-		}
-
-		if (ISLIVE(p))
-		{
-			continue; // not dead
-		}
-
-		if (!p->th_respawn)
-		{
-			continue; // respawn function is not set
-		}
-
-		if (p->monster_desired_spawn_time > g_globalvars.time)
-		{
-			continue; // time is not come yet
-		}
-
-		oself = self;	// save
-		self = p;		// WARNING !!!
+	e->monster_respawn_timer = G_TimerAdd(
+			e->monster_desired_spawn_time ? e->monster_desired_spawn_time : g_globalvars.time + 1,
+			monster_respawn_think, e);
+}
 
-		self->th_respawn();
+void check_monsters_respawn(void)
+{
+	if (deathmatch)
+	{
+		return; // no need in dm
+	}
 
-		self = oself;	// restore
+	if (k_bloodfest)
+	{
+		bloodfest_think();
 	}
 }
 
@@ -893,7 +876,8 @@ void monster_start_go(monsterType_t mt)
 	self->s.v.solid = SOLID_SLIDEBOX;
 	self->s.v.takedamage = DAMAGE_AIM;
 
-	if (k_bloodfest && is_location_occupied(self, self->s.v.origin, self->s.v.mins, self->s.v.maxs))
+	if (k_bloodfest && !bloodfest_slot_clear
+			&& is_location_occupied(self, self->s.v.origin, self->s.v.mins, self->s.v.maxs))
 	{
 //		G_cprint( "monster (%s) in wall at: %.1f %.1f %.1f, removed!\n",
 //			self->classname, self->s.v.origin[0], self->s.v.origin[1], self->s.v.origin[2] );
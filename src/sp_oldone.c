@@ -434,7 +434,10 @@ void finale_4(void)
 					n = ThrowGib("progs/gib3.mdl", -999);
 				}
 
-				n->s.v.effects = (int)n->s.v.effects | EF_RED;
+				if (n)
+				{
+					n->s.v.effects = (int)n->s.v.effects | EF_RED;
+				}
 			}
 		}
 	}
@@ -0,0 +1,285 @@
+//
+// sp_spawnslots.c - spawn slots for bloodfest monster waves
+//
+// When the map loads every info_monster_start gets a small lattice of slots around it, each
+// one checked once against the world for the biggest monster hull. At wave time a slot is
+// free when the monster last put there has left it or died and no player or monster overlaps
+// it, which only needs the spatial grid, not a trace per attempt.
+// A pick chooses a random spot first and then a free slot of it, so a spot is not picked more
+// often for having more slots which fit. Once nothing is free the slots are not scanned again
+// for SLOT_FULL_RECHECK seconds.
+//
+
+#include "g_local.h"
+
+#define SLOT_MAX		1024
+#define SLOT_STEP		72			// apart more than the 64 units of the biggest hull
+#define SLOT_RADIUS		1			// lattice is (2 * SLOT_RADIUS + 1)^2 slots per spot
+#define SLOT_FLOOR		64			// walking monsters need a floor this close below
+#define SLOT_FULL_RECHECK	0.1		// seconds
+
+typedef struct spawn_spot_s
+{
+	int first;						// its slots are slots[first .. first + count - 1]
+	int count;
+	vec3_t mins, maxs;				// around every hull of its slots
+} spawn_spot_t;
+
+static spawn_slot_t slots[SLOT_MAX];
+static int slots_count;
+static spawn_spot_t spots[SLOT_MAX];
+static int spots_count;
+static qbool slots_built;
+static float slots_full_until[2];	// by allow_water
+
+void SpawnSlotsReset(void)
+{
+	slots_count = 0;
+	spots_count = 0;
+	slots_built = false;
+	slots_full_until[0] = slots_full_until[1] = 0;
+}
+
+// world only, entities are checked when a slot is picked
+static qbool SpawnSlotFits(vec3_t spot, vec3_t org, qbool water)
+{
+	TraceCapsule(PASSVEC3(org), PASSVEC3(org), true, world, PASSVEC3(VEC_HULL2_MIN),
+					PASSVEC3(VEC_HULL2_MAX));
+	if (g_globalvars.trace_startsolid || (g_globalvars.trace_fraction != 1))
+	{
+		return false;
+	}
+
+	// same room as the spot
+	traceline(PASSVEC3(spot), PASSVEC3(org), true, world);
+	if (g_globalvars.trace_fraction != 1)
+	{
+		return false;
+	}
+
+	if (!water)
+	{
+		traceline(PASSVEC3(org), org[0], org[1], org[2] - SLOT_FLOOR, true, world);
+		if (g_globalvars.trace_fraction == 1)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void SpawnSlotAdd(gedict_t *spot, vec3_t org, qbool water, qbool clear)
+{
+	spawn_spot_t *sp = &spots[spots_count];
+	spawn_slot_t *s;
+	int i;
+
+	if (slots_count >= SLOT_MAX)
+	{
+		return;
+	}
+
+	s = &slots[slots_count++];
+	memset(s, 0, sizeof(*s));
+	VectorCopy(org, s->origin);
+	VectorCopy(spot->s.v.angles, s->angles);
+	s->water = water;
+	s->clear = clear;
+
+	if (!sp->count)
+	{
+		sp->first = slots_count - 1;
+		VectorAdd(org, VEC_HULL2_MIN, sp->mins);
+		VectorAdd(org, VEC_HULL2_MAX, sp->maxs);
+	}
+
+	for (i = 0; i < 3; i++)
+	{
+		sp->mins[i] = min(sp->mins[i], org[i] + VEC_HULL2_MIN[i]);
+		sp->maxs[i] = max(sp->maxs[i], org[i] + VEC_HULL2_MAX[i]);
+	}
+
+	sp->count++;
+}
+
+void SpawnSlotsBuild(void)
+{
+	gedict_t *spot;
+	vec3_t org;
+	qbool water;
+	int x, y, added;
+
+	SpawnSlotsReset();
+	slots_built = true;
+
+	for (spot = world; (spot = ez_find(spot, "info_monster_start")) && (slots_count < SLOT_MAX);)
+	{
+		memset(&spots[spots_count], 0, sizeof(spots[0]));
+		added = 0;
+
+		for (x = -SLOT_RADIUS; x <= SLOT_RADIUS; x++)
+		{
+			for (y = -SLOT_RADIUS; y <= SLOT_RADIUS; y++)
+			{
+				VectorSet(org, spot->s.v.origin[0] + x * SLOT_STEP,
+							spot->s.v.origin[1] + y * SLOT_STEP, spot->s.v.origin[2]);
+				water = (trap_pointcontents(PASSVEC3(org)) == CONTENT_WATER);
+
+				if (SpawnSlotFits(spot->s.v.origin, org, water))
+				{
+					SpawnSlotAdd(spot, org, water, true);
+					added++;
+				}
+			}
+		}
+
+		// tight spot, smaller monsters may still fit, keep the old check for it
+		if (!added)
+		{
+			SpawnSlotAdd(spot, spot->s.v.origin,
+							trap_pointcontents(PASSVEC3(spot->s.v.origin)) == CONTENT_WATER, false);
+		}
+
+		if (spots[spots_count].count)
+		{
+			spots_count++;
+		}
+	}
+
+	G_cprint("bloodfest: %d spawn slots at %d spots\n", slots_count, spots_count);
+}
+
+// the monster put here last time is still around, cheap and the usual case
+static qbool SpawnSlotKept(spawn_slot_t *s)
+{
+	gedict_t *e = &g_edicts[s->occupant];
+
+	if (s->occupant && (e->spawn_time == s->occupant_time) && ISLIVE(e)
+			&& (fabs(e->s.v.origin[0] - s->origin[0]) < SLOT_STEP)
+			&& (fabs(e->s.v.origin[1] - s->origin[1]) < SLOT_STEP))
+	{
+		return true;
+	}
+
+	s->occupant = 0;
+
+	return false;
+}
+
+static qbool SpawnSlotOverlaps(spawn_slot_t *s, gedict_t **list, int cnt)
+{
+	gedict_t *e;
+	vec3_t mins, maxs;
+	int i;
+
+	VectorAdd(s->origin, VEC_HULL2_MIN, mins);
+	VectorAdd(s->origin, VEC_HULL2_MAX, maxs);
+
+	for (i = 0; i < cnt; i++)
+	{
+		e = list[i];
+
+		if ((e->s.v.solid != SOLID_SLIDEBOX) && (e->s.v.solid != SOLID_BBOX))
+		{
+			continue;
+		}
+
+		if ((e->s.v.absmin[0] < maxs[0]) && (e->s.v.absmax[0] > mins[0])
+				&& (e->s.v.absmin[1] < maxs[1]) && (e->s.v.absmax[1] > mins[1])
+				&& (e->s.v.absmin[2] < maxs[2]) && (e->s.v.absmax[2] > mins[2]))
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+// random free slot of the spot, one grid query for all of them
+static spawn_slot_t* SpawnSpotPick(spawn_spot_t *sp, qbool allow_water)
+{
+	spawn_slot_t *s, *found = NULL;
+	gedict_t **list;
+	vec3_t qmins, qmaxs;
+	int i, start, cnt, candidates = 0;
+
+	for (i = 0; i < sp->count; i++)
+	{
+		s = &slots[sp->first + i];
+
+		if (!(s->water && !allow_water) && !SpawnSlotKept(s))
+		{
+			candidates++;
+		}
+	}
+
+	if (!candidates)
+	{
+		return NULL;
+	}
+
+	// centers of anything which could overlap, then the boxes themselves
+	VectorSet(qmins, sp->mins[0] - 64, sp->mins[1] - 64, sp->mins[2] - 64);
+	VectorSet(qmaxs, sp->maxs[0] + 64, sp->maxs[1] + 64, sp->maxs[2] + 64);
+	cnt = G_FindBox(qmins, qmaxs, 0, NULL, &list);
+
+	start = i_rnd(0, sp->count - 1);
+
+	for (i = 0; i < sp->count; i++)
+	{
+		s = &slots[sp->first + (start + i) % sp->count];
+
+		// occupant is only left set on slots SpawnSlotKept() found taken
+		if ((s->water && !allow_water) || s->occupant || SpawnSlotOverlaps(s, list, cnt))
+		{
+			continue;
+		}
+
+		found = s;
+		break;
+	}
+
+	G_SpatialRelease(cnt);
+
+	return found;
+}
+
+// Random free slot, NULL if every slot is taken. Water slots are only for fish.
+spawn_slot_t* SpawnSlotPick(qbool allow_water)
+{
+	spawn_slot_t *s;
+	int i, start;
+
+	if (!slots_built)
+	{
+		SpawnSlotsBuild();
+	}
+
+	if (!spots_count || (g_globalvars.time < slots_full_until[allow_water ? 1 : 0]))
+	{
+		return NULL;
+	}
+
+	start = i_rnd(0, spots_count - 1);
+
+	for (i = 0; i < spots_count; i++)
+	{
+		if ((s = SpawnSpotPick(&spots[(start + i) % spots_count], allow_water)))
+		{
+			return s;
+		}
+	}
+
+	// everything taken, don't scan it all again every attempt
+	slots_full_until[allow_water ? 1 : 0] = g_globalvars.time + SLOT_FULL_RECHECK;
+
+	return NULL;
+}
+
+// monster was spawned at the slot
+void SpawnSlotTake(spawn_slot_t *s, gedict_t *monster)
+{
+	s->occupant = NUM_FOR_EDICT(monster);
+	s->occupant_time = monster->spawn_time;
+}
@@ -31,6 +31,7 @@ static void json_player_midair_stats(fileHandle_t handle, player_stats_t *stats)
 static void json_player_ra_stats(fileHandle_t handle, player_stats_t *stats);
 static void json_player_hoonymode_stats(fileHandle_t handle, gedict_t *player);
 static void json_player_lgc_stats(fileHandle_t handle, gedict_t *player);
+static void json_player_timeline(fileHandle_t handle, gedict_t *player);
 
 #define STATS_VERSION_NUMBER 3
 
@@ -44,7 +45,7 @@ static void json_player_lgc_stats(fileHandle_t handle, gedict_t *player);
 #define NEWLINE_CHECK(handle, any) SIMPLE_CHECK(handle, any, JSON_CR)
 #define COMMA_CHECK(handle, any) SIMPLE_CHECK(handle, any, "," JSON_CR)
 
-static char* json_string(const char *input)
+char* json_string(const char *input)
 {
 	// >>>> like va(...) ... eugh
 	static char string[MAX_STRINGS][1024];
@@ -436,6 +437,8 @@ void json_player_detail(fileHandle_t handle, int player_num, gedict_t *player, c
 		json_player_lgc_stats(handle, player);
 	}
 
+	json_player_timeline(handle, player);
+
 #ifdef BOT_SUPPORT
 	if (player->isBot)
 	{
@@ -671,6 +674,109 @@ static void json_player_lgc_stats(fileHandle_t handle, gedict_t *player)
 	S2di(handle, "}" JSON_CR);
 }
 
+#define TIMELINE_HITS		0
+#define TIMELINE_WEAPONS	1
+#define TIMELINE_ITEMS		2
+
+static int json_timeline_count(timeline_bucket_t *b, int what, int idx)
+{
+	switch (what)
+	{
+		case TIMELINE_HITS:
+			return b->hits[idx];
+
+		case TIMELINE_WEAPONS:
+			return b->wtooks[idx];
+
+		default:
+			return b->tooks[idx];
+	}
+}
+
+// hits or tooks of weapon idx, or tooks of item idx, by what (TIMELINE_*)
+static qbool json_timeline_counts(fileHandle_t handle, gedict_t *player, int first, int last,
+									int what, int idx, qbool any)
+{
+	int i, total = 0;
+
+	for (i = first; i <= last; ++i)
+	{
+		total += json_timeline_count(TimelineBucket(player, i), what, idx);
+	}
+
+	if (!total)
+	{
+		return any;
+	}
+
+	COMMA_CHECK(handle, any);
+	S2di(handle, INDENT10 "\"%s\": [", (what == TIMELINE_ITEMS) ? ItName(idx) : WpName(idx));
+	for (i = first; i <= last; ++i)
+	{
+		S2di(handle, "%s%d", (i > first) ? ", " : "",
+				json_timeline_count(TimelineBucket(player, i), what, idx));
+	}
+
+	S2di(handle, "]");
+
+	return any;
+}
+
+static void json_player_timeline(fileHandle_t handle, gedict_t *player)
+{
+	qbool any;
+	int first, last, i;
+
+	if (!TimelineRange(player, &first, &last))
+	{
+		return;
+	}
+
+	S2di(handle, "," JSON_CR);
+	S2di(handle, INDENT6 "\"timeline\": {" JSON_CR);
+	S2di(handle, INDENT8 "\"bucket\": %d," JSON_CR, TIMELINE_BUCKET_TIME);
+	S2di(handle, INDENT8 "\"first\": %d," JSON_CR, first);
+	S2di(handle, INDENT8 "\"dmg-given\": [");
+	for (i = first; i <= last; ++i)
+	{
+		S2di(handle, "%s%d", (i > first) ? ", " : "", TimelineBucket(player, i)->dmg_g);
+	}
+
+	S2di(handle, "]," JSON_CR);
+	S2di(handle, INDENT8 "\"dmg-taken\": [");
+	for (i = first; i <= last; ++i)
+	{
+		S2di(handle, "%s%d", (i > first) ? ", " : "", TimelineBucket(player, i)->dmg_t);
+	}
+
+	S2di(handle, "]," JSON_CR);
+	S2di(handle, INDENT8 "\"hits\": {" JSON_CR);
+	for (any = false, i = 1; i < wpMAX; i++)
+	{
+		any = json_timeline_counts(handle, player, first, last, TIMELINE_HITS, i, any);
+	}
+
+	S2di(handle, "%s", any ? JSON_CR : "");
+	S2di(handle, INDENT8 "}," JSON_CR);
+	S2di(handle, INDENT8 "\"weapons\": {" JSON_CR);
+	for (any = false, i = 1; i < wpMAX; i++)
+	{
+		any = json_timeline_counts(handle, player, first, last, TIMELINE_WEAPONS, i, any);
+	}
+
+	S2di(handle, "%s", any ? JSON_CR : "");
+	S2di(handle, INDENT8 "}," JSON_CR);
+	S2di(handle, INDENT8 "\"items\": {" JSON_CR);
+	for (any = false, i = 1; i < itMAX; i++)
+	{
+		any = json_timeline_counts(handle, player, first, last, TIMELINE_ITEMS, i, any);
+	}
+
+	S2di(handle, "%s", any ? JSON_CR : "");
+	S2di(handle, INDENT8 "}" JSON_CR);
+	S2di(handle, INDENT6 "}");
+}
+
 static void json_player_hoonymode_stats(fileHandle_t handle, gedict_t *player)
 {
 	S2di(handle, "," JSON_CR);
@@ -0,0 +1,149 @@
+//
+// stats_timeline.c - per player statistics in time buckets
+//
+// Damage given and taken, weapon hits, weapon and item pickups are counted per TIMELINE_BUCKET_TIME
+// seconds of the match, next to the totals in player_stats_t. Each player gets a ring of
+// TIMELINE_BUCKETS buckets when the first event is recorded, in a longer match the oldest
+// buckets are overwritten. The ring index lives in player_stats_t, so ghosts keep it and
+// it is back when the player returns.
+//
+
+#include "g_local.h"
+
+#define TIMELINE_MAX		(MAX_CLIENTS + 8)	// room for some ghosts
+
+typedef struct timeline_s
+{
+	timeline_bucket_t buckets[TIMELINE_BUCKETS];
+} timeline_t;
+
+static timeline_t timelines[TIMELINE_MAX];
+static int timelines_count;
+static float timeline_start;
+static timeline_bucket_t timeline_empty;
+
+void TimelineReset(void)
+{
+	timelines_count = 0;
+	timeline_start = match_start_time;
+}
+
+static int TimelineBucketNum(void)
+{
+	int bucket = (int)((g_globalvars.time - timeline_start) / TIMELINE_BUCKET_TIME);
+
+	return (bucket < 0) ? 0 : bucket;
+}
+
+static timeline_t* TimelineOf(gedict_t *p)
+{
+	// stale index from before the last reset
+	if (p->ps.timeline > timelines_count)
+	{
+		p->ps.timeline = 0;
+	}
+
+	if (!p->ps.timeline)
+	{
+		if ((timelines_count >= TIMELINE_MAX) || (match_in_progress != 2))
+		{
+			return NULL;
+		}
+
+		memset(&timelines[timelines_count], 0, sizeof(timelines[0]));
+		p->ps.timeline = ++timelines_count;
+	}
+
+	return &timelines[p->ps.timeline - 1];
+}
+
+// bucket for now, cleared when the ring wraps to it
+static timeline_bucket_t* TimelineCurrent(gedict_t *p)
+{
+	timeline_t *tl;
+	timeline_bucket_t *b;
+	int bucket;
+
+	if ((p->ct != ctPlayer) || (match_in_progress != 2) || !(tl = TimelineOf(p)))
+	{
+		return NULL;
+	}
+
+	bucket = TimelineBucketNum();
+	b = &tl->buckets[bucket % TIMELINE_BUCKETS];
+
+	if (b->bucket != bucket)
+	{
+		memset(b, 0, sizeof(*b));
+		b->bucket = bucket;
+	}
+
+	return b;
+}
+
+void TimelineDamage(gedict_t *attacker, gedict_t *targ, float damage)
+{
+	timeline_bucket_t *b;
+
+	if ((b = TimelineCurrent(attacker)))
+	{
+		b->dmg_g += (int)damage;
+	}
+
+	if ((b = TimelineCurrent(targ)))
+	{
+		b->dmg_t += (int)damage;
+	}
+}
+
+void TimelineHit(gedict_t *p, weaponName_t wp)
+{
+	timeline_bucket_t *b = TimelineCurrent(p);
+
+	if (b)
+	{
+		b->hits[wp]++;
+	}
+}
+
+void TimelineItem(gedict_t *p, itemName_t it)
+{
+	timeline_bucket_t *b = TimelineCurrent(p);
+
+	if (b)
+	{
+		b->tooks[it]++;
+	}
+}
+
+// counted like the weapon tooks of player_stats_t, only weapons the player did not have yet
+void TimelineWeapon(gedict_t *p, weaponName_t wp)
+{
+	timeline_bucket_t *b = TimelineCurrent(p);
+
+	if (b)
+	{
+		b->wtooks[wp]++;
+	}
+}
+
+// Buckets of the player which are still in the ring, first to last. False if nothing was recorded.
+qbool TimelineRange(gedict_t *p, int *first, int *last)
+{
+	if (!p->ps.timeline || (p->ps.timeline > timelines_count))
+	{
+		return false;
+	}
+
+	*last = TimelineBucketNum();
+	*first = (*last >= TIMELINE_BUCKETS) ? (*last - TIMELINE_BUCKETS + 1) : 0;
+
+	return true;
+}
+
+timeline_bucket_t* TimelineBucket(gedict_t *p, int bucket)
+{
+	timeline_bucket_t *b = &timelines[p->ps.timeline - 1].buckets[bucket % TIMELINE_BUCKETS];
+
+	return (b->bucket == bucket) ? b : &timeline_empty;
+}
@@ -282,6 +282,52 @@ static void xml_player_ra_stats(fileHandle_t handle, player_stats_t *stats)
 	S2di(handle, INDENT6 "<rocket-arena wins=\"%d\" losses=\"%d\" />\n", stats->wins, stats->loses);
 }
 
+// buckets with nothing in them are left out
+static void xml_player_timeline(fileHandle_t handle, gedict_t *player)
+{
+	timeline_bucket_t *b;
+	int first, last, i, j;
+
+	if (!TimelineRange(player, &first, &last))
+	{
+		return;
+	}
+
+	S2di(handle, INDENT6 "<timeline bucket=\"%d\" first=\"%d\" last=\"%d\">\n",
+			TIMELINE_BUCKET_TIME, first, last);
+	for (i = first; i <= last; ++i)
+	{
+		b = TimelineBucket(player, i);
+		if (b->bucket != i)
+		{
+			continue;
+		}
+
+		S2di(handle, INDENT8 "<bucket num=\"%d\" dmg_gvn=\"%d\" dmg_tkn=\"%d\">\n", i, b->dmg_g,
+				b->dmg_t);
+		for (j = 1; j < wpMAX; j++)
+		{
+			if (b->hits[j] || b->wtooks[j])
+			{
+				S2di(handle, INDENT10 "<weapon name=\"%s\" hits=\"%d\" tooks=\"%d\"/>\n", WpName(j),
+						b->hits[j], b->wtooks[j]);
+			}
+		}
+
+		for (j = 1; j < itMAX; j++)
+		{
+			if (b->tooks[j])
+			{
+				S2di(handle, INDENT10 "<item name=\"%s\" tooks=\"%d\"/>\n", ItName(j), b->tooks[j]);
+			}
+		}
+
+		S2di(handle, INDENT8 "</bucket>\n");
+	}
+
+	S2di(handle, INDENT6 "</timeline>\n");
+}
+
 void xml_race_detail(fileHandle_t handle)
 {
 	extern gedict_t* race_find_racer(gedict_t *p);
@@ -405,6 +451,8 @@ void xml_player_detail(fileHandle_t handle, int num, gedict_t *player, const cha
 
 		S2di(handle, "</hm-frags>\n");
 	}
+
+	xml_player_timeline(handle, player);
 #ifdef BOT_SUPPORT
 	if (player->isBot)
 	{
@@ -402,15 +402,99 @@ static qbool TP_IsItemVisible(item_vis_t *visitem)
 	return false;
 }
 
+// TP_IsItemVisible() results of this frame, by viewer and target
+#define TP_VIS_CACHE	256		// must be power of two
+
+typedef struct tp_vis_cache_s
+{
+	int frame;
+	gedict_t *viewent;
+	gedict_t *target;
+	vec3_t vieworg;
+	vec3_t forward;
+	vec3_t entorg;
+	float radius;
+	qbool visible;
+} tp_vis_cache_t;
+
+static tp_vis_cache_t tp_vis_cache[TP_VIS_CACHE];
+
+// TeamplayFindPoint() result of this frame, for each client
+typedef struct tp_point_cache_s
+{
+	int frame;
+	vec3_t vieworg;
+	vec3_t forward;
+	gedict_t *point;
+} tp_point_cache_t;
+
+static tp_point_cache_t tp_point_cache[MAX_CLIENTS];
+
+typedef struct tp_point_candidate_s
+{
+	gedict_t *e;
+	float rank;
+	vec3_t entorg;
+	vec3_t dir;
+	float dist;
+	float radius;
+} tp_point_candidate_t;
+
+static qbool TP_IsItemVisibleCached(item_vis_t *visitem, gedict_t *target)
+{
+	tp_vis_cache_t *c = &tp_vis_cache[(NUM_FOR_EDICT(visitem->viewent) * 31 + NUM_FOR_EDICT(target))
+			& (TP_VIS_CACHE - 1)];
+
+	if ((c->frame == framecount) && (c->viewent == visitem->viewent) && (c->target == target)
+			&& (c->radius == visitem->radius) && VectorCompare(c->vieworg, visitem->vieworg)
+			&& VectorCompare(c->forward, visitem->forward) && VectorCompare(c->entorg, visitem->entorg))
+	{
+		return c->visible;
+	}
+
+	c->frame = framecount;
+	c->viewent = visitem->viewent;
+	c->target = target;
+	c->radius = visitem->radius;
+	VectorCopy(visitem->vieworg, c->vieworg);
+	VectorCopy(visitem->forward, c->forward);
+	VectorCopy(visitem->entorg, c->entorg);
+	c->visible = TP_IsItemVisible(visitem);
+
+	return c->visible;
+}
+
+static qbool TP_IsPointable(gedict_t *e, unsigned long pointflags)
+{
+	if ((e->ct == ctPlayer && !ISLIVE(e)) || e->ct == ctSpec)
+	{
+		return false;
+	}
+
+	if (strnull(e->model))
+	{
+		return false;
+	}
+
+	if ((e->ct != ctPlayer) && !(e->tp_flags & pointflags))
+	{
+		return false;
+	}
+
+	return true;
+}
+
 static gedict_t* TeamplayFindPoint(gedict_t *client)
 {
-	int i;
+	int i, j, count;
 	unsigned long pointflags = ~0U;
 	vec3_t ang;
 	item_vis_t visitem;
-	float best = -1;
 	gedict_t *bestent = NULL;
 	byte visible[MAX_EDICTS];
+	static tp_point_candidate_t candidates[MAX_EDICTS];
+	tp_point_candidate_t candidate;
+	tp_point_cache_t *cache = &tp_point_cache[NUM_FOR_EDICT(client) - 1];
 
 	if (deathmatch >= 1 && deathmatch <= 4)
 	{
@@ -432,28 +516,26 @@ static gedict_t* TeamplayFindPoint(gedict_t *client)
 	visitem.viewent = client;
 	VectorAdd(visitem.vieworg, client->s.v.view_ofs, visitem.vieworg); // FIXME: v_viewheight not taken into account
 
+	// binds often send several reports in a row
+	if ((cache->frame == framecount) && VectorCompare(cache->vieworg, visitem.vieworg)
+			&& VectorCompare(cache->forward, visitem.forward)
+			&& (!cache->point || TP_IsPointable(cache->point, pointflags)))
+	{
+		return cache->point;
+	}
+
 	visible_to(client, g_edicts, MAX_EDICTS, visible);
 
-	for (i = 0; i < MAX_EDICTS; i++)
+	// rank everything in the view cone first, traces are only done in rank order below
+	for (i = 0, count = 0; i < MAX_EDICTS; i++)
 	{
 		gedict_t *e = &g_edicts[i];
 		vec3_t size;
-		float rank;
 
 		if (!visible[i])
 			continue;
 
-		if ((e->ct == ctPlayer && !ISLIVE(e)) || e->ct == ctSpec)
-		{
-			continue;
-		}
-
-		if (strnull(e->model))
-		{
-			continue;
-		}
-
-		if ((e->ct != ctPlayer) && !(e->tp_flags & pointflags))
+		if (!TP_IsPointable(e, pointflags))
 		{
 			continue;
 		}
@@ -475,19 +557,48 @@ static gedict_t* TeamplayFindPoint(gedict_t *client)
 				(int)e->s.v.effects & (EF_BLUE | EF_RED | EF_DIMLIGHT | EF_BRIGHTLIGHT) ?
 						200 : max(max(size[0] / 2, size[1] / 2), size[2] / 2);
 
-		if ((rank = TeamplayRankPoint(&visitem)) < 0)
+		candidate.rank = TeamplayRankPoint(&visitem);
+		if (candidate.rank < 0)
 		{
 			continue;
 		}
 
-		// check if we can actually see the object (TODO: with pointflags, player detection is different)
-		if (((rank < best) || (best < 0)) && TP_IsItemVisible(&visitem))
+		candidate.e = e;
+		VectorCopy(visitem.entorg, candidate.entorg);
+		VectorCopy(visitem.dir, candidate.dir);
+		candidate.dist = visitem.dist;
+		candidate.radius = visitem.radius;
+
+		// keep candidates sorted by rank, equal ranks stay in edict order
+		for (j = count; (j > 0) && (candidates[j - 1].rank > candidate.rank); j--)
+		{
+			candidates[j] = candidates[j - 1];
+		}
+
+		candidates[j] = candidate;
+		count++;
+	}
+
+	// check if we can actually see the object (TODO: with pointflags, player detection is different)
+	for (i = 0; i < count; i++)
+	{
+		VectorCopy(candidates[i].entorg, visitem.entorg);
+		VectorCopy(candidates[i].dir, visitem.dir);
+		visitem.dist = candidates[i].dist;
+		visitem.radius = candidates[i].radius;
+
+		if (TP_IsItemVisibleCached(&visitem, candidates[i].e))
 		{
-			best = rank;
-			bestent = e;
+			bestent = candidates[i].e;
+			break;
 		}
 	}
 
+	cache->frame = framecount;
+	VectorCopy(visitem.vieworg, cache->vieworg);
+	VectorCopy(visitem.forward, cache->forward);
+	cache->point = bestent;
+
 	return bestent;
 }
 
@@ -1539,29 +1650,41 @@ char* LocationName(float x, float y, float z)
 
 void LocationInitialise(void)
 {
-	fileHandle_t file = -1;
+	char *text = NULL;
 	char *entityFile = cvar_string("k_entityfile");
 	char lineData[128];
 	char argument[128];
+	location_node_t *cached;
+	int size = 0;
 
 	if (!strnull(entityFile))
 	{
-		file = std_fropen("locs/%s.loc", entityFile);
+		text = MapBundleOpenSource("locs/%s.loc", entityFile);
 	}
 
-	if (file == -1)
+	if (text == NULL)
 	{
-		file = std_fropen("locs/%s.loc", mapname);
+		text = MapBundleOpenSource("locs/%s.loc", mapname);
 	}
 
-	if (file == -1)
+	if (text == NULL)
 	{
 		G_Printf("Couldn't load %s.loc\n", mapname);
 
 		return;
 	}
 
-	while (std_fgets(file, lineData, sizeof(lineData)))
+	// Same file as last time: take the nodes with macros already replaced
+	if ((cached = MapBundleSection(mbsLocations, &size)))
+	{
+		node_count = min(size / (int)sizeof(location_node_t), sizeof(nodes) / sizeof(nodes[0]));
+		memcpy(nodes, cached, node_count * sizeof(location_node_t));
+		G_Printf("Loaded %d locations\n", node_count);
+
+		return;
+	}
+
+	while (MapBundleNextLine(&text, lineData, sizeof(lineData)))
 	{
 		char x[16], y[16], z[16];
 		char *name;
@@ -1632,7 +1755,9 @@ void LocationInitialise(void)
 
 	G_Printf("Loaded %d locations\n", node_count);
 
-	std_fclose(file);
+	MapBundleBegin(mbsLocations);
+	MapBundleAppend(nodes, node_count * sizeof(location_node_t));
+	MapBundleCommit();
 }
 
 typedef struct teamplay_message_s
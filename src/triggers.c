@@ -527,12 +527,15 @@ void teleport_player(gedict_t *player, vec3_t origin, vec3_t angles, int flags)
 	// play sound where the player was
 	if (flags & TFLAGS_SND_SRC)
 	{
-		gedict_t *othercopy = spawn();
+		gedict_t *othercopy = FxSpawn();
 
-		setorigin(othercopy, PASSVEC3(player->s.v.origin));
-		othercopy->s.v.nextthink = g_globalvars.time + 0.1;
-		othercopy->think = (func_t) SUB_Remove;
-		play_teleport(othercopy);
+		if (othercopy)
+		{
+			setorigin(othercopy, PASSVEC3(player->s.v.origin));
+			othercopy->s.v.nextthink = g_globalvars.time + 0.1;
+			othercopy->think = (func_t) SUB_Remove;
+			play_teleport(othercopy);
+		}
 	}
 
 	//put a tfog where the player was
@@ -1101,7 +1101,7 @@ void hooksmooth(void)
 
   if (veto || !get_votes_req(OV_HOOKSMOOTH, true))
 	{
-		cvar_fset("k_ctf_hookstyle", 1);
+		cvar_fset("k_ctf_hookstyle", HOOK_STYLE_SMOOTH);
 		G_bprint(2, "%s\n", redtext(va("hook style set to smooth by %s", veto ? "admin veto" : "majority vote")));
 		vote_clear(OV_HOOKSMOOTH);
 	}
@@ -1145,7 +1145,7 @@ void hookfast(void)
 
   if (veto || !get_votes_req(OV_HOOKFAST, true))
 	{
-		cvar_fset("k_ctf_hookstyle", 2);
+		cvar_fset("k_ctf_hookstyle", HOOK_STYLE_FAST);
 		G_bprint(2, "%s\n", redtext(va("hook style set to fast by %s", veto ? "admin veto" : "majority vote")));
 		vote_clear(OV_HOOKFAST);
 	}
@@ -1188,7 +1188,7 @@ void hookclassic(void)
 
   if (veto || !get_votes_req(OV_HOOKCLASSIC, true))
 	{
-		cvar_fset("k_ctf_hookstyle", 3);
+		cvar_fset("k_ctf_hookstyle", HOOK_STYLE_CLASSIC);
 		G_bprint(2, "%s\n", redtext(va("hook style set to classic by %s", veto ? "admin veto" : "majority vote")));
 		vote_clear(OV_HOOKCLASSIC);
 		return;
@@ -1232,7 +1232,7 @@ void hookcrhook(void)
 
 	if (veto || !get_votes_req(OV_HOOKCRHOOK, true))
 	{
-		cvar_fset("k_ctf_hookstyle", 4);
+		cvar_fset("k_ctf_hookstyle", HOOK_STYLE_CR);
 		G_bprint(2, "%s\n", redtext(va("hook style set to crhook by %s", veto ? "admin veto" : "majority vote")));
 		vote_clear(OV_HOOKCRHOOK);
 		return;
@@ -117,6 +117,7 @@ void W_FireAxe(void)
 		{
 			WS_Mark(self, wpAXE);
 			self->ps.wpn[wpAXE].hits++;
+			TimelineHit(self, wpAXE);
 		}
 
 		if (deathmatch > 3)
@@ -194,7 +195,12 @@ void SpawnMeatSpray(vec3_t org, vec3_t vel)
 
 	//vec3_t  org;
 
-	missile = spawn();
+	missile = FxSpawn();
+	if (!missile)
+	{
+		return;
+	}
+
 	missile->s.v.owner = EDICT_TO_PROG(self);
 	missile->s.v.movetype = MOVETYPE_BOUNCE;
 	missile->isMissile = true;
@@ -385,11 +391,13 @@ void TraceAttack(float damage, vec3_t dir, qbool send_effects)
 			{
 				WS_Mark(self, wpSG);
 				self->ps.wpn[wpSG].hits++;
+				TimelineHit(self, wpSG);
 			}
 			else if ((int)self->s.v.weapon == IT_SUPER_SHOTGUN)
 			{
 				WS_Mark(self, wpSSG);
 				self->ps.wpn[wpSSG].hits++;
+				TimelineHit(self, wpSSG);
 			}
 			else
 			{
@@ -533,6 +541,139 @@ void FireInstaBullet(vec3_t dir, deathType_t deathtype)
 	CoilgunTrail(tmp, src, self - world, iKey(self, "railcolor"));
 }
 
+/*
+ ================
+ Pellet targets
+
+ A pellet can only do damage if its line crosses the box of something which takes damage.
+ Those are collected once per shot from the spatial grid for the whole cone, and only pellets
+ crossing one of them are traced. The others end where the center trace did.
+ The cone is widened by G_SpatialExtent(), so the center of anything reaching into it,
+ a monster_oldone or a big shootable door too, is inside the query.
+ ================
+ */
+#define PELLET_TARGETS	64
+
+static gedict_t *pellet_target[PELLET_TARGETS];
+static int pellet_targets;			// -1 = too many, trace every pellet
+
+static void PelletTargets(vec3_t src, vec3_t dir, float spread_x, float spread_y, float range,
+							gedict_t *center)
+{
+	vec3_t mins, maxs, end;
+	gedict_t **list, *e;
+	float slack = G_SpatialExtent() + 1;	// PelletMayHit() grows boxes by 1
+	int i, j, cnt;
+
+	// the cone is inside the box around src and its four corners
+	VectorCopy(src, mins);
+	VectorCopy(src, maxs);
+
+	for (i = 0; i < 4; i++)
+	{
+		VectorMA(dir, (i & 1) ? spread_x : -spread_x, g_globalvars.v_right, end);
+		VectorMA(end, (i & 2) ? spread_y : -spread_y, g_globalvars.v_up, end);
+		VectorMA(src, range, end, end);
+
+		for (j = 0; j < 3; j++)
+		{
+			mins[j] = min(mins[j], end[j]);
+			maxs[j] = max(maxs[j], end[j]);
+		}
+	}
+
+	for (j = 0; j < 3; j++)
+	{
+		mins[j] -= slack;
+		maxs[j] += slack;
+	}
+
+	pellet_targets = 0;
+
+	if (center->s.v.takedamage && (center != world))
+	{
+		pellet_target[pellet_targets++] = center;
+	}
+
+	cnt = G_FindBox(mins, maxs, SPATIAL_TAKEDAMAGE, NULL, &list);
+
+	for (i = 0; i < cnt; i++)
+	{
+		e = list[i];
+
+		if ((e == self) || (e == center) || (e->s.v.solid == SOLID_TRIGGER))
+		{
+			continue;
+		}
+
+		if (pellet_targets >= PELLET_TARGETS)
+		{
+			pellet_targets = -1;
+			break;
+		}
+
+		pellet_target[pellet_targets++] = e;
+	}
+
+	G_SpatialRelease(cnt);
+}
+
+// does the line from src to src + delta cross a target box
+static qbool PelletMayHit(vec3_t src, vec3_t delta)
+{
+	float t0, t1, a, b, tmp;
+	gedict_t *e;
+	int i, j;
+
+	if (pellet_targets < 0)
+	{
+		return true;
+	}
+
+	for (i = 0; i < pellet_targets; i++)
+	{
+		e = pellet_target[i];
+		t0 = 0;
+		t1 = 1;
+
+		for (j = 0; j < 3; j++)
+		{
+			if (fabs(delta[j]) < 0.001)
+			{
+				if ((src[j] < e->s.v.absmin[j] - 1) || (src[j] > e->s.v.absmax[j] + 1))
+				{
+					break;
+				}
+
+				continue;
+			}
+
+			a = (e->s.v.absmin[j] - 1 - src[j]) / delta[j];
+			b = (e->s.v.absmax[j] + 1 - src[j]) / delta[j];
+			if (a > b)
+			{
+				tmp = a;
+				a = b;
+				b = tmp;
+			}
+
+			t0 = max(t0, a);
+			t1 = min(t1, b);
+			if (t0 > t1)
+			{
+				break;
+			}
+		}
+
+		if (j == 3)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /*
  ================
  FireBullets
@@ -549,6 +690,8 @@ void FireBullets(float shotcount, vec3_t dir, float spread_x, float spread_y, fl
 	qbool classic_shotgun = cvar("k_classic_shotgun");
 	qbool non_random_bullets = (k_yawnmode
 			|| (!match_in_progress && self && (self->ct == ctPlayer) && iKey(self, "nrb")));
+	float range = (cvar("k_instagib") ? 8192 : 2048);
+	qbool center_hit;
 
 	trap_makevectors(self->s.v.v_angle);
 	VectorScale(g_globalvars.v_forward, 10, tmp);
@@ -559,20 +702,19 @@ void FireBullets(float shotcount, vec3_t dir, float spread_x, float spread_y, fl
 	ClearMultiDamage();
 	multi_damage_type = deathtype;
 
-	if (cvar("k_instagib"))
-	{
-		traceline(PASSVEC3(src), src[0] + dir[0] * 8192, src[1] + dir[1] * 8192,
-					src[2] + dir[2] * 8192, false, self);
-	}
-	else
-	{
-		traceline(PASSVEC3(src), src[0] + dir[0] * 2048, src[1] + dir[1] * 2048,
-					src[2] + dir[2] * 2048, false, self);
-	}
+	traceline(PASSVEC3(src), src[0] + dir[0] * range, src[1] + dir[1] * range,
+				src[2] + dir[2] * range, false, self);
 
 	VectorScale(dir, 4, tmp);
 	VectorSubtract(g_globalvars.trace_endpos, tmp, puff_org);	// puff_org = trace_endpos - dir*4;
 
+	// classic shotgun puffs where each pellet lands, so every one is traced
+	center_hit = (g_globalvars.trace_fraction != 1.0);
+	if (!classic_shotgun)
+	{
+		PelletTargets(src, dir, spread_x, spread_y, range, PROG_TO_EDICT(g_globalvars.trace_ent));
+	}
+
 	while (shotcount > 0)
 	{
 		if (non_random_bullets)
@@ -701,20 +843,23 @@ void FireBullets(float shotcount, vec3_t dir, float spread_x, float spread_y, fl
 		}
 
 //		direction = dir + crandom()*spread[0]*v_right + crandom()*spread[1]*v_up;
-		if (cvar("k_instagib"))
+		VectorScale(direction, range, tmp);
+
+		if (!classic_shotgun && !PelletMayHit(src, tmp))
 		{
-			VectorScale(direction, 8192, tmp);
+			if (center_hit)
+			{
+				puff_count = puff_count + 1;
+			}
 		}
 		else
 		{
-			VectorScale(direction, 2048, tmp);
-		}
-
-		VectorAdd(src, tmp, tmp);
-		traceline(PASSVEC3(src), PASSVEC3(tmp), false, self);
-		if (g_globalvars.trace_fraction != 1.0)
-		{
-			TraceAttack(4, direction, classic_shotgun);
+			VectorAdd(src, tmp, tmp);
+			traceline(PASSVEC3(src), PASSVEC3(tmp), false, self);
+			if (g_globalvars.trace_fraction != 1.0)
+			{
+				TraceAttack(4, direction, classic_shotgun);
+			}
 		}
 
 		shotcount = shotcount - 1;
@@ -992,6 +1137,7 @@ void T_MissileTouch(void)
 		{
 			WS_Mark(PROG_TO_EDICT(self->s.v.owner), wpRL);
 			PROG_TO_EDICT(self->s.v.owner)->ps.wpn[wpRL].hits++;
+			TimelineHit(PROG_TO_EDICT(self->s.v.owner), wpRL);
 		}
 	}
 
@@ -1104,6 +1250,7 @@ void LightningHit(gedict_t *from, float damage)
 	{
 		WS_Mark(from, wpLG);
 		from->ps.wpn[wpLG].hits++;
+		TimelineHit(from, wpLG);
 		from->ps.wpn[wpLG].lastfraghits++;
 	}
 
@@ -1329,6 +1476,7 @@ void GrenadeTouch(void)
 		{
 			WS_Mark(PROG_TO_EDICT(self->s.v.owner), wpGL);
 			PROG_TO_EDICT(self->s.v.owner)->ps.wpn[wpGL].hits++;
+			TimelineHit(PROG_TO_EDICT(self->s.v.owner), wpGL);
 		}
 	}
 
@@ -1547,6 +1695,7 @@ void spike_touch(void)
 		{
 			WS_Mark(PROG_TO_EDICT(self->s.v.owner), wpNG);
 			PROG_TO_EDICT(self->s.v.owner)->ps.wpn[wpNG].hits++;
+			TimelineHit(PROG_TO_EDICT(self->s.v.owner), wpNG);
 		}
 
 		spawn_touchblood(1);
@@ -1618,6 +1767,7 @@ void superspike_touch(void)
 		{
 			WS_Mark(PROG_TO_EDICT(self->s.v.owner), wpSNG);
 			PROG_TO_EDICT(self->s.v.owner)->ps.wpn[wpSNG].hits++;
+			TimelineHit(PROG_TO_EDICT(self->s.v.owner), wpSNG);
 		}
 
 		spawn_touchblood(2);
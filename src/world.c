@@ -667,7 +667,9 @@ void Customize_Maps(void)
 	// modify slide8 to make it possible to complete in race mode
 	if (streq(mapname, "slide8"))
 	{
-		gedict_t *push, *oldself, *ent;
+		gedict_t *push, *oldself;
+		gedict_t **list;
+		int i, count;
 
 		// create extra push before lava pit
 		push = spawn();
@@ -687,13 +689,13 @@ void Customize_Maps(void)
 		self = oldself;
 
 		// Remove hurt indicators around lava pit
-		for (ent = world; (ent = findradius_ignore_solid(ent, push->s.v.origin, 300)); /**/)
+		count = G_FindRadius(push->s.v.origin, 300, SPATIAL_NONSOLID, "trigger_hurt", &list);
+		for (i = 0; i < count; i++)
 		{
-			if (streq(ent->classname, "trigger_hurt"))
-			{
-				ent_remove(ent);
-			}
+			ent_remove(list[i]);
 		}
+
+		G_SpatialRelease(count);
 	}
 
 	if (cvar("k_spm_show"))
@@ -932,6 +934,7 @@ void FirstFrame(void)
 	RegisterCvar("k_exclusive"); // stores whether players can join when a game is already in progress
 	RegisterCvar("k_lockmode");
 	RegisterCvar("k_short_gib");
+	RegisterCvarEx("k_fx_budget", "64"); // edicts kept for gibs and other effects, 0 = spawn each one
 	RegisterCvar("k_ann");
 	RegisterCvar("srv_practice_mode");
 	RegisterCvar("add_q_aerowalk");
@@ -944,6 +947,7 @@ void FirstFrame(void)
 	RegisterCvar("k_ctf_custom_models");
 	RegisterCvar("k_ctf_hook");
 	RegisterCvar("k_ctf_hookstyle"); // loop through hookstyle settings
+	RegisterCvar("k_ctf_hookbeam"); // draw the hook chain as a beam instead of link entities
 	RegisterCvar("k_ctf_runes");
 	RegisterCvarEx("k_ctf_rune_bounce", "3");
 	RegisterCvarEx("k_ctf_rune_power_str", "2.0");
@@ -971,6 +975,7 @@ void FirstFrame(void)
 	RegisterCvar("k_rocketarena"); // rocket arena
 	RegisterCvar("k_dmgfrags");
 	RegisterCvar("k_tp_tele_death");
+	RegisterCvarEx("k_trx_save", "0"); // allow players to save trick records on server
 // { Clan Arena
 	RegisterCvarEx("k_clan_arena", "0");
 	RegisterCvarEx("k_clan_arena_rounds", "9");
@@ -994,6 +999,8 @@ void FirstFrame(void)
 
 	RegisterCvarEx("k_extralog_xsd_uri", "http://mirror.quakeworld.eu/ktx/ktxlog_0.1.xsd");
 	RegisterCvar("k_extralog");
+	RegisterCvar("k_extralog_budget"); // max bytes of queued match events written per frame
+	RegisterCvar("k_eventlog"); // NDJSON match event stream
 	RegisterCvar("k_demo_mintime");
 	RegisterCvar("k_dmm4_gren_mode");
 	RegisterCvarEx("k_fp", "1"); // say floodprot for players
@@ -1008,6 +1015,7 @@ void FirstFrame(void)
 
 // { SP
 	RegisterCvarEx("k_monster_spawn_time", "20");
+	RegisterCvarEx("k_monster_lod", "1"); // far monsters think less often, 0 = full AI for all
 // }
 
 	RegisterCvar("_k_captteam1"); // internal mod usage
@@ -1054,6 +1062,7 @@ void FirstFrame(void)
 	RegisterCvarEx(FB_CVAR_WEAPON, "2");
 	RegisterCvarEx(FB_CVAR_BREAK_ON_DEATH, "1");
 	RegisterCvarEx(FB_CVAR_QUAD_MULTIPLIER, "4");
+	RegisterCvarEx(FB_CVAR_THINK_BUDGET, "0");
 
 	for (i = 0; i < MAX_CLIENTS; i++)
 	{
@@ -1551,6 +1560,8 @@ void FixRules(void)
 
 	k_killquad = cvar("k_killquad");
 
+	k_ctf_hookstyle = cvar("k_ctf_hookstyle");
+
 	skill = cvar("skill");
 
 	coop = cvar("coop");
@@ -1821,6 +1832,7 @@ void FixNoSpecs(void);
 void StartFrame(int time)
 {
 	framecount++;
+	G_SpatialSweep();
 
 	if (framecount == 1)
 	{
@@ -1888,6 +1900,8 @@ void StartFrame(int time)
 		race_think();
 	}
 
+	G_TimersRun();
+
 	check_monsters_respawn();
 
 	CheckTeamStatus();
@@ -1900,6 +1914,8 @@ void StartFrame(int time)
 
 	TeamplayGameTick();
 
+	LogsFrame(); // write queued match events
+
 	WillPause();
 }
 
@@ -221,6 +221,7 @@ typedef struct options_s {
 	qboolean writeMapFile;
 	qboolean vanillaQ3Compatibility;
 	qboolean optimize;
+	qboolean peephole;
 } options_t;
 
 options_t options = { 0 };
@@ -256,6 +257,7 @@ int		lineParseOffset;
 char	token[MAX_LINE_LENGTH];
 
 int		instructionCount;
+int		removedCount;			// instructions dropped by the peephole stage, PASS_COMPILE only
 
 char	symExport[MAX_LINE_LENGTH];
 
@@ -1097,11 +1099,275 @@ void SwitchToSegment( segmentName_t seg ) {
 }
 
 
+/*
+==============
+Peephole stage
+
+Instructions wait in a small window until no rule can rewrite them anymore.
+Every rule depends only on opcodes and literal numbers, never on symbol values
+(they are all zero on PASS_DEFINE), so each pass emits the same instruction count.
+The window is flushed before anything that takes instructionCount (labels, procs).
+==============
+*/
+
+#define	PEEP_DEPTH	3
+
+typedef struct {
+	int		opcode;
+	int		size;				// bytes of the operand: 0, 1 or 4
+	int		value;
+	int		literal;			// value is a plain number, not a symbol address
+	char	name[MAX_LINE_LENGTH];	// symbol of CONST, to spot jumps to the next label
+} peep_t;
+
+peep_t		peep[ PEEP_DEPTH + 1 ];
+int			peepCount;
+int			codeDead;			// after unconditional LEAVE/JUMP, nothing reaches code up to the next label
+
+
+int IsLiteral( const char *s ) {
+	return ( *s == '-' || ( *s >= '0' && *s <= '9' ) );
+}
+
+
+static int IsPow2( int v ) {
+	return ( v > 0 && ( v & ( v - 1 ) ) == 0 );
+}
+
+
+static int Log2( int v ) {
+	int		n = 0;
+	while ( v > 1 ) {
+		v >>= 1;
+		n++;
+	}
+	return n;
+}
+
+
+void WriteInstruction( const peep_t *p ) {
+	EmitByte( &segment[CODESEG], p->opcode );
+	if ( p->size == 4 ) {
+		EmitInt( &segment[CODESEG], p->value );
+	} else if ( p->size == 1 ) {
+		EmitByte( &segment[CODESEG], p->value );
+	}
+	instructionCount++;
+}
+
+
+void PeepDrop( int count ) {
+	peepCount -= count;
+	if ( passNumber == PASS_COMPILE ) {
+		removedCount += count;
+	}
+}
+
+
+/*
+==============
+Peephole
+
+tries one rule on the tail of the window, returns 1 if it changed anything
+==============
+*/
+int Peephole( void ) {
+	peep_t	*a, *b, *c;
+
+	if ( peepCount < 2 ) {
+		return 0;
+	}
+
+	a = ( peepCount >= 3 ) ? &peep[ peepCount - 3 ] : NULL;
+	b = &peep[ peepCount - 2 ];
+	c = &peep[ peepCount - 1 ];
+
+	// value computed just to be discarded
+	if ( c->opcode == OP_POP ) {
+		if ( b->opcode == OP_CONST || b->opcode == OP_LOCAL ) {
+			PeepDrop( 2 );
+			return 1;
+		}
+		if ( a && ( a->opcode == OP_CONST || a->opcode == OP_LOCAL )
+			&& ( b->opcode == OP_LOAD1 || b->opcode == OP_LOAD2 || b->opcode == OP_LOAD4 ) ) {
+			PeepDrop( 3 );
+			return 1;
+		}
+		return 0;
+	}
+
+	if ( b->opcode != OP_CONST || !b->literal ) {
+		return 0;
+	}
+
+	// right operand is a known number
+	switch ( c->opcode ) {
+		case OP_ADD:
+		case OP_SUB:
+		case OP_LSH:
+		case OP_RSHI:
+		case OP_RSHU:
+		case OP_BOR:
+		case OP_BXOR:
+			if ( b->value == 0 ) {
+				PeepDrop( 2 );
+				return 1;
+			}
+			break;
+		case OP_MULI:
+		case OP_MULU:
+		case OP_DIVI:
+		case OP_DIVU:
+			if ( b->value == 1 ) {
+				PeepDrop( 2 );
+				return 1;
+			}
+			if ( c->opcode == OP_MULI || c->opcode == OP_MULU ) {
+				if ( IsPow2( b->value ) ) {
+					b->value = Log2( b->value );
+					c->opcode = OP_LSH;
+					return 1;
+				}
+			} else if ( c->opcode == OP_DIVU ) {
+				// signed division rounds towards zero, shift does not
+				if ( IsPow2( b->value ) ) {
+					b->value = Log2( b->value );
+					c->opcode = OP_RSHU;
+					return 1;
+				}
+			}
+			break;
+		case OP_MODU:
+			if ( IsPow2( b->value ) ) {
+				b->value = b->value - 1;
+				c->opcode = OP_BAND;
+				return 1;
+			}
+			break;
+	}
+
+	if ( !a ) {
+		return 0;
+	}
+
+	// constant offset into a local: fold into the address
+	if ( a->opcode == OP_LOCAL && c->opcode == OP_ADD ) {
+		a->value += b->value;
+		PeepDrop( 2 );
+		return 1;
+	}
+
+	if ( a->opcode != OP_CONST ) {
+		return 0;
+	}
+
+	// symbol +- offset is still a constant
+	if ( c->opcode == OP_ADD || c->opcode == OP_SUB ) {
+		a->value = ( c->opcode == OP_ADD ) ? a->value + b->value : a->value - b->value;
+		a->name[0] = '\0';
+		PeepDrop( 2 );
+		return 1;
+	}
+
+	if ( !a->literal ) {
+		return 0;
+	}
+
+	switch ( c->opcode ) {
+		case OP_MULI:
+		case OP_MULU:
+			a->value = (int)( (unsigned)a->value * (unsigned)b->value );
+			break;
+		case OP_LSH:
+			a->value = (int)( (unsigned)a->value << ( b->value & 31 ) );
+			break;
+		case OP_BAND:
+			a->value &= b->value;
+			break;
+		case OP_BOR:
+			a->value |= b->value;
+			break;
+		case OP_BXOR:
+			a->value ^= b->value;
+			break;
+		default:
+			return 0;
+	}
+
+	PeepDrop( 2 );
+	return 1;
+}
+
+
+void PeepholeFlush( void ) {
+	int		i;
+
+	for ( i = 0 ; i < peepCount ; i++ ) {
+		WriteInstruction( &peep[i] );
+	}
+	peepCount = 0;
+}
+
+
+/*
+==============
+EmitInstruction
+
+all code except procedure entry/exit goes through here
+==============
+*/
+void EmitInstruction( int opcode, int size, int value, int literal, const char *name ) {
+	peep_t	*p;
+
+	p = &peep[ peepCount ];
+	p->opcode = opcode;
+	p->size = size;
+	p->value = value;
+	p->literal = literal;
+	strcpy( p->name, ( name && opcode == OP_CONST ) ? name : "" );
+
+	if ( !options.peephole ) {
+		WriteInstruction( p );
+		return;
+	}
+
+	if ( opcode == OP_LEAVE || opcode == OP_JUMP ) {
+		codeDead = 1;
+	}
+
+	peepCount++;
+	while ( Peephole() )
+		;
+
+	if ( peepCount > PEEP_DEPTH ) {
+		WriteInstruction( &peep[0] );
+		memmove( &peep[0], &peep[1], ( peepCount - 1 ) * sizeof( peep[0] ) );
+		peepCount--;
+	}
+}
+
+
+/*
+==============
+PeepholeLabel
+
+code label is about to be defined, drop a jump straight to it
+==============
+*/
+void PeepholeLabel( const char *label ) {
+	if ( peepCount >= 2 && peep[ peepCount - 1 ].opcode == OP_JUMP
+		&& peep[ peepCount - 2 ].opcode == OP_CONST && !strcmp( peep[ peepCount - 2 ].name, label ) ) {
+		PeepDrop( 2 );
+	}
+	PeepholeFlush();
+	codeDead = 0;
+}
+
+
 // call instructions reset currentArgOffset
 ASMF(CALL)
 {
-	EmitByte( &segment[CODESEG], OP_CALL );
-	instructionCount++;
+	EmitInstruction( OP_CALL, 0, 0, 1, NULL );
 	currentArgOffset = 0;
 	return 1;
 }
@@ -1110,13 +1376,11 @@ ASMF(CALL)
 // arg is converted to a reversed store
 ASMF(ARG)
 {
-	EmitByte( &segment[CODESEG], OP_ARG );
-	instructionCount++;
 	if ( 8 + currentArgOffset >= 256 ) {
 		CodeError( "currentArgOffset >= 256" );
 		return 0;
 	}
-	EmitByte( &segment[CODESEG], 8 + currentArgOffset );
+	EmitInstruction( OP_ARG, 1, 8 + currentArgOffset, 1, NULL );
 	currentArgOffset += 4;
 	return 1;
 }
@@ -1125,9 +1389,7 @@ ASMF(ARG)
 // ret just leaves something on the op stack
 ASMF(RET)
 {
-	EmitByte( &segment[CODESEG], OP_LEAVE );
-	instructionCount++;
-	EmitInt( &segment[CODESEG], 8 + currentLocals + currentArgs );
+	EmitInstruction( OP_LEAVE, 4, 8 + currentLocals + currentArgs, 1, NULL );
 	return 1;
 }
 
@@ -1135,8 +1397,7 @@ ASMF(RET)
 // pop is needed to discard the return value of a function
 ASMF(POP)
 {
-	EmitByte( &segment[CODESEG], OP_POP );
-	instructionCount++;
+	EmitInstruction( OP_POP, 0, 0, 1, NULL );
 	return 1;
 }
 
@@ -1147,10 +1408,8 @@ ASMF(ADDRF)
 	int		v;
 	Parse();
 	v = ParseExpression();
-	instructionCount++;
 	v = 16 + currentArgs + currentLocals + v;
-	EmitByte( &segment[CODESEG], OP_LOCAL );
-	EmitInt( &segment[CODESEG], v );
+	EmitInstruction( OP_LOCAL, 4, v, 1, NULL );
 	return 1;
 }
 
@@ -1161,10 +1420,8 @@ ASMF(ADDRL)
 	int v;
 	Parse();
 	v = ParseExpression();
-	instructionCount++;
 	v = 8 + currentArgs + v;
-	EmitByte( &segment[CODESEG], OP_LOCAL );
-	EmitInt( &segment[CODESEG], v );
+	EmitInstruction( OP_LOCAL, 4, v, 1, NULL );
 	return 1;
 }
 
@@ -1189,6 +1446,9 @@ ASMF(PROC)
 	if ( ignoreFunc > 0 )
 		return 1;
 
+	PeepholeFlush();
+	codeDead = 0;
+
 	if ( !entry ) {
 		if ( strcmp( token, "vmMain" ) )
 			printf( "Warning: entry point should be 'vmMain' instead of '%s'\n", token );
@@ -1225,7 +1485,10 @@ ASMF(ENDPROC)
 	//Parse();				// skip the function name
 	//v = ParseValue();		// locals
 	//v2 = ParseValue();	// arg marshalling
-	
+
+	PeepholeFlush();
+	codeDead = 0;
+
 	// all functions must leave something on the opstack
 	instructionCount++;
 	EmitByte( &segment[CODESEG], OP_PUSH );
@@ -1389,6 +1652,7 @@ ASMF(LABEL)
 	}
 
 	if ( currentSegment == &segment[CODESEG] ) {
+		PeepholeLabel( token );
 		if ( passNumber == PASS_COMPILE )
 			JUSED( instructionCount );
 		DefineSymbol( token, instructionCount, ST_LABEL, qtrue );
@@ -1465,6 +1729,14 @@ void AssembleLine( void ) {
 		ignoreLabel = 0;
 	}
 
+	// unreachable code, skip instructions up to the next label
+	if ( codeDead && opcode < DIR_PROC && op->func != ASMP(LABEL) ) {
+		if ( passNumber == PASS_COMPILE && ( op->func || opcode != OP_IGNORE ) ) {
+			removedCount++;
+		}
+		return;
+	}
+
 	// execute opcode(directive) function and exit
 	if ( op->func ) {
 		op->func();
@@ -1500,13 +1772,10 @@ void AssembleLine( void ) {
 		if ( opcode == OP_BLOCK_COPY ) {
 			expression = ( expression + 3 ) & ~3;
 		}
-		EmitByte( &segment[CODESEG], opcode );
-		EmitInt( &segment[CODESEG], expression );
+		EmitInstruction( opcode, 4, expression, IsLiteral( token ), token );
 	} else {
-		EmitByte( &segment[CODESEG], opcode );
+		EmitInstruction( opcode, 0, 0, 1, NULL );
 	}
-
-	instructionCount++;
 }
 
 
@@ -1583,6 +1852,9 @@ void WriteVmFile( void ) {
 	report( "lit  segment: %7i\n", segment[LITSEG].imageUsed );
 	report( "bss  segment: %7i\n", segment[BSSSEG].imageUsed );
 	report( "instruction count: %i\n", instructionCount );
+	if ( options.peephole ) {
+		report( "removed by peephole: %i\n", removedCount );
+	}
 
 	if( !options.vanillaQ3Compatibility ) {
 		header.vmMagic = VM_MAGIC_VER2;
@@ -1720,6 +1992,7 @@ void PassDefineCompile( void ) {
 
 		segment[DATASEG].imageUsed = 4;		// skip the 0 byte, so NULL pointers are fixed up properly
 		instructionCount = 0;
+		removedCount = 0;
 
 		report( "pass #%i: %s\n", ++passCount, passName[ passNumber ] );
 
@@ -1732,10 +2005,13 @@ void PassDefineCompile( void ) {
 			ptr = asmFiles[i];
 			ignoreFunc = 0;
 			ignoreLabel = 0;
+			peepCount = 0;
+			codeDead = 0;
 			while ( ptr ) {
 				ptr = ExtractLine( ptr );
 				AssembleLine();
 			}
+			PeepholeFlush();
 			if ( ignoreFunc ) {
 				CodeError( "ignore level %i\n", ignoreFunc );
 				return;
@@ -1777,10 +2053,13 @@ void PassOptimize( void ) {
 			ptr = asmFiles[i];
 			ignoreFunc = 0;
 			ignoreLabel = 0;
+			peepCount = 0;
+			codeDead = 0;
 			while ( ptr ) {
 				ptr = ExtractLine( ptr );
 				AssembleLine();
 			}
+			PeepholeFlush();
 			if ( ignoreFunc ) {
 				CodeError( "ignore level is not zero: %i\n", ignoreFunc );
 				return;
@@ -1886,6 +2165,7 @@ static const char *banner = {
 	"    -f LISTFILE    Read options and list of files to assemble from LISTFILE\n"
 	"    -b BUCKETS     Set symbol hash table to BUCKETS buckets\n"
 	"    -r             Remove unreferenced symbols/functions from image\n"
+	"    -O             Peephole optimization and unreachable code removal, implies -r\n"
 	"    -m             Write map file\n"
 	"    -v             Verbose compilation report\n"
 	"    -vq3           Produce a qvm file compatible with Q3 1.32b\n"
@@ -1957,6 +2237,12 @@ int main( int argc, const char *argv[] ) {
 			continue;
 		}
 
+		if ( !strcmp( argv[ i ], "-O" ) ) {
+			options.optimize = qtrue;
+			options.peephole = qtrue;
+			continue;
+		}
+
 /* 
 		Verbosity option added by Timbo, 2002.09.14.
         By default (no -v option), q3asm remains silent except for critical errors.
@@ -536,3 +536,432 @@ const char *VM_CheckInstructions( instruction_t *buf, int instructionCount, int
 
 	return NULL;
 }
+
+
+/*
+=================
+VM_Create
+
+loads and checks a qvm image, data segment is rounded up to a power of two
+so every load and store can be masked into it
+=================
+*/
+const char *VM_Create( vm_t *vm, const byte *image, int imageLength, vmSyscall_t systemCall )
+{
+	static char errBuf[ 128 ];
+	const vmHeader_t *header;
+	const char *errMsg;
+	int dataLength, headerSize;
+
+	memset( vm, 0, sizeof( *vm ) );
+
+	header = (const vmHeader_t *)image;
+	if ( imageLength < (int)sizeof( *header ) - (int)sizeof( header->jtrgLength ) ) {
+		return "truncated header";
+	}
+
+	if ( header->vmMagic == VM_MAGIC_VER2 ) {
+		headerSize = sizeof( *header );
+	} else if ( header->vmMagic == VM_MAGIC ) {
+		headerSize = sizeof( *header ) - sizeof( header->jtrgLength );
+	} else {
+		return "bad magic";
+	}
+
+	if ( header->instructionCount <= 0 || header->codeOffset < headerSize || header->codeLength <= 0
+		|| header->dataLength < 0 || header->litLength < 0 || header->bssLength < 0
+		|| header->codeOffset + header->codeLength > imageLength
+		|| header->dataOffset < 0
+		|| header->dataOffset + header->dataLength + header->litLength > imageLength ) {
+		return "bad header";
+	}
+
+	vm->dataLength = header->dataLength + header->litLength + header->bssLength;
+	if ( vm->dataLength < PROGRAM_STACK_SIZE ) {
+		return "no room for the program stack";
+	}
+
+	for ( dataLength = 1; dataLength < vm->dataLength; dataLength <<= 1 )
+		;
+
+	// 4 bytes of slop, so a masked address near the end can still be read as an int
+	vm->dataBase = malloc( dataLength + 4 );
+	vm->inst = malloc( ( header->instructionCount + 8 ) * sizeof( vm->inst[0] ) );
+	if ( !vm->dataBase || !vm->inst ) {
+		VM_Free( vm );
+		return "out of memory";
+	}
+
+	memset( vm->dataBase, 0, dataLength + 4 );
+	memcpy( vm->dataBase, image + header->dataOffset, header->dataLength + header->litLength );
+	memset( vm->inst, 0, ( header->instructionCount + 8 ) * sizeof( vm->inst[0] ) );
+
+	vm->dataMask = dataLength - 1;
+	vm->instructionCount = header->instructionCount;
+
+	errMsg = VM_LoadInstructions( image + header->codeOffset, header->codeLength, vm->instructionCount, vm->inst );
+	if ( !errMsg ) {
+		errMsg = VM_CheckInstructions( vm->inst, vm->instructionCount, dataLength );
+	}
+
+	if ( errMsg ) {
+		sprintf( errBuf, "%s", errMsg );
+		VM_Free( vm );
+		return errBuf;
+	}
+
+	// stack lives at the top of the bss, q3asm reserved it there
+	vm->programStack = dataLength;
+	vm->stackBottom = dataLength - PROGRAM_STACK_SIZE;
+	vm->systemCall = systemCall;
+
+	return NULL;
+}
+
+
+void VM_Free( vm_t *vm )
+{
+	free( vm->dataBase );
+	free( vm->inst );
+	free( vm->profile );
+	memset( vm, 0, sizeof( *vm ) );
+}
+
+
+/*
+=================
+VM_ProcEnd
+
+first instruction after the procedure which starts at proc
+=================
+*/
+int VM_ProcEnd( const vm_t *vm, int proc )
+{
+	int i;
+
+	for ( i = proc + 1; i < vm->instructionCount; i++ ) {
+		if ( vm->inst[ i ].op == OP_ENTER ) {
+			break;
+		}
+	}
+
+	return i;
+}
+
+
+typedef union {
+	int			i;
+	unsigned	u;
+	float		f;
+} vmCell_t;
+
+#define	OPSTACK_SIZE	1024
+
+#define	VM_INT( a )		( *(int *)&image[ (a) & dataMask ] )
+
+/*
+=================
+VM_Call
+
+runs vmMain with the given arguments, may be entered again from a syscall
+=================
+*/
+int VM_Call( vm_t *vm, int numArgs, const int *args )
+{
+	vmCell_t		opStack[ OPSTACK_SIZE ];
+	intptr_t		sysArgs[ MAX_VMSYSCALL_ARGS ];
+	instruction_t	*ci;
+	byte			*image;
+	int				dataMask;
+	int				programStack, stackOnEntry;
+	int				pc, top, i, r0, r1;
+	unsigned		dst, src;
+
+	image = vm->dataBase;
+	dataMask = vm->dataMask;
+
+	stackOnEntry = vm->programStack;
+	programStack = stackOnEntry - ( 8 + 4 * MAX_VMMAIN_ARGS );
+	if ( programStack < vm->stackBottom ) {
+		Error( "VM_Call: program stack overflow" );
+	}
+
+	for ( i = 0; i < MAX_VMMAIN_ARGS; i++ ) {
+		VM_INT( programStack + 8 + i * 4 ) = ( i < numArgs ) ? args[ i ] : 0;
+	}
+
+	VM_INT( programStack + 4 ) = 0;
+	VM_INT( programStack ) = -1;		// LEAVE to this address ends the call
+
+	top = 0;
+	opStack[ 0 ].i = 0;
+	pc = 0;
+
+	for ( ;; ) {
+		if ( (unsigned)pc >= (unsigned)vm->instructionCount ) {
+			Error( "VM_Call: pc %i out of range", pc );
+		}
+
+		ci = &vm->inst[ pc ];
+		if ( vm->profile ) {
+			vm->profile[ pc ]++;
+		}
+		pc++;
+
+		switch ( ci->op ) {
+		case OP_UNDEF:
+		case OP_BREAK:
+			Error( "VM_Call: bad opcode %i at %i", ci->op, pc - 1 );
+			break;
+
+		case OP_IGNORE:
+			break;
+
+		case OP_ENTER:
+			programStack -= ci->value;
+			if ( programStack < vm->stackBottom ) {
+				Error( "VM_Call: program stack overflow at %i", pc - 1 );
+			}
+			// VM_CheckInstructions() limits a single procedure to PROC_OPSTACK_SIZE
+			if ( top + PROC_OPSTACK_SIZE >= OPSTACK_SIZE ) {
+				Error( "VM_Call: opStack overflow at %i", pc - 1 );
+			}
+			break;
+
+		case OP_LEAVE:
+			programStack += ci->value;
+			pc = VM_INT( programStack );
+			if ( pc == -1 ) {
+				vm->programStack = stackOnEntry;
+				return opStack[ top ].i;
+			}
+			break;
+
+		case OP_CALL:
+			r0 = opStack[ top ].i;
+			top--;
+			VM_INT( programStack ) = pc;
+			if ( r0 >= 0 ) {
+				pc = r0;
+				break;
+			}
+			// syscall, leave the stack below our frame to a VM_Call() from inside it
+			vm->programStack = programStack - 4;
+			VM_INT( programStack + 4 ) = -1 - r0;
+			for ( i = 0; i < MAX_VMSYSCALL_ARGS; i++ ) {
+				sysArgs[ i ] = VM_INT( programStack + 4 + i * 4 );
+			}
+			opStack[ ++top ].i = (int)vm->systemCall( vm, sysArgs );
+			vm->programStack = stackOnEntry;
+			pc = VM_INT( programStack );
+			break;
+
+		case OP_PUSH:
+			opStack[ ++top ].i = 0;
+			break;
+
+		case OP_POP:
+			top--;
+			break;
+
+		case OP_CONST:
+			opStack[ ++top ].i = ci->value;
+			break;
+
+		case OP_LOCAL:
+			opStack[ ++top ].i = programStack + ci->value;
+			break;
+
+		case OP_JUMP:
+			pc = opStack[ top ].i;
+			top--;
+			break;
+
+		case OP_EQ:  top -= 2; if ( opStack[ top + 1 ].i == opStack[ top + 2 ].i ) pc = ci->value; break;
+		case OP_NE:  top -= 2; if ( opStack[ top + 1 ].i != opStack[ top + 2 ].i ) pc = ci->value; break;
+		case OP_LTI: top -= 2; if ( opStack[ top + 1 ].i <  opStack[ top + 2 ].i ) pc = ci->value; break;
+		case OP_LEI: top -= 2; if ( opStack[ top + 1 ].i <= opStack[ top + 2 ].i ) pc = ci->value; break;
+		case OP_GTI: top -= 2; if ( opStack[ top + 1 ].i >  opStack[ top + 2 ].i ) pc = ci->value; break;
+		case OP_GEI: top -= 2; if ( opStack[ top + 1 ].i >= opStack[ top + 2 ].i ) pc = ci->value; break;
+		case OP_LTU: top -= 2; if ( opStack[ top + 1 ].u <  opStack[ top + 2 ].u ) pc = ci->value; break;
+		case OP_LEU: top -= 2; if ( opStack[ top + 1 ].u <= opStack[ top + 2 ].u ) pc = ci->value; break;
+		case OP_GTU: top -= 2; if ( opStack[ top + 1 ].u >  opStack[ top + 2 ].u ) pc = ci->value; break;
+		case OP_GEU: top -= 2; if ( opStack[ top + 1 ].u >= opStack[ top + 2 ].u ) pc = ci->value; break;
+		case OP_EQF: top -= 2; if ( opStack[ top + 1 ].f == opStack[ top + 2 ].f ) pc = ci->value; break;
+		case OP_NEF: top -= 2; if ( opStack[ top + 1 ].f != opStack[ top + 2 ].f ) pc = ci->value; break;
+		case OP_LTF: top -= 2; if ( opStack[ top + 1 ].f <  opStack[ top + 2 ].f ) pc = ci->value; break;
+		case OP_LEF: top -= 2; if ( opStack[ top + 1 ].f <= opStack[ top + 2 ].f ) pc = ci->value; break;
+		case OP_GTF: top -= 2; if ( opStack[ top + 1 ].f >  opStack[ top + 2 ].f ) pc = ci->value; break;
+		case OP_GEF: top -= 2; if ( opStack[ top + 1 ].f >= opStack[ top + 2 ].f ) pc = ci->value; break;
+
+		case OP_LOAD1:
+			opStack[ top ].i = image[ opStack[ top ].i & dataMask ];
+			break;
+
+		case OP_LOAD2:
+			opStack[ top ].i = *(unsigned short *)&image[ opStack[ top ].i & dataMask ];
+			break;
+
+		case OP_LOAD4:
+			opStack[ top ].i = VM_INT( opStack[ top ].i );
+			break;
+
+		case OP_STORE1:
+			image[ opStack[ top - 1 ].i & dataMask ] = (byte)opStack[ top ].i;
+			top -= 2;
+			break;
+
+		case OP_STORE2:
+			*(unsigned short *)&image[ opStack[ top - 1 ].i & dataMask ] = (unsigned short)opStack[ top ].i;
+			top -= 2;
+			break;
+
+		case OP_STORE4:
+			VM_INT( opStack[ top - 1 ].i ) = opStack[ top ].i;
+			top -= 2;
+			break;
+
+		case OP_ARG:
+			VM_INT( programStack + ci->value ) = opStack[ top ].i;
+			top--;
+			break;
+
+		case OP_BLOCK_COPY:
+			dst = opStack[ top - 1 ].u;
+			src = opStack[ top ].u;
+			if ( ( dst & dataMask ) != dst || ( src & dataMask ) != src
+				|| dst + ci->value > (unsigned)dataMask + 1 || src + ci->value > (unsigned)dataMask + 1 ) {
+				Error( "VM_Call: block copy out of range at %i", pc - 1 );
+			}
+			memmove( image + dst, image + src, ci->value );
+			top -= 2;
+			break;
+
+		case OP_SEX8:
+			opStack[ top ].i = (signed char)opStack[ top ].i;
+			break;
+
+		case OP_SEX16:
+			opStack[ top ].i = (short)opStack[ top ].i;
+			break;
+
+		case OP_NEGI:
+			opStack[ top ].u = 0u - opStack[ top ].u;
+			break;
+
+		case OP_ADD:
+			opStack[ top - 1 ].u += opStack[ top ].u;
+			top--;
+			break;
+
+		case OP_SUB:
+			opStack[ top - 1 ].u -= opStack[ top ].u;
+			top--;
+			break;
+
+		case OP_DIVI:
+		case OP_MODI:
+			r1 = opStack[ top - 1 ].i;
+			r0 = opStack[ top ].i;
+			if ( r0 == 0 ) {
+				Error( "VM_Call: division by zero at %i", pc - 1 );
+			}
+			// INT_MIN / -1 would trap on the host
+			if ( r0 == -1 ) {
+				opStack[ top - 1 ].u = ( ci->op == OP_DIVI ) ? 0u - (unsigned)r1 : 0;
+			} else {
+				opStack[ top - 1 ].i = ( ci->op == OP_DIVI ) ? r1 / r0 : r1 % r0;
+			}
+			top--;
+			break;
+
+		case OP_DIVU:
+		case OP_MODU:
+			if ( opStack[ top ].u == 0 ) {
+				Error( "VM_Call: division by zero at %i", pc - 1 );
+			}
+			if ( ci->op == OP_DIVU ) {
+				opStack[ top - 1 ].u /= opStack[ top ].u;
+			} else {
+				opStack[ top - 1 ].u %= opStack[ top ].u;
+			}
+			top--;
+			break;
+
+		case OP_MULI:
+		case OP_MULU:
+			opStack[ top - 1 ].u *= opStack[ top ].u;
+			top--;
+			break;
+
+		case OP_BAND:
+			opStack[ top - 1 ].u &= opStack[ top ].u;
+			top--;
+			break;
+
+		case OP_BOR:
+			opStack[ top - 1 ].u |= opStack[ top ].u;
+			top--;
+			break;
+
+		case OP_BXOR:
+			opStack[ top - 1 ].u ^= opStack[ top ].u;
+			top--;
+			break;
+
+		case OP_BCOM:
+			opStack[ top ].u = ~opStack[ top ].u;
+			break;
+
+		case OP_LSH:
+			opStack[ top - 1 ].u <<= ( opStack[ top ].u & 31 );
+			top--;
+			break;
+
+		case OP_RSHI:
+			opStack[ top - 1 ].i >>= ( opStack[ top ].u & 31 );
+			top--;
+			break;
+
+		case OP_RSHU:
+			opStack[ top - 1 ].u >>= ( opStack[ top ].u & 31 );
+			top--;
+			break;
+
+		case OP_NEGF:
+			opStack[ top ].f = -opStack[ top ].f;
+			break;
+
+		case OP_ADDF:
+			opStack[ top - 1 ].f += opStack[ top ].f;
+			top--;
+			break;
+
+		case OP_SUBF:
+			opStack[ top - 1 ].f -= opStack[ top ].f;
+			top--;
+			break;
+
+		case OP_DIVF:
+			opStack[ top - 1 ].f /= opStack[ top ].f;
+			top--;
+			break;
+
+		case OP_MULF:
+			opStack[ top - 1 ].f *= opStack[ top ].f;
+			top--;
+			break;
+
+		case OP_CVIF:
+			opStack[ top ].f = (float)opStack[ top ].i;
+			break;
+
+		case OP_CVFI:
+			opStack[ top ].i = (int)opStack[ top ].f;
+			break;
+
+		default:
+			Error( "VM_Call: bad opcode %i at %i", ci->op, pc - 1 );
+		}
+	}
+}
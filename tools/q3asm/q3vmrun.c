@@ -0,0 +1,1883 @@
+/*
+	q3vmrun - headless runner for the game qvm
+
+	Loads qwprogs.qvm into the interpreter from q3vm.c, answers its syscalls
+	with a small stand-in engine and drives the same vmMain() sequence the
+	server does: GAME_INIT, GAME_LOADENTS, then StartFrame and entity thinks
+	every frame. Reports executed instructions per function.
+
+	With -native the native library is run in lock step under the same
+	stand-in engine and game state of both builds is compared after every frame.
+
+	The stand-in world has no geometry: traces never hit anything, droptofloor
+	leaves entities where they are and clients never connect. Files are read
+	from -basedir, whatever the game writes is discarded.
+*/
+
+#include "qvm.h"
+#include "cmdlib.h"
+#include <math.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#include <time.h>
+#endif
+
+#ifndef M_PI
+#define M_PI		3.14159265358979323846
+#endif
+
+#define GAME_API_VERSION	16
+
+#define	MAX_GAMES		2
+#define	MAX_CLIENTS		32			// client edicts always follow the world
+#define	MAX_EDICTS		8192
+#define	MAX_CVARS		1024
+#define	MAX_MODELS		512
+#define	MAX_FILES		64
+#define	MAX_ARGS		64
+#define	MAX_DIFFS		20			// printed per frame
+
+// must be synced with gameImport_t in include/g_public.h
+typedef enum {
+	G_GETAPIVERSION,
+	G_DPRINT,
+	G_ERROR,
+	G_GetEntityToken,
+	G_SPAWN_ENT,
+	G_REMOVE_ENT,
+	G_PRECACHE_SOUND,
+	G_PRECACHE_MODEL,
+	G_LIGHTSTYLE,
+	G_SETORIGIN,
+	G_SETSIZE,
+	G_SETMODEL,
+	G_BPRINT,
+	G_SPRINT,
+	G_CENTERPRINT,
+	G_AMBIENTSOUND,
+	G_SOUND,
+	G_TRACELINE,
+	G_CHECKCLIENT,
+	G_STUFFCMD,
+	G_LOCALCMD,
+	G_CVAR,
+	G_CVAR_SET,
+	G_FINDRADIUS,
+	G_WALKMOVE,
+	G_DROPTOFLOOR,
+	G_CHECKBOTTOM,
+	G_POINTCONTENTS,
+	G_NEXTENT,
+	G_AIM,
+	G_MAKESTATIC,
+	G_SETSPAWNPARAMS,
+	G_CHANGELEVEL,
+	G_LOGFRAG,
+	G_GETINFOKEY,
+	G_MULTICAST,
+	G_DISABLEUPDATES,
+	G_WRITEBYTE,
+	G_WRITECHAR,
+	G_WRITESHORT,
+	G_WRITELONG,
+	G_WRITEANGLE,
+	G_WRITECOORD,
+	G_WRITESTRING,
+	G_WRITEENTITY,
+	G_FLUSHSIGNON,
+	g_memset,
+	g_memcpy,
+	g_strncpy,
+	g_sin,
+	g_cos,
+	g_atan2,
+	g_sqrt,
+	g_floor,
+	g_ceil,
+	g_acos,
+	G_CMD_ARGC,
+	G_CMD_ARGV,
+	G_TraceCapsule,
+	G_FSOpenFile,
+	G_FSCloseFile,
+	G_FSReadFile,
+	G_FSWriteFile,
+	G_FSSeekFile,
+	G_FSTellFile,
+	G_FSGetFileList,
+	G_CVAR_SET_FLOAT,
+	G_CVAR_STRING,
+	G_Map_Extension,
+	G_strcmp,
+	G_strncmp,
+	G_stricmp,
+	G_strnicmp,
+	G_Find,
+	G_executecmd,
+	G_conprint,
+	G_readcmd,
+	G_redirectcmd,
+	G_Add_Bot,
+	G_Remove_Bot,
+	G_SetBotUserInfo,
+	G_SetBotCMD,
+	G_QVMstrftime,
+	G_CMD_ARGS,
+	G_CMD_TOKENIZE,
+	g_strlcpy,
+	g_strlcat,
+	G_MAKEVECTORS,
+	G_NEXTCLIENT,
+	G_PRECACHE_VWEP_MODEL,
+	G_SETPAUSE,
+	G_SETUSERINFO,
+	G_MOVETOGOAL,
+	G_VISIBLETO
+} gameImport_t;
+
+// must be synced with gameExport_t in include/g_public.h
+typedef enum {
+	GAME_INIT,
+	GAME_LOADENTS,
+	GAME_SHUTDOWN,
+	GAME_START_FRAME = 11,
+	GAME_EDICT_THINK = 16,
+	GAME_CLEAR_EDICT = 20
+} gameExport_t;
+
+typedef enum {
+	FT_FLOAT,
+	FT_ENTITY,			// byte offset from the first edict
+	FT_STRING,			// byte offset of the string pointer in the edict, not compared
+	FT_FUNCTION,		// same for function pointers
+	FT_SKIP
+} fieldType_t;
+
+typedef struct {
+	const char	*name;
+	fieldType_t	type;
+	int			count;
+} gameField_t;
+
+// entvars_t and globalvars_t from include/progdefs.h, every field is 4 bytes in both builds
+static const gameField_t entityFields[] = {
+	{ "modelindex", FT_FLOAT, 1 },		{ "absmin", FT_FLOAT, 3 },			{ "absmax", FT_FLOAT, 3 },
+	{ "ltime", FT_FLOAT, 1 },			{ "lastruntime", FT_FLOAT, 1 },		{ "movetype", FT_FLOAT, 1 },
+	{ "solid", FT_FLOAT, 1 },			{ "origin", FT_FLOAT, 3 },			{ "oldorigin", FT_FLOAT, 3 },
+	{ "velocity", FT_FLOAT, 3 },		{ "angles", FT_FLOAT, 3 },			{ "avelocity", FT_FLOAT, 3 },
+	{ "classname", FT_STRING, 1 },		{ "model", FT_STRING, 1 },			{ "frame", FT_FLOAT, 1 },
+	{ "skin", FT_FLOAT, 1 },			{ "effects", FT_FLOAT, 1 },			{ "mins", FT_FLOAT, 3 },
+	{ "maxs", FT_FLOAT, 3 },			{ "size", FT_FLOAT, 3 },			{ "touch", FT_FUNCTION, 1 },
+	{ "use", FT_FUNCTION, 1 },			{ "think", FT_FUNCTION, 1 },		{ "blocked", FT_FUNCTION, 1 },
+	{ "nextthink", FT_FLOAT, 1 },		{ "groundentity", FT_ENTITY, 1 },	{ "health", FT_FLOAT, 1 },
+	{ "frags", FT_FLOAT, 1 },			{ "weapon", FT_FLOAT, 1 },			{ "weaponmodel", FT_STRING, 1 },
+	{ "weaponframe", FT_FLOAT, 1 },		{ "currentammo", FT_FLOAT, 1 },		{ "ammo_shells", FT_FLOAT, 1 },
+	{ "ammo_nails", FT_FLOAT, 1 },		{ "ammo_rockets", FT_FLOAT, 1 },	{ "ammo_cells", FT_FLOAT, 1 },
+	{ "items", FT_FLOAT, 1 },			{ "takedamage", FT_FLOAT, 1 },		{ "chain", FT_ENTITY, 1 },
+	{ "deadflag", FT_FLOAT, 1 },		{ "view_ofs", FT_FLOAT, 3 },		{ "button0", FT_FLOAT, 1 },
+	{ "button1", FT_FLOAT, 1 },			{ "button2", FT_FLOAT, 1 },			{ "impulse", FT_FLOAT, 1 },
+	{ "fixangle", FT_FLOAT, 1 },		{ "v_angle", FT_FLOAT, 3 },			{ "netname", FT_STRING, 1 },
+	{ "enemy", FT_ENTITY, 1 },			{ "flags", FT_FLOAT, 1 },			{ "colormap", FT_FLOAT, 1 },
+	{ "team", FT_FLOAT, 1 },			{ "max_health", FT_FLOAT, 1 },		{ "teleport_time", FT_FLOAT, 1 },
+	{ "armortype", FT_FLOAT, 1 },		{ "armorvalue", FT_FLOAT, 1 },		{ "waterlevel", FT_FLOAT, 1 },
+	{ "watertype", FT_FLOAT, 1 },		{ "ideal_yaw", FT_FLOAT, 1 },		{ "yaw_speed", FT_FLOAT, 1 },
+	{ "aiment", FT_ENTITY, 1 },			{ "goalentity", FT_ENTITY, 1 },		{ "spawnflags", FT_FLOAT, 1 },
+	{ "target", FT_STRING, 1 },			{ "targetname", FT_STRING, 1 },		{ "dmg_take", FT_FLOAT, 1 },
+	{ "dmg_save", FT_FLOAT, 1 },		{ "dmg_inflictor", FT_ENTITY, 1 },	{ "owner", FT_ENTITY, 1 },
+	{ "movedir", FT_FLOAT, 3 },			{ "message", FT_STRING, 1 },		{ "sounds", FT_FLOAT, 1 },
+	{ "noise", FT_STRING, 1 },			{ "noise1", FT_STRING, 1 },			{ "noise2", FT_STRING, 1 },
+	{ "noise3", FT_STRING, 1 },
+	{ NULL, FT_SKIP, 0 }
+};
+
+static const gameField_t globalFields[] = {
+	{ "pad", FT_SKIP, 28 },
+	{ "self", FT_ENTITY, 1 },			{ "other", FT_ENTITY, 1 },			{ "world", FT_ENTITY, 1 },
+	{ "time", FT_FLOAT, 1 },			{ "frametime", FT_FLOAT, 1 },		{ "newmis", FT_ENTITY, 1 },
+	{ "force_retouch", FT_FLOAT, 1 },	{ "mapname", FT_STRING, 1 },		{ "serverflags", FT_FLOAT, 1 },
+	{ "total_secrets", FT_FLOAT, 1 },	{ "total_monsters", FT_FLOAT, 1 },	{ "found_secrets", FT_FLOAT, 1 },
+	{ "killed_monsters", FT_FLOAT, 1 },	{ "parm", FT_FLOAT, 16 },			{ "v_forward", FT_FLOAT, 3 },
+	{ "v_up", FT_FLOAT, 3 },			{ "v_right", FT_FLOAT, 3 },			{ "trace", FT_SKIP, 13 },
+	{ "msg_entity", FT_ENTITY, 1 },		{ "funcs", FT_FUNCTION, 10 },
+	{ NULL, FT_SKIP, 0 }
+};
+
+// word offsets into entvars_t
+#define	EV_MODELINDEX	0
+#define	EV_ABSMIN		1
+#define	EV_ABSMAX		4
+#define	EV_LTIME		7
+#define	EV_MOVETYPE		9
+#define	EV_SOLID		10
+#define	EV_ORIGIN		11
+#define	EV_VELOCITY		17
+#define	EV_ANGLES		20
+#define	EV_AVELOCITY	23
+#define	EV_CLASSNAME	26
+#define	EV_MODEL		27
+#define	EV_FRAME		28
+#define	EV_SKIN			29
+#define	EV_MINS			31
+#define	EV_MAXS			34
+#define	EV_SIZE			37
+#define	EV_NEXTTHINK	44
+#define	EV_GROUNDENTITY	45
+#define	EV_TAKEDAMAGE	57
+#define	EV_FLAGS		73
+#define	EV_COLORMAP		74
+#define	EV_IDEAL_YAW	82
+#define	EV_WORDS		102
+
+// word offsets into globalvars_t
+#define	GV_SELF				28
+#define	GV_OTHER			29
+#define	GV_TIME				31
+#define	GV_FRAMETIME		32
+#define	GV_V_FORWARD		57
+#define	GV_V_UP				60
+#define	GV_V_RIGHT			63
+#define	GV_TRACE_ALLSOLID	66
+#define	GV_TRACE_STARTSOLID	67
+#define	GV_TRACE_FRACTION	68
+#define	GV_TRACE_ENDPOS		69
+#define	GV_TRACE_NORMAL		72
+#define	GV_TRACE_DIST		75
+#define	GV_TRACE_ENT		76
+#define	GV_TRACE_INOPEN		77
+#define	GV_TRACE_INWATER	78
+
+#define	MOVETYPE_NONE		0
+#define	MOVETYPE_STEP		4
+#define	MOVETYPE_FLY		5
+#define	MOVETYPE_TOSS		6
+#define	MOVETYPE_PUSH		7
+#define	MOVETYPE_NOCLIP		8
+#define	MOVETYPE_FLYMISSILE	9
+#define	MOVETYPE_BOUNCE		10
+
+#define	SOLID_NOT			0
+#define	SOLID_BSP			4
+#define	FL_ONGROUND			512
+#define	CONTENTS_EMPTY		-1
+
+typedef intptr_t (*nativeMain_t)( int command, int arg0, int arg1, int arg2, int arg3, int arg4,
+	int arg5, int arg6, int arg7, int arg8, int arg9, int arg10, int arg11 );
+typedef void (*nativeEntry_t)( intptr_t (*syscall)( intptr_t arg, ... ) );
+
+// gameData_t as returned by GAME_INIT
+typedef struct {
+	int		ents;
+	int		sizeofent;
+	int		global;
+	int		fields;
+	int		APIversion;
+	int		maxentities;
+} qvmGameData_t;
+
+typedef struct {
+	void	*ents;
+	int		sizeofent;
+	void	*global;
+	void	*fields;
+	int		APIversion;
+	int		maxentities;
+} nativeGameData_t;
+
+typedef struct {
+	char	name[ 64 ];
+	char	string[ 256 ];
+} cvar_t;
+
+typedef struct {
+	FILE		*f;
+	qboolean	used;			// opened for writing when f is NULL
+} gameFile_t;
+
+typedef struct {
+	const char		*name;
+	qboolean		qvm;
+	vm_t			vm;
+	nativeMain_t	vmMain;
+
+	intptr_t		entsRef;	// g_edicts as the game sees it
+	byte			*ents;
+	int				sizeofent;
+	int				maxentities;
+	int				*globals;
+
+	int				numEdicts;
+	byte			freeEnt[ MAX_EDICTS ];
+	float			freeTime[ MAX_EDICTS ];
+
+	float			time;
+	float			frametime;
+	qboolean		changelevel;
+	qboolean		midLine;		// last print did not end the line
+
+	char			*entCursor;
+
+	cvar_t			cvars[ MAX_CVARS ];
+	int				numCvars;
+	char			models[ MAX_MODELS ][ 64 ];
+	int				numModels;
+	gameFile_t		files[ MAX_FILES ];
+	char			argv[ MAX_ARGS ][ 256 ];
+	int				argc;
+} game_t;
+
+static game_t		games[ MAX_GAMES ];
+static int			numGames;
+static game_t		*nativeGame;		// native syscalls carry no context
+
+static char			*entityString;
+static const char	*mapName = "start";
+static const char	*baseDir = ".";
+static qboolean		verbose;
+static float		epsilon;
+
+static const char	*setNames[ MAX_CVARS ];
+static const char	*setValues[ MAX_CVARS ];
+static int			numSets;
+
+static const char defaultEntities[] =
+	"{\n\"classname\" \"worldspawn\"\n}\n"
+	"{\n\"classname\" \"info_player_deathmatch\"\n\"origin\" \"0 0 24\"\n}\n";
+
+/*
+=================
+Game memory access, qvm pointers are offsets into the data segment
+=================
+*/
+static void *G_Ptr( game_t *g, intptr_t p )
+{
+	if ( g->qvm ) {
+		return g->vm.dataBase + ( (int)p & g->vm.dataMask );
+	}
+
+	return (void *)p;
+}
+
+// pointer to a block the game passed in, refuses blocks running out of the qvm image
+static void *G_Block( game_t *g, intptr_t p, intptr_t size )
+{
+	if ( g->qvm && ( size < 0 || ( (int)p & g->vm.dataMask ) + size > g->vm.dataMask + 1 ) ) {
+		Error( "%s: syscall block %i + %i out of range", g->name, (int)p, (int)size );
+	}
+
+	return G_Ptr( g, p );
+}
+
+static intptr_t G_Ref( game_t *g, void *p )
+{
+	if ( g->qvm ) {
+		return (byte *)p - g->vm.dataBase;
+	}
+
+	return (intptr_t)p;
+}
+
+// pointer stored in game memory, 4 bytes in qvm
+static intptr_t G_ReadPtr( game_t *g, void *at )
+{
+	if ( g->qvm ) {
+		return *(int *)at;
+	}
+
+	return *(intptr_t *)at;
+}
+
+static void G_WritePtr( game_t *g, void *at, intptr_t p )
+{
+	if ( g->qvm ) {
+		*(int *)at = (int)p;
+	} else {
+		*(intptr_t *)at = p;
+	}
+}
+
+static float G_Float( intptr_t a )
+{
+	int		i = (int)a;
+	float	f;
+
+	memcpy( &f, &i, sizeof( f ) );
+
+	return f;
+}
+
+static intptr_t G_FloatRet( float f )
+{
+	int		i;
+
+	memcpy( &i, &f, sizeof( i ) );
+
+	return i;
+}
+
+static byte *G_Edict( game_t *g, int n )
+{
+	return g->ents + n * g->sizeofent;
+}
+
+#define	EV_F( e, w )	( ((float *)(e))[ w ] )
+#define	EV_I( e, w )	( ((int *)(e))[ w ] )
+#define	GV_F( g, w )	( ((float *)(g)->globals)[ w ] )
+#define	GV_I( g, w )	( (g)->globals[ w ] )
+
+static int G_EntNum( game_t *g, intptr_t ref )
+{
+	intptr_t ofs = ref - g->entsRef;
+
+	if ( ofs < 0 || ofs >= (intptr_t)g->numEdicts * g->sizeofent ) {
+		return -1;
+	}
+
+	return (int)( ofs / g->sizeofent );
+}
+
+// string field of an edict, the entvars word holds the offset of the real pointer from the first edict
+static const char *G_EntString( game_t *g, int n, int word )
+{
+	int			ofs = EV_I( G_Edict( g, n ), word );
+	intptr_t	p;
+
+	if ( ofs <= 0 || ofs > g->sizeofent * g->maxentities - (int)sizeof( intptr_t ) ) {
+		return "";
+	}
+
+	p = G_ReadPtr( g, g->ents + ofs );
+
+	return p ? (const char *)G_Ptr( g, p ) : "";
+}
+
+static void G_SetEntString( game_t *g, int n, int word, intptr_t p )
+{
+	int ofs = EV_I( G_Edict( g, n ), word );
+
+	if ( ofs > 0 && ofs <= g->sizeofent * g->maxentities - (int)sizeof( intptr_t ) ) {
+		G_WritePtr( g, g->ents + ofs, p );
+	}
+}
+
+/*
+=================
+Stand-in engine
+=================
+*/
+static void G_Print( game_t *g, const char *fmt, ... )
+{
+	va_list	argptr;
+	char	text[ 4096 ];
+
+	if ( !verbose ) {
+		return;
+	}
+
+	va_start( argptr, fmt );
+	vsnprintf( text, sizeof( text ), fmt, argptr );
+	va_end( argptr );
+
+	if ( !text[ 0 ] ) {
+		return;
+	}
+
+	if ( !g->midLine ) {
+		printf( "[%s] ", g->name );
+	}
+
+	printf( "%s", text );
+	g->midLine = ( text[ strlen( text ) - 1 ] != '\n' );
+}
+
+static cvar_t *Cvar_Find( game_t *g, const char *name )
+{
+	int i;
+
+	for ( i = 0; i < g->numCvars; i++ ) {
+		if ( !strcmp( g->cvars[ i ].name, name ) ) {
+			return &g->cvars[ i ];
+		}
+	}
+
+	return NULL;
+}
+
+static const char *Cvar_String( game_t *g, const char *name )
+{
+	cvar_t *var = Cvar_Find( g, name );
+
+	return var ? var->string : "";
+}
+
+static void Cvar_Set( game_t *g, const char *name, const char *value )
+{
+	cvar_t *var = Cvar_Find( g, name );
+
+	if ( !var ) {
+		if ( g->numCvars >= MAX_CVARS ) {
+			Error( "%s: too many cvars", g->name );
+		}
+		var = &g->cvars[ g->numCvars++ ];
+		strncpy( var->name, name, sizeof( var->name ) - 1 );
+	}
+
+	strncpy( var->string, value, sizeof( var->string ) - 1 );
+}
+
+// token of an entity string or command line, quotes group words
+static char *G_Parse( char *data, char *token, int size )
+{
+	int len = 0;
+
+	token[ 0 ] = 0;
+	if ( !data ) {
+		return NULL;
+	}
+
+	while ( *data && (byte)*data <= ' ' ) {
+		data++;
+	}
+
+	if ( !*data ) {
+		return NULL;
+	}
+
+	if ( *data == '"' ) {
+		data++;
+		while ( *data && *data != '"' ) {
+			if ( len < size - 1 ) {
+				token[ len++ ] = *data;
+			}
+			data++;
+		}
+		if ( *data ) {
+			data++;
+		}
+	} else {
+		while ( (byte)*data > ' ' ) {
+			if ( len < size - 1 ) {
+				token[ len++ ] = *data;
+			}
+			data++;
+		}
+	}
+
+	token[ len ] = 0;
+
+	return data;
+}
+
+static void G_CopyString( game_t *g, intptr_t dst, intptr_t size, const char *src )
+{
+	char *d;
+
+	if ( size <= 0 ) {
+		return;
+	}
+
+	d = G_Block( g, dst, size );
+	strncpy( d, src, size - 1 );
+	d[ size - 1 ] = 0;
+}
+
+static void G_LinkEdict( byte *e )
+{
+	int i;
+
+	for ( i = 0; i < 3; i++ ) {
+		EV_F( e, EV_ABSMIN + i ) = EV_F( e, EV_ORIGIN + i ) + EV_F( e, EV_MINS + i );
+		EV_F( e, EV_ABSMAX + i ) = EV_F( e, EV_ORIGIN + i ) + EV_F( e, EV_MAXS + i );
+	}
+}
+
+static intptr_t G_CallGame( game_t *g, int command, int arg0, int arg1 )
+{
+	int		args[ MAX_VMMAIN_ARGS ];
+	game_t	*oldGame = nativeGame;
+	intptr_t r;
+
+	if ( g->qvm ) {
+		memset( args, 0, sizeof( args ) );
+		args[ 0 ] = command;
+		args[ 1 ] = arg0;
+		args[ 2 ] = arg1;
+
+		return VM_Call( &g->vm, MAX_VMMAIN_ARGS, args );
+	}
+
+	nativeGame = g;
+	r = g->vmMain( command, arg0, arg1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 );
+	nativeGame = oldGame;
+
+	return r;
+}
+
+// same as ED_ClearEdict() of the engine, the game sets up its field offsets
+static void G_ClearEdict( game_t *g, int n )
+{
+	int oldSelf = GV_I( g, GV_SELF );
+
+	memset( G_Edict( g, n ), 0, g->sizeofent );
+	g->freeEnt[ n ] = 0;
+
+	GV_I( g, GV_SELF ) = n * g->sizeofent;
+	G_CallGame( g, GAME_CLEAR_EDICT, 0, 0 );
+	GV_I( g, GV_SELF ) = oldSelf;
+}
+
+static int G_Spawn( game_t *g )
+{
+	int i;
+
+	for ( i = MAX_CLIENTS + 1; i < g->numEdicts; i++ ) {
+		// give the client side some time to forget about removed entities
+		if ( g->freeEnt[ i ] && ( g->freeTime[ i ] < 2 || g->time - g->freeTime[ i ] > 0.5 ) ) {
+			G_ClearEdict( g, i );
+
+			return i;
+		}
+	}
+
+	if ( g->numEdicts >= g->maxentities ) {
+		Error( "%s: no free edicts", g->name );
+	}
+
+	i = g->numEdicts++;
+	G_ClearEdict( g, i );
+
+	return i;
+}
+
+static void G_Remove( game_t *g, int n )
+{
+	byte *e;
+
+	if ( n <= MAX_CLIENTS || n >= g->numEdicts ) {
+		G_Print( g, "tried to remove world or client %i\n", n );
+
+		return;
+	}
+
+	e = G_Edict( g, n );
+	G_SetEntString( g, n, EV_MODEL, 0 );
+	EV_F( e, EV_TAKEDAMAGE ) = 0;
+	EV_F( e, EV_MODELINDEX ) = 0;
+	EV_F( e, EV_COLORMAP ) = 0;
+	EV_F( e, EV_SKIN ) = 0;
+	EV_F( e, EV_FRAME ) = 0;
+	memset( &EV_F( e, EV_ORIGIN ), 0, 3 * sizeof( float ) );
+	memset( &EV_F( e, EV_ANGLES ), 0, 3 * sizeof( float ) );
+	EV_F( e, EV_NEXTTHINK ) = -1;
+	EV_F( e, EV_SOLID ) = SOLID_NOT;
+
+	g->freeEnt[ n ] = 1;
+	g->freeTime[ n ] = g->time;
+}
+
+static int G_ModelIndex( game_t *g, const char *name )
+{
+	int i;
+
+	for ( i = 0; i < g->numModels; i++ ) {
+		if ( !strcmp( g->models[ i ], name ) ) {
+			return i + 1;
+		}
+	}
+
+	if ( g->numModels >= MAX_MODELS ) {
+		Error( "%s: too many models", g->name );
+	}
+
+	strncpy( g->models[ g->numModels ], name, sizeof( g->models[ 0 ] ) - 1 );
+
+	return ++g->numModels;
+}
+
+// nothing to hit in an empty world
+static void G_Trace( game_t *g, intptr_t *args )
+{
+	int i;
+
+	GV_F( g, GV_TRACE_ALLSOLID ) = 0;
+	GV_F( g, GV_TRACE_STARTSOLID ) = 0;
+	GV_F( g, GV_TRACE_FRACTION ) = 1;
+	for ( i = 0; i < 3; i++ ) {
+		GV_F( g, GV_TRACE_ENDPOS + i ) = G_Float( args[ 4 + i ] );
+		GV_F( g, GV_TRACE_NORMAL + i ) = 0;
+	}
+	GV_F( g, GV_TRACE_DIST ) = 0;
+	GV_I( g, GV_TRACE_ENT ) = 0;
+	GV_F( g, GV_TRACE_INOPEN ) = 1;
+	GV_F( g, GV_TRACE_INWATER ) = 0;
+}
+
+static void G_MakeVectors( game_t *g, const float *angles )
+{
+	float	sp, sy, sr, cp, cy, cr;
+	float	*forward = &GV_F( g, GV_V_FORWARD );
+	float	*right = &GV_F( g, GV_V_RIGHT );
+	float	*up = &GV_F( g, GV_V_UP );
+
+	sy = sin( angles[ 1 ] * ( M_PI * 2 / 360 ) );
+	cy = cos( angles[ 1 ] * ( M_PI * 2 / 360 ) );
+	sp = sin( angles[ 0 ] * ( M_PI * 2 / 360 ) );
+	cp = cos( angles[ 0 ] * ( M_PI * 2 / 360 ) );
+	sr = sin( angles[ 2 ] * ( M_PI * 2 / 360 ) );
+	cr = cos( angles[ 2 ] * ( M_PI * 2 / 360 ) );
+
+	forward[ 0 ] = cp * cy;
+	forward[ 1 ] = cp * sy;
+	forward[ 2 ] = -sp;
+	right[ 0 ] = -1 * sr * sp * cy + -1 * cr * -sy;
+	right[ 1 ] = -1 * sr * sp * sy + -1 * cr * cy;
+	right[ 2 ] = -1 * sr * cp;
+	up[ 0 ] = cr * sp * cy + -sr * -sy;
+	up[ 1 ] = cr * sp * sy + -sr * cy;
+	up[ 2 ] = cr * cp;
+}
+
+static int G_Move( game_t *g, int n, float yaw, float dist )
+{
+	byte *e;
+
+	if ( n <= 0 || n >= g->numEdicts ) {
+		return 0;
+	}
+
+	e = G_Edict( g, n );
+	yaw = yaw * M_PI * 2 / 360;
+	EV_F( e, EV_ORIGIN + 0 ) += cos( yaw ) * dist;
+	EV_F( e, EV_ORIGIN + 1 ) += sin( yaw ) * dist;
+	G_LinkEdict( e );
+
+	return 1;
+}
+
+static intptr_t G_FindNext( game_t *g, intptr_t *args, qboolean radius )
+{
+	const char	*match = NULL;
+	float		*org = NULL;
+	float		rad = 0, d, dist;
+	intptr_t	p;
+	byte		*e;
+	int			i, j, fofs = 0;
+
+	if ( radius ) {
+		org = G_Block( g, args[ 2 ], 3 * sizeof( float ) );
+		rad = G_Float( args[ 3 ] );
+	} else {
+		fofs = (int)args[ 2 ];
+		match = G_Ptr( g, args[ 3 ] );
+		if ( fofs < 0 || fofs > g->sizeofent - 4 ) {
+			return 0;
+		}
+	}
+
+	for ( i = G_EntNum( g, args[ 1 ] ) + 1; i < g->numEdicts; i++ ) {
+		if ( g->freeEnt[ i ] ) {
+			continue;
+		}
+
+		e = G_Edict( g, i );
+		if ( radius ) {
+			if ( EV_F( e, EV_SOLID ) == SOLID_NOT ) {
+				continue;
+			}
+			for ( dist = 0, j = 0; j < 3; j++ ) {
+				d = org[ j ] - ( EV_F( e, EV_ORIGIN + j ) + ( EV_F( e, EV_MINS + j ) + EV_F( e, EV_MAXS + j ) ) * 0.5 );
+				dist += d * d;
+			}
+			if ( sqrt( dist ) > rad ) {
+				continue;
+			}
+		} else {
+			p = G_ReadPtr( g, e + fofs );
+			if ( !p || strcmp( G_Ptr( g, p ), match ) ) {
+				continue;
+			}
+		}
+
+		return G_Ref( g, e );
+	}
+
+	return 0;
+}
+
+static void G_GetInfoKey( game_t *g, int n, const char *key, intptr_t buf, intptr_t size )
+{
+	char		modelName[ 256 ];
+	const char	*value = "";
+
+	if ( n == 0 ) {
+		if ( !strcmp( key, "mapname" ) ) {
+			value = mapName;
+		} else if ( !strcmp( key, "modelname" ) ) {
+			sprintf( modelName, "maps/%.200s.bsp", mapName );
+			value = modelName;
+		} else if ( !strcmp( key, "*version" ) ) {
+			value = "q3vmrun";
+		} else {
+			value = Cvar_String( g, key );
+		}
+	}
+
+	G_CopyString( g, buf, size, value );
+}
+
+static int G_OpenFile( game_t *g, const char *name, int *handle, int mode )
+{
+	char	path[ MAX_OS_PATH ];
+	int		i, length;
+
+	*handle = 0;
+	if ( strstr( name, ".." ) || name[ 0 ] == '/' || name[ 0 ] == '\\' || strchr( name, ':' ) ) {
+		return -1;
+	}
+
+	for ( i = 1; i < MAX_FILES; i++ ) {
+		if ( !g->files[ i ].used ) {
+			break;
+		}
+	}
+
+	if ( i == MAX_FILES ) {
+		return -1;
+	}
+
+	// FS_READ_BIN, FS_READ_TXT
+	if ( mode <= 1 ) {
+		sprintf( path, "%.500s/%.500s", baseDir, name );
+		g->files[ i ].f = fopen( path, "rb" );
+		if ( !g->files[ i ].f ) {
+			return -1;
+		}
+		length = Q_filelength( g->files[ i ].f );
+	} else {
+		g->files[ i ].f = NULL;
+		length = 0;
+	}
+
+	g->files[ i ].used = qtrue;
+	*handle = i;
+
+	return length;
+}
+
+static gameFile_t *G_File( game_t *g, intptr_t handle )
+{
+	if ( handle <= 0 || handle >= MAX_FILES || !g->files[ handle ].used ) {
+		return NULL;
+	}
+
+	return &g->files[ handle ];
+}
+
+static int G_Stricmp( const char *s1, const char *s2, int n )
+{
+	int c1, c2;
+
+	for ( ; n; n-- ) {
+		c1 = tolower( (byte)*s1++ );
+		c2 = tolower( (byte)*s2++ );
+		if ( c1 != c2 ) {
+			return c1 < c2 ? -1 : 1;
+		}
+		if ( !c1 ) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+// server commands the game sends itself, only info keys are kept
+static void G_Command( game_t *g, const char *text )
+{
+	char	line[ 1024 ];
+	char	cmd[ 64 ], key[ 256 ], value[ 256 ];
+	char	*s;
+	int		i;
+
+	G_Print( g, "localcmd: %s", text );
+
+	while ( *text ) {
+		for ( i = 0; *text && *text != '\n' && *text != ';'; text++ ) {
+			if ( i < (int)sizeof( line ) - 1 ) {
+				line[ i++ ] = *text;
+			}
+		}
+		line[ i ] = 0;
+		if ( *text ) {
+			text++;
+		}
+
+		s = G_Parse( line, cmd, sizeof( cmd ) );
+		s = G_Parse( s, key, sizeof( key ) );
+		s = G_Parse( s, value, sizeof( value ) );
+		if ( s && ( !strcmp( cmd, "serverinfo" ) || !strcmp( cmd, "localinfo" ) || !strcmp( cmd, "set" ) ) ) {
+			Cvar_Set( g, key, value );
+		}
+	}
+}
+
+static intptr_t G_Syscall( game_t *g, intptr_t *args )
+{
+	gameFile_t	*file;
+	char		*s;
+	char		token[ 1024 ];
+	byte		*e;
+	int			n, i;
+	time_t		t;
+
+	switch ( args[ 0 ] ) {
+	case G_GETAPIVERSION:
+		return GAME_API_VERSION;
+
+	case G_DPRINT:
+	case G_conprint:
+		G_Print( g, "%s", (char *)G_Ptr( g, args[ 1 ] ) );
+		return 0;
+
+	case G_ERROR:
+		Error( "%s: game error: %s", g->name, (char *)G_Ptr( g, args[ 1 ] ) );
+		return 0;
+
+	case G_GetEntityToken:
+		g->entCursor = G_Parse( g->entCursor, token, sizeof( token ) );
+		G_CopyString( g, args[ 1 ], args[ 2 ], token );
+		return g->entCursor != NULL;
+
+	case G_SPAWN_ENT:
+		return G_Spawn( g );
+
+	case G_REMOVE_ENT:
+	case G_MAKESTATIC:
+		G_Remove( g, (int)args[ 1 ] );
+		return 0;
+
+	case G_PRECACHE_SOUND:
+	case G_PRECACHE_MODEL:
+	case G_LIGHTSTYLE:
+	case G_AMBIENTSOUND:
+	case G_SOUND:
+	case G_STUFFCMD:
+	case G_SETSPAWNPARAMS:
+	case G_LOGFRAG:
+	case G_MULTICAST:
+	case G_DISABLEUPDATES:
+	case G_WRITEBYTE:
+	case G_WRITECHAR:
+	case G_WRITESHORT:
+	case G_WRITELONG:
+	case G_WRITEANGLE:
+	case G_WRITECOORD:
+	case G_WRITESTRING:
+	case G_WRITEENTITY:
+	case G_FLUSHSIGNON:
+	case G_executecmd:
+	case G_redirectcmd:
+	case G_SETPAUSE:
+		return 0;
+
+	case G_SETORIGIN:
+	case G_SETSIZE:
+		n = (int)args[ 1 ];
+		if ( n < 0 || n >= g->numEdicts ) {
+			return 0;
+		}
+		e = G_Edict( g, n );
+		for ( i = 0; i < 3; i++ ) {
+			if ( args[ 0 ] == G_SETORIGIN ) {
+				EV_F( e, EV_ORIGIN + i ) = G_Float( args[ 2 + i ] );
+			} else {
+				EV_F( e, EV_MINS + i ) = G_Float( args[ 2 + i ] );
+				EV_F( e, EV_MAXS + i ) = G_Float( args[ 5 + i ] );
+				EV_F( e, EV_SIZE + i ) = EV_F( e, EV_MAXS + i ) - EV_F( e, EV_MINS + i );
+			}
+		}
+		G_LinkEdict( e );
+		return 0;
+
+	case G_SETMODEL:
+		n = (int)args[ 1 ];
+		if ( n < 0 || n >= g->numEdicts ) {
+			return 0;
+		}
+		s = G_Ptr( g, args[ 2 ] );
+		G_SetEntString( g, n, EV_MODEL, args[ 2 ] );
+		EV_F( G_Edict( g, n ), EV_MODELINDEX ) = *s ? G_ModelIndex( g, s ) : 0;
+		return 0;
+
+	case G_BPRINT:
+		G_Print( g, "%s", (char *)G_Ptr( g, args[ 2 ] ) );
+		return 0;
+
+	case G_SPRINT:
+		G_Print( g, "%s", (char *)G_Ptr( g, args[ 3 ] ) );
+		return 0;
+
+	case G_CENTERPRINT:
+		G_Print( g, "%s\n", (char *)G_Ptr( g, args[ 2 ] ) );
+		return 0;
+
+	case G_LOCALCMD:
+		G_Command( g, G_Ptr( g, args[ 1 ] ) );
+		return 0;
+
+	case G_TRACELINE:
+	case G_TraceCapsule:
+		G_Trace( g, args );
+		return 0;
+
+	case G_CHECKCLIENT:
+	case G_NEXTCLIENT:
+	case G_AIM:
+		return 0;
+
+	case G_CVAR:
+		return G_FloatRet( (float)atof( Cvar_String( g, G_Ptr( g, args[ 1 ] ) ) ) );
+
+	case G_CVAR_SET:
+		Cvar_Set( g, G_Ptr( g, args[ 1 ] ), G_Ptr( g, args[ 2 ] ) );
+		return 0;
+
+	case G_CVAR_SET_FLOAT:
+		sprintf( token, "%g", G_Float( args[ 2 ] ) );
+		Cvar_Set( g, G_Ptr( g, args[ 1 ] ), token );
+		return 0;
+
+	case G_CVAR_STRING:
+		G_CopyString( g, args[ 2 ], args[ 3 ], Cvar_String( g, G_Ptr( g, args[ 1 ] ) ) );
+		return 0;
+
+	case G_FINDRADIUS:
+		return G_FindNext( g, args, qtrue );
+
+	case G_Find:
+		return G_FindNext( g, args, qfalse );
+
+	case G_WALKMOVE:
+		return G_Move( g, (int)args[ 1 ], G_Float( args[ 2 ] ), G_Float( args[ 3 ] ) );
+
+	case G_MOVETOGOAL:
+		n = G_EntNum( g, g->entsRef + GV_I( g, GV_SELF ) );
+		if ( n <= 0 ) {
+			return 0;
+		}
+		return G_Move( g, n, EV_F( G_Edict( g, n ), EV_IDEAL_YAW ), G_Float( args[ 1 ] ) );
+
+	case G_DROPTOFLOOR:
+		n = (int)args[ 1 ];
+		if ( n <= 0 || n >= g->numEdicts ) {
+			return 0;
+		}
+		e = G_Edict( g, n );
+		EV_F( e, EV_FLAGS ) = (float)( (int)EV_F( e, EV_FLAGS ) | FL_ONGROUND );
+		EV_I( e, EV_GROUNDENTITY ) = 0;
+		return 1;
+
+	case G_CHECKBOTTOM:
+		return 1;
+
+	case G_POINTCONTENTS:
+		return CONTENTS_EMPTY;
+
+	case G_NEXTENT:
+		for ( n = (int)args[ 1 ] + 1; n < g->numEdicts; n++ ) {
+			if ( !g->freeEnt[ n ] ) {
+				return n;
+			}
+		}
+		return 0;
+
+	case G_CHANGELEVEL:
+		G_Print( g, "changelevel %s\n", (char *)G_Ptr( g, args[ 1 ] ) );
+		g->changelevel = qtrue;
+		return 0;
+
+	case G_GETINFOKEY:
+		G_GetInfoKey( g, (int)args[ 1 ], G_Ptr( g, args[ 2 ] ), args[ 3 ], args[ 4 ] );
+		return 0;
+
+	case g_memset:
+		memset( G_Block( g, args[ 1 ], args[ 3 ] ), (int)args[ 2 ], args[ 3 ] );
+		return args[ 1 ];
+
+	case g_memcpy:
+		memmove( G_Block( g, args[ 1 ], args[ 3 ] ), G_Block( g, args[ 2 ], args[ 3 ] ), args[ 3 ] );
+		return args[ 1 ];
+
+	case g_strncpy:
+		strncpy( G_Block( g, args[ 1 ], args[ 3 ] ), G_Ptr( g, args[ 2 ] ), args[ 3 ] );
+		return args[ 1 ];
+
+	case g_sin:
+		return G_FloatRet( (float)sin( G_Float( args[ 1 ] ) ) );
+
+	case g_cos:
+		return G_FloatRet( (float)cos( G_Float( args[ 1 ] ) ) );
+
+	case g_atan2:
+		return G_FloatRet( (float)atan2( G_Float( args[ 1 ] ), G_Float( args[ 2 ] ) ) );
+
+	case g_sqrt:
+		return G_FloatRet( (float)sqrt( G_Float( args[ 1 ] ) ) );
+
+	case g_floor:
+		return G_FloatRet( (float)floor( G_Float( args[ 1 ] ) ) );
+
+	case g_ceil:
+		return G_FloatRet( (float)ceil( G_Float( args[ 1 ] ) ) );
+
+	case g_acos:
+		return G_FloatRet( (float)acos( G_Float( args[ 1 ] ) ) );
+
+	case G_CMD_ARGC:
+		return g->argc;
+
+	case G_CMD_ARGV:
+		n = (int)args[ 1 ];
+		G_CopyString( g, args[ 2 ], args[ 3 ], ( n >= 0 && n < g->argc ) ? g->argv[ n ] : "" );
+		return 0;
+
+	case G_CMD_ARGS:
+		token[ 0 ] = 0;
+		for ( i = 1; i < g->argc; i++ ) {
+			if ( strlen( token ) + strlen( g->argv[ i ] ) + 2 >= sizeof( token ) ) {
+				break;
+			}
+			if ( i > 1 ) {
+				strcat( token, " " );
+			}
+			strcat( token, g->argv[ i ] );
+		}
+		G_CopyString( g, args[ 1 ], args[ 2 ], token );
+		return 0;
+
+	case G_CMD_TOKENIZE:
+		s = G_Ptr( g, args[ 1 ] );
+		for ( g->argc = 0; g->argc < MAX_ARGS; g->argc++ ) {
+			s = G_Parse( s, g->argv[ g->argc ], sizeof( g->argv[ 0 ] ) );
+			if ( !s ) {
+				break;
+			}
+		}
+		return g->argc;
+
+	case G_readcmd:
+		G_CopyString( g, args[ 2 ], args[ 3 ], "" );
+		return 0;
+
+	case G_FSOpenFile:
+		return G_OpenFile( g, G_Ptr( g, args[ 1 ] ), G_Block( g, args[ 2 ], sizeof( int ) ), (int)args[ 3 ] );
+
+	case G_FSCloseFile:
+		if ( ( file = G_File( g, args[ 1 ] ) ) != NULL ) {
+			if ( file->f ) {
+				fclose( file->f );
+			}
+			memset( file, 0, sizeof( *file ) );
+		}
+		return 0;
+
+	case G_FSReadFile:
+		file = G_File( g, args[ 3 ] );
+		if ( !file || !file->f ) {
+			return 0;
+		}
+		return fread( G_Block( g, args[ 1 ], args[ 2 ] ), 1, args[ 2 ], file->f );
+
+	case G_FSWriteFile:
+		return G_File( g, args[ 3 ] ) ? args[ 2 ] : 0;
+
+	case G_FSSeekFile:
+		file = G_File( g, args[ 1 ] );
+		if ( !file || !file->f ) {
+			return -1;
+		}
+		// FS_SEEK_CUR, FS_SEEK_END, FS_SEEK_SET
+		return fseek( file->f, (long)args[ 2 ], args[ 3 ] == 0 ? SEEK_CUR : ( args[ 3 ] == 1 ? SEEK_END : SEEK_SET ) );
+
+	case G_FSTellFile:
+		file = G_File( g, args[ 1 ] );
+		return ( file && file->f ) ? ftell( file->f ) : 0;
+
+	case G_FSGetFileList:
+		return 0;
+
+	case G_Map_Extension:
+		return -1;
+
+	case G_strcmp:
+		return strcmp( G_Ptr( g, args[ 1 ] ), G_Ptr( g, args[ 2 ] ) );
+
+	case G_strncmp:
+		return strncmp( G_Ptr( g, args[ 1 ] ), G_Ptr( g, args[ 2 ] ), args[ 3 ] );
+
+	case G_stricmp:
+		return G_Stricmp( G_Ptr( g, args[ 1 ] ), G_Ptr( g, args[ 2 ] ), -1 );
+
+	case G_strnicmp:
+		return G_Stricmp( G_Ptr( g, args[ 1 ] ), G_Ptr( g, args[ 2 ] ), (int)args[ 3 ] );
+
+	case G_Add_Bot:
+	case G_Remove_Bot:
+	case G_SetBotUserInfo:
+	case G_SetBotCMD:
+	case G_SETUSERINFO:
+	case G_PRECACHE_VWEP_MODEL:
+		return 0;
+
+	case G_QVMstrftime:
+		// fixed clock, both builds have to see the same date
+		t = (time_t)args[ 4 ];
+		if ( args[ 2 ] <= 0 ) {
+			return 0;
+		}
+		n = (int)strftime( G_Block( g, args[ 1 ], args[ 2 ] ), args[ 2 ], G_Ptr( g, args[ 3 ] ), gmtime( &t ) );
+		return n;
+
+	case g_strlcpy:
+		s = G_Ptr( g, args[ 2 ] );
+		G_CopyString( g, args[ 1 ], args[ 3 ], s );
+		return strlen( s );
+
+	case g_strlcat:
+		s = G_Block( g, args[ 1 ], args[ 3 ] );
+		n = (int)strlen( s );
+		if ( n < args[ 3 ] ) {
+			G_CopyString( g, args[ 1 ] + n, args[ 3 ] - n, G_Ptr( g, args[ 2 ] ) );
+		}
+		return n + strlen( G_Ptr( g, args[ 2 ] ) );
+
+	case G_MAKEVECTORS:
+		G_MakeVectors( g, G_Block( g, args[ 1 ], 3 * sizeof( float ) ) );
+		return 0;
+
+	case G_VISIBLETO:
+		// no geometry, everything is visible
+		memset( G_Block( g, args[ 4 ], args[ 3 ] ), 1, args[ 3 ] );
+		return 0;
+
+	default:
+		G_Print( g, "unhandled syscall %i\n", (int)args[ 0 ] );
+		return 0;
+	}
+}
+
+static intptr_t QVM_Syscall( vm_t *vm, intptr_t *args )
+{
+	return G_Syscall( (game_t *)vm->userData, args );
+}
+
+static intptr_t Native_Syscall( intptr_t arg, ... )
+{
+	intptr_t	args[ MAX_VMSYSCALL_ARGS ];
+	va_list		argptr;
+	int			i;
+
+	args[ 0 ] = arg;
+	va_start( argptr, arg );
+	for ( i = 1; i < MAX_VMSYSCALL_ARGS; i++ ) {
+		args[ i ] = va_arg( argptr, intptr_t );
+	}
+	va_end( argptr );
+
+	return G_Syscall( nativeGame, args );
+}
+
+/*
+=================
+Loading
+=================
+*/
+static void G_LoadQVM( game_t *g, const char *filename )
+{
+	const char	*errMsg;
+	void		*image;
+	int			length;
+
+	length = LoadFile( filename, &image );
+	errMsg = VM_Create( &g->vm, image, length, QVM_Syscall );
+	free( image );
+	if ( errMsg ) {
+		Error( "%s: %s", filename, errMsg );
+	}
+
+	g->vm.userData = g;
+	g->vm.profile = malloc( g->vm.instructionCount * sizeof( g->vm.profile[0] ) );
+	if ( !g->vm.profile ) {
+		Error( "out of memory" );
+	}
+	memset( g->vm.profile, 0, g->vm.instructionCount * sizeof( g->vm.profile[0] ) );
+
+	g->name = "qvm";
+	g->qvm = qtrue;
+}
+
+/*
+================
+Sys_Seconds
+
+Monotonic wall clock for the benchmark, I_FloatTime() only counts whole seconds
+================
+*/
+static double Sys_Seconds( void )
+{
+#ifdef _WIN32
+	static LARGE_INTEGER	freq;
+	LARGE_INTEGER			now;
+
+	if ( !freq.QuadPart ) {
+		QueryPerformanceFrequency( &freq );
+	}
+	QueryPerformanceCounter( &now );
+
+	return (double)now.QuadPart / (double)freq.QuadPart;
+#else
+	struct timespec	ts;
+
+	clock_gettime( CLOCK_MONOTONIC, &ts );
+
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+#endif
+}
+
+static void G_LoadNative( game_t *g, const char *filename )
+{
+	nativeEntry_t	dllEntry;
+#ifdef _WIN32
+	HMODULE			lib = LoadLibraryA( filename );
+
+	if ( !lib ) {
+		Error( "%s: can't load library", filename );
+	}
+	dllEntry = (nativeEntry_t)GetProcAddress( lib, "dllEntry" );
+	g->vmMain = (nativeMain_t)GetProcAddress( lib, "vmMain" );
+#else
+	void			*lib = dlopen( filename, RTLD_NOW | RTLD_LOCAL );
+
+	if ( !lib ) {
+		Error( "%s", dlerror() );
+	}
+	*(void **)&dllEntry = dlsym( lib, "dllEntry" );
+	*(void **)&g->vmMain = dlsym( lib, "vmMain" );
+#endif
+
+	if ( !dllEntry || !g->vmMain ) {
+		Error( "%s: dllEntry or vmMain not exported", filename );
+	}
+
+	dllEntry( Native_Syscall );
+
+	g->name = "native";
+	g->qvm = qfalse;
+}
+
+static void G_Init( game_t *g, int seed )
+{
+	intptr_t	gameData;
+	int			i;
+
+	for ( i = 0; i < numSets; i++ ) {
+		Cvar_Set( g, setNames[ i ], setValues[ i ] );
+	}
+
+	if ( !Cvar_Find( g, "sv_gravity" ) ) {
+		Cvar_Set( g, "sv_gravity", "800" );
+	}
+
+	gameData = G_CallGame( g, GAME_INIT, 0, seed );
+	if ( !gameData ) {
+		Error( "%s: GAME_INIT failed", g->name );
+	}
+
+	if ( g->qvm ) {
+		qvmGameData_t *gd = G_Block( g, gameData, sizeof( *gd ) );
+
+		g->entsRef = gd->ents;
+		g->sizeofent = gd->sizeofent;
+		g->maxentities = gd->maxentities;
+		g->globals = G_Block( g, gd->global, 90 * sizeof( int ) );
+	} else {
+		nativeGameData_t *gd = (nativeGameData_t *)gameData;
+
+		g->entsRef = (intptr_t)gd->ents;
+		g->sizeofent = gd->sizeofent;
+		g->maxentities = gd->maxentities;
+		g->globals = gd->global;
+	}
+
+	if ( g->sizeofent < EV_WORDS * 4 || g->maxentities <= MAX_CLIENTS + 1 || g->maxentities > MAX_EDICTS ) {
+		Error( "%s: bad gamedata, sizeofent %i maxentities %i", g->name, g->sizeofent, g->maxentities );
+	}
+
+	g->ents = G_Block( g, g->entsRef, g->sizeofent * g->maxentities );
+
+	// world and client slots are always in use
+	g->time = 1.0f;
+	g->numEdicts = MAX_CLIENTS + 1;
+	for ( i = 0; i < g->numEdicts; i++ ) {
+		G_ClearEdict( g, i );
+	}
+
+	EV_F( g->ents, EV_MODELINDEX ) = G_ModelIndex( g, "world" );
+	EV_F( g->ents, EV_SOLID ) = SOLID_BSP;
+	EV_F( g->ents, EV_MOVETYPE ) = MOVETYPE_PUSH;
+
+	GV_F( g, GV_TIME ) = g->time;
+	g->entCursor = entityString;
+	G_CallGame( g, GAME_LOADENTS, 0, 0 );
+}
+
+/*
+=================
+Physics, entities only think and fly, nothing collides
+=================
+*/
+static void G_Think( game_t *g, int n, float thinktime )
+{
+	EV_F( G_Edict( g, n ), EV_NEXTTHINK ) = 0;
+	GV_F( g, GV_TIME ) = thinktime;
+	GV_I( g, GV_SELF ) = n * g->sizeofent;
+	GV_I( g, GV_OTHER ) = 0;
+	G_CallGame( g, GAME_EDICT_THINK, 0, 0 );
+}
+
+static qboolean G_RunThink( game_t *g, int n )
+{
+	float thinktime = EV_F( G_Edict( g, n ), EV_NEXTTHINK );
+
+	if ( thinktime <= 0 || thinktime > g->time + g->frametime ) {
+		return qtrue;
+	}
+
+	G_Think( g, n, thinktime < g->time ? g->time : thinktime );
+
+	return !g->freeEnt[ n ];
+}
+
+static void G_RunPusher( game_t *g, int n )
+{
+	byte	*e = G_Edict( g, n );
+	float	oldltime = EV_F( e, EV_LTIME );
+	float	thinktime = EV_F( e, EV_NEXTTHINK );
+	float	movetime = g->frametime;
+	int		i;
+
+	if ( thinktime < oldltime + g->frametime ) {
+		movetime = thinktime - oldltime;
+		if ( movetime < 0 ) {
+			movetime = 0;
+		}
+	}
+
+	if ( movetime > 0 ) {
+		for ( i = 0; i < 3; i++ ) {
+			EV_F( e, EV_ORIGIN + i ) += EV_F( e, EV_VELOCITY + i ) * movetime;
+			EV_F( e, EV_ANGLES + i ) += EV_F( e, EV_AVELOCITY + i ) * movetime;
+		}
+		EV_F( e, EV_LTIME ) += movetime;
+		G_LinkEdict( e );
+	}
+
+	if ( thinktime > oldltime && thinktime <= EV_F( e, EV_LTIME ) ) {
+		G_Think( g, n, g->time );
+	}
+}
+
+static void G_RunFlying( game_t *g, int n, int movetype )
+{
+	byte	*e = G_Edict( g, n );
+	int		i;
+
+	if ( ( movetype == MOVETYPE_TOSS || movetype == MOVETYPE_BOUNCE )
+		&& ( (int)EV_F( e, EV_FLAGS ) & FL_ONGROUND ) ) {
+		return;
+	}
+
+	if ( movetype == MOVETYPE_TOSS || movetype == MOVETYPE_BOUNCE ) {
+		EV_F( e, EV_VELOCITY + 2 ) -= (float)atof( Cvar_String( g, "sv_gravity" ) ) * g->frametime;
+	}
+
+	for ( i = 0; i < 3; i++ ) {
+		EV_F( e, EV_ANGLES + i ) += EV_F( e, EV_AVELOCITY + i ) * g->frametime;
+		EV_F( e, EV_ORIGIN + i ) += EV_F( e, EV_VELOCITY + i ) * g->frametime;
+	}
+
+	G_LinkEdict( e );
+}
+
+static void G_RunFrame( game_t *g, float frametime )
+{
+	int		n, movetype;
+
+	g->frametime = frametime;
+	g->time += frametime;
+
+	GV_F( g, GV_TIME ) = g->time;
+	GV_F( g, GV_FRAMETIME ) = frametime;
+	GV_I( g, GV_SELF ) = 0;
+	GV_I( g, GV_OTHER ) = 0;
+	G_CallGame( g, GAME_START_FRAME, (int)( g->time * 1000 ), 0 );
+
+	// clients are run from their packets, we have none
+	for ( n = MAX_CLIENTS + 1; n < g->numEdicts; n++ ) {
+		if ( g->freeEnt[ n ] ) {
+			continue;
+		}
+
+		GV_F( g, GV_TIME ) = g->time;
+		movetype = (int)EV_F( G_Edict( g, n ), EV_MOVETYPE );
+
+		switch ( movetype ) {
+		case MOVETYPE_PUSH:
+			G_RunPusher( g, n );
+			break;
+
+		case MOVETYPE_FLY:
+		case MOVETYPE_TOSS:
+		case MOVETYPE_NOCLIP:
+		case MOVETYPE_FLYMISSILE:
+		case MOVETYPE_BOUNCE:
+			if ( G_RunThink( g, n ) ) {
+				G_RunFlying( g, n, movetype );
+			}
+			break;
+
+		default:
+			G_RunThink( g, n );
+			break;
+		}
+	}
+}
+
+/*
+=================
+Comparison of two builds
+=================
+*/
+static qboolean G_CompareFields( game_t *a, game_t *b, int frame, const int *wa, const int *wb,
+	const gameField_t *fields, int n, int *diffs )
+{
+	const gameField_t	*field;
+	const char			*classname;
+	char				where[ 96 ];
+	float				fa, fb;
+	int					w, i, ea, eb;
+	qboolean			same = qtrue;
+
+	if ( n >= 0 ) {
+		classname = G_EntString( a, n, EV_CLASSNAME );
+		if ( !*classname ) {
+			classname = G_EntString( b, n, EV_CLASSNAME );
+		}
+		sprintf( where, "entity %i (%.64s)", n, classname );
+	} else {
+		strcpy( where, "globals" );
+	}
+
+	for ( w = 0, field = fields; field->name; w += field->count, field++ ) {
+		for ( i = 0; i < field->count; i++ ) {
+			if ( field->type == FT_FLOAT ) {
+				fa = G_Float( wa[ w + i ] );
+				fb = G_Float( wb[ w + i ] );
+				if ( fa == fb || fabs( fa - fb ) <= epsilon || ( fa != fa && fb != fb ) ) {
+					continue;
+				}
+				if ( ++*diffs <= MAX_DIFFS ) {
+					printf( "frame %i: %s %s[%i]: %s %g, %s %g\n", frame, where, field->name, i,
+						a->name, fa, b->name, fb );
+				}
+				same = qfalse;
+			} else if ( field->type == FT_ENTITY ) {
+				ea = wa[ w + i ] / a->sizeofent;
+				eb = wb[ w + i ] / b->sizeofent;
+				if ( ea == eb ) {
+					continue;
+				}
+				if ( ++*diffs <= MAX_DIFFS ) {
+					printf( "frame %i: %s %s: %s entity %i, %s entity %i\n", frame, where, field->name,
+						a->name, ea, b->name, eb );
+				}
+				same = qfalse;
+			}
+		}
+	}
+
+	return same;
+}
+
+static int G_Compare( game_t *a, game_t *b, int frame )
+{
+	int diffs = 0;
+	int n;
+
+	if ( a->numEdicts != b->numEdicts ) {
+		printf( "frame %i: %s has %i edicts, %s %i\n", frame, a->name, a->numEdicts, b->name, b->numEdicts );
+		diffs++;
+	}
+
+	G_CompareFields( a, b, frame, a->globals, b->globals, globalFields, -1, &diffs );
+
+	for ( n = 0; n < a->numEdicts && n < b->numEdicts; n++ ) {
+		if ( a->freeEnt[ n ] != b->freeEnt[ n ] ) {
+			if ( ++diffs <= MAX_DIFFS ) {
+				printf( "frame %i: entity %i is free in %s only\n", frame, n, a->freeEnt[ n ] ? a->name : b->name );
+			}
+			continue;
+		}
+
+		if ( !a->freeEnt[ n ] ) {
+			G_CompareFields( a, b, frame, (int *)G_Edict( a, n ), (int *)G_Edict( b, n ), entityFields, n, &diffs );
+		}
+	}
+
+	if ( diffs > MAX_DIFFS ) {
+		printf( "frame %i: %i more differences\n", frame, diffs - MAX_DIFFS );
+	}
+
+	return diffs;
+}
+
+/*
+=================
+Profile report
+=================
+*/
+typedef struct {
+	const char			*name;
+	int					start;
+	unsigned long long	count;
+	unsigned long long	calls;
+} procStat_t;
+
+static int ProcCompare( const void *a, const void *b )
+{
+	const procStat_t *pa = a, *pb = b;
+
+	if ( pa->count != pb->count ) {
+		return pa->count < pb->count ? 1 : -1;
+	}
+
+	return pa->start - pb->start;
+}
+
+// code symbols from the map file written by q3asm -m, value is the instruction number
+static char *ProcName( char *map, int start, char *buf )
+{
+	char	*s = map;
+	char	name[ 256 ];
+	int		seg, value;
+
+	while ( s && sscanf( s, "%i %x %255s", &seg, &value, name ) == 3 ) {
+		if ( seg == CODESEG && value == start ) {
+			strcpy( buf, name );
+			return buf;
+		}
+		s = strchr( s, '\n' );
+		if ( s ) {
+			s++;
+		}
+	}
+
+	sprintf( buf, "@%i", start );
+
+	return buf;
+}
+
+static void G_Profile( game_t *g, const char *mapFile, int frames, int top )
+{
+	procStat_t			*procs;
+	unsigned long long	total = 0;
+	char				*map = NULL;
+	char				name[ 256 ];
+	int					numProcs = 0;
+	int					i, p, end;
+	FILE				*f;
+
+	if ( mapFile && ( f = fopen( mapFile, "rb" ) ) != NULL ) {
+		fclose( f );
+		LoadFile( mapFile, (void **)&map );
+	}
+
+	procs = malloc( g->vm.instructionCount * sizeof( procs[0] ) );
+	if ( !procs ) {
+		Error( "out of memory" );
+	}
+
+	for ( p = 0; p < g->vm.instructionCount; p = end ) {
+		end = VM_ProcEnd( &g->vm, p );
+		procs[ numProcs ].start = p;
+		procs[ numProcs ].calls = g->vm.profile[ p ];
+		procs[ numProcs ].count = 0;
+		for ( i = p; i < end; i++ ) {
+			procs[ numProcs ].count += g->vm.profile[ i ];
+		}
+		total += procs[ numProcs ].count;
+		numProcs++;
+	}
+
+	qsort( procs, numProcs, sizeof( procs[0] ), ProcCompare );
+
+	printf( "%llu instructions in %i frames, %llu per frame\n", total, frames,
+		frames ? total / frames : total );
+	printf( "%14s %6s %10s  %s\n", "instructions", "share", "calls", "function" );
+	for ( i = 0; i < numProcs && i < top && procs[ i ].count; i++ ) {
+		printf( "%14llu %5.1f%% %10llu  %s\n", procs[ i ].count, 100.0 * procs[ i ].count / total,
+			procs[ i ].calls, ProcName( map, procs[ i ].start, name ) );
+	}
+
+	free( procs );
+	free( map );
+}
+
+static const char usage[] =
+	"Usage: %s [options] [file.qvm]\n"
+	"  -native <lib>   run the native library as well and compare state every frame\n"
+	"  -map <file>     symbols written by q3asm -m (default <qvm>.map)\n"
+	"  -ents <file>    entity text for GAME_LOADENTS\n"
+	"  -mapname <name> mapname the game sees (default start)\n"
+	"  -basedir <dir>  where game files are read from (default .)\n"
+	"  -set <cvar> <value>\n"
+	"  -frames <n>     frames to run (default 100)\n"
+	"  -frametime <s>  (default 0.013)\n"
+	"  -seed <n>       random seed passed to GAME_INIT (default 0)\n"
+	"  -eps <value>    tolerance for float comparison (default 0)\n"
+	"  -top <n>        functions in the profile report (default 30)\n"
+	"  -stop           stop at the first frame with differences\n"
+	"  -v              print game output\n";
+
+int main( int argc, const char *argv[] )
+{
+	const char	*qvmFile = NULL, *nativeFile = NULL, *mapFile = NULL, *entsFile = NULL;
+	char		defaultMap[ MAX_OS_PATH ];
+	int			frames = 100, seed = 0, top = 30;
+	float		frametime = 0.013f;
+	qboolean	stop = qfalse;
+	int			i, frame, ran, badFrames = 0;
+	double		start;
+
+	for ( i = 1; i < argc; i++ ) {
+		if ( argv[ i ][ 0 ] != '-' ) {
+			qvmFile = argv[ i ];
+			continue;
+		}
+
+		if ( !strcmp( argv[ i ], "-v" ) ) {
+			verbose = qtrue;
+			continue;
+		}
+
+		if ( !strcmp( argv[ i ], "-stop" ) ) {
+			stop = qtrue;
+			continue;
+		}
+
+		if ( i == argc - 1 ) {
+			Error( "%s requires an argument", argv[ i ] );
+		}
+
+		if ( !strcmp( argv[ i ], "-native" ) ) {
+			nativeFile = argv[ ++i ];
+		} else if ( !strcmp( argv[ i ], "-map" ) ) {
+			mapFile = argv[ ++i ];
+		} else if ( !strcmp( argv[ i ], "-ents" ) ) {
+			entsFile = argv[ ++i ];
+		} else if ( !strcmp( argv[ i ], "-mapname" ) ) {
+			mapName = argv[ ++i ];
+		} else if ( !strcmp( argv[ i ], "-basedir" ) ) {
+			baseDir = argv[ ++i ];
+		} else if ( !strcmp( argv[ i ], "-frames" ) ) {
+			frames = atoi( argv[ ++i ] );
+		} else if ( !strcmp( argv[ i ], "-frametime" ) ) {
+			frametime = (float)atof( argv[ ++i ] );
+		} else if ( !strcmp( argv[ i ], "-seed" ) ) {
+			seed = atoi( argv[ ++i ] );
+		} else if ( !strcmp( argv[ i ], "-eps" ) ) {
+			epsilon = (float)atof( argv[ ++i ] );
+		} else if ( !strcmp( argv[ i ], "-top" ) ) {
+			top = atoi( argv[ ++i ] );
+		} else if ( !strcmp( argv[ i ], "-set" ) && i + 2 < argc && numSets < MAX_CVARS ) {
+			setNames[ numSets ] = argv[ ++i ];
+			setValues[ numSets++ ] = argv[ ++i ];
+		} else {
+			Error( "Unknown option: %s", argv[ i ] );
+		}
+	}
+
+	if ( !qvmFile && !nativeFile ) {
+		printf( usage, argv[ 0 ] );
+		return 0;
+	}
+
+	if ( frametime <= 0 ) {
+		Error( "bad frametime" );
+	}
+
+	if ( entsFile ) {
+		LoadFile( entsFile, (void **)&entityString );
+	} else {
+		entityString = copystring( defaultEntities );
+	}
+
+	if ( qvmFile ) {
+		G_LoadQVM( &games[ numGames++ ], qvmFile );
+		if ( !mapFile ) {
+			strncpy( defaultMap, qvmFile, sizeof( defaultMap ) - 5 );
+			defaultMap[ sizeof( defaultMap ) - 5 ] = 0;
+			StripExtension( defaultMap );
+			strcat( defaultMap, ".map" );
+			mapFile = defaultMap;
+		}
+	}
+
+	if ( nativeFile ) {
+		G_LoadNative( &games[ numGames++ ], nativeFile );
+	}
+
+	start = Sys_Seconds();
+
+	for ( i = 0; i < numGames; i++ ) {
+		G_Init( &games[ i ], seed );
+	}
+
+	if ( numGames == 2 && G_Compare( &games[ 0 ], &games[ 1 ], 0 ) ) {
+		badFrames++;
+	}
+
+	for ( frame = 1, ran = 0; frame <= frames && !( stop && badFrames ); frame++, ran++ ) {
+		for ( i = 0; i < numGames; i++ ) {
+			G_RunFrame( &games[ i ], frametime );
+		}
+
+		if ( numGames == 2 && G_Compare( &games[ 0 ], &games[ 1 ], frame ) ) {
+			badFrames++;
+		}
+
+		if ( games[ 0 ].changelevel || games[ numGames - 1 ].changelevel ) {
+			ran++;
+			break;
+		}
+	}
+
+	for ( i = 0; i < numGames; i++ ) {
+		G_CallGame( &games[ i ], GAME_SHUTDOWN, 0, 0 );
+	}
+
+	printf( "%i frames in %.3f seconds\n", ran, Sys_Seconds() - start );
+
+	// frame 0 is the state after GAME_LOADENTS
+	if ( numGames == 2 ) {
+		printf( "%i of %i frames differ\n", badFrames, ran + 1 );
+	}
+
+	if ( games[ 0 ].qvm ) {
+		G_Profile( &games[ 0 ], mapFile, ran, top );
+	}
+
+	return badFrames ? 1 : 0;
+}
@@ -4,6 +4,7 @@
 */
 
 #include "cmdlib.h"
+#include <stdint.h>
 
 #define	VM_MAGIC        0x12721444
 #define	VM_MAGIC_VER2   0x12721445
@@ -46,3 +47,34 @@ typedef struct {
 
 const char *VM_LoadInstructions( const byte *code_pos, int codeLength, int instructionCount, instruction_t *buf );
 const char *VM_CheckInstructions( instruction_t *buf, int instructionCount, int dataLength );
+
+#define	MAX_VMMAIN_ARGS		13		// command + 12 arguments
+#define	MAX_VMSYSCALL_ARGS	16		// syscall number + arguments
+
+typedef struct vm_s vm_t;
+
+// args[0] is the syscall number as in the engine enum (-1 - call target)
+typedef intptr_t (*vmSyscall_t)( vm_t *vm, intptr_t *args );
+
+struct vm_s {
+	instruction_t	*inst;
+	int				instructionCount;
+
+	byte			*dataBase;
+	int				dataMask;
+	int				dataLength;			// data + lit + bss, before rounding
+
+	int				programStack;		// stack of the innermost VM_Call()
+	int				stackBottom;
+
+	vmSyscall_t		systemCall;
+	void			*userData;
+
+	// executed count of every instruction, NULL to skip profiling
+	unsigned long long	*profile;
+};
+
+const char *VM_Create( vm_t *vm, const byte *image, int imageLength, vmSyscall_t systemCall );
+void VM_Free( vm_t *vm );
+int VM_Call( vm_t *vm, int numArgs, const int *args );
+int VM_ProcEnd( const vm_t *vm, int proc );